@@ -6,6 +6,7 @@
 #include "Vega/ImGui/Fonts/ImGuiFontDefinesIconsFABrands.inl"
 #include "Vega/Managers/StaticMeshManager.hpp"
 #include "Vega/Renderer/RendererBackend.hpp"
+#include "Vega/Scene/Components/CameraComponent.hpp"
 #include "Vega/Scene/Components/StaticMeshComponent.hpp"
 #include "Vega/Scene/Components/TransformComponent.hpp"
 #include "Vega/Scene/Scene.hpp"
@@ -14,6 +15,7 @@
 #include "glm/fwd.hpp"
 #include "imgui.h"
 #include "imgui_internal.h"
+#include <nfd.hpp>
 
 #include <vector>
 
@@ -83,6 +85,8 @@ namespace Vega
 
         staticMeshManager->AddMesh("TestMesh", vertices.data(), vertices.size(), indices.data(), indices.size(), false);
 
+        m_StaticMeshImporter = CreateScope<StaticMeshImporter>();
+
         m_ActiveScene = CreateRef<Scene>();
         m_ActiveScene->AddSceneSystem(CreateRef<SceneSystems::SceneSystemStaticMeshDraw>());
 
@@ -100,6 +104,12 @@ namespace Vega
         Entity313.AddComponent<Components::StaticMeshComponent>("TestMesh");
         Entity314.AddComponent<Components::StaticMeshComponent>("TestMesh");
 
+        Entity cameraEntity = m_ActiveScene->CreateActor("Camera");
+        cameraEntity.SetTransformPosition({ 0.0f, 0.0f, 3.0f });
+        cameraEntity.AddComponent<Components::CameraComponent>(Components::CameraComponent {
+            .AspectRatio = static_cast<float>(m_ViewportDimensions.x) / static_cast<float>(m_ViewportDimensions.y),
+        });
+
         EntityPropsPanel::RegisterComponentDescription<Components::TransformComponent>(
             EntityPropsPanelComponentDescription {
                 .Name = "Transform",
@@ -109,6 +119,8 @@ namespace Vega
 
     void EditorLayer::OnDetach()
     {
+        // NOTE: Discards staged meshes that were not registered yet, before the renderer is shut down
+        m_StaticMeshImporter.reset();
         m_ActiveScene.reset();
         m_AppLogo->Destroy();
         m_FrameBuffer->Destroy();
@@ -124,9 +136,36 @@ namespace Vega
         //     m_FramesToSkip = Application::Get().GetRendererBackend()->GetSwapchainColorTextures().size() * 15;
         // }
 
+        RegisterImportedMeshes();
+
         m_ActiveScene->OnUpdate();
     }
 
+    void EditorLayer::ImportMeshFile()
+    {
+        NFD::UniquePathU8 path;
+        nfdu8filteritem_t filter = { "Mesh", "gltf,glb,obj" };
+        if (NFD::OpenDialog(path, &filter, 1) == NFD_OKAY)
+        {
+            m_StaticMeshImporter->Enqueue(std::filesystem::path(reinterpret_cast<const char8_t*>(path.get())));
+        }
+    }
+
+    void EditorLayer::RegisterImportedMeshes()
+    {
+        Ref<StaticMeshManager> staticMeshManager =
+            StaticRefCast<StaticMeshManager>(Application::Get().GetManager("StaticMeshManager"));
+
+        m_ImportedMeshNames.clear();
+        m_StaticMeshImporter->RegisterImportedMeshes(*staticMeshManager, false, kMaxImportedMeshesPerFrame,
+                                                     &m_ImportedMeshNames);
+        for (const std::string& meshName : m_ImportedMeshNames)
+        {
+            Entity entity = m_ActiveScene->CreateActor(meshName);
+            entity.AddComponent<Components::StaticMeshComponent>(meshName);
+        }
+    }
+
     void EditorLayer::OnRender()
     {
         Ref<RendererBackend> rendererBackend = Application::Get().GetRendererBackend();
@@ -197,6 +236,7 @@ namespace Vega
             ImGui::DockBuilderDockWindow("Scene", dockIdRight);
             ImGui::DockBuilderDockWindow("Viewport", dockspaceId);
             ImGui::DockBuilderDockWindow("Assets", dockIdBottom);
+            ImGui::DockBuilderDockWindow("Renderer Memory", dockIdBottom);
             ImGui::DockBuilderFinish(dockspaceId);
         }
 
@@ -249,6 +289,12 @@ namespace Vega
         }
         ImGui::End();
 
+        if (ImGui::Begin("Renderer Memory"))
+        {
+            m_RendererMemoryPanel.OnImGuiRender(Application::Get().GetRendererBackend());
+        }
+        ImGui::End();
+
         if (m_IsDrawImGuiDemoWindow)
         {
             ImGui::ShowDemoWindow(&m_IsDrawImGuiDemoWindow);
@@ -327,6 +373,13 @@ namespace Vega
 
                     ImGui::Separator();
 
+                    if (ImGui::MenuItem("Import Mesh..."))
+                    {
+                        ImportMeshFile();
+                    }
+
+                    ImGui::Separator();
+
                     if (ImGui::MenuItem("Save", "Ctrl+S"))
                     {
                         // SaveProject();
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Panels/EntityPropsPanel.hpp"
+#include "Panels/RendererMemoryPanel.hpp"
 #include "Panels/SceneHierarchyPanel.hpp"
+#include "Vega/Assets/StaticMeshImporter.hpp"
 #include "Vega/Layers/Layer.hpp"
 #include "Vega/Renderer/FrameBuffer.hpp"
 #include "Vega/Scene/Scene.hpp"
@@ -29,6 +31,13 @@ namespace Vega
 
         float DrawGuiTitlebar();
 
+        void ImportMeshFile();
+        // NOTE: Creates an actor for every mesh registered by the importer this frame
+        void RegisterImportedMeshes();
+
+        // NOTE: Bounds the GPU copies recorded per frame when many meshes finish importing at once
+        static constexpr size_t kMaxImportedMeshesPerFrame = 16;
+
     protected:
         // std::vector<Ref<Texture>> m_ColorBuffers;
         Ref<FrameBuffer> m_FrameBuffer;
@@ -39,8 +48,11 @@ namespace Vega
         bool m_IsDrawImGuiDemoWindow = false;
 
         Ref<Scene> m_ActiveScene;
+        Scope<StaticMeshImporter> m_StaticMeshImporter;
+        std::vector<std::string> m_ImportedMeshNames;
         SceneHierarchyPanel m_SceneHierarchyPanel;
         EntityPropsPanel m_EntityPropsPanel;
+        RendererMemoryPanel m_RendererMemoryPanel;
     };
 
 }    // namespace Vega
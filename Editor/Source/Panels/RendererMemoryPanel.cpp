@@ -0,0 +1,151 @@
+#include "RendererMemoryPanel.hpp"
+
+#include <array>
+#include <format>
+#include <string>
+
+namespace Vega
+{
+
+    static std::string FormatMemorySize(uint64_t _Size)
+    {
+        constexpr std::array<const char*, 4> kUnits = { "B", "KiB", "MiB", "GiB" };
+
+        double size = static_cast<double>(_Size);
+        size_t unitIndex = 0;
+        while (size >= 1024.0 && unitIndex + 1 < kUnits.size())
+        {
+            size /= 1024.0;
+            ++unitIndex;
+        }
+
+        return unitIndex == 0 ? std::format("{} B", _Size) : std::format("{:.2f} {}", size, kUnits[unitIndex]);
+    }
+
+    static const char* RendererMemoryCategoryName(RendererMemoryCategory _Category)
+    {
+        switch (_Category)
+        {
+            case RendererMemoryCategory::kRenderBuffer: return "Render Buffers";
+            case RendererMemoryCategory::kTexture: return "Textures";
+            case RendererMemoryCategory::kFrameBuffer: return "Frame Buffers";
+            case RendererMemoryCategory::kInternal: return "Internal";
+        }
+        return "Unknown";
+    }
+
+    void RendererMemoryPanel::OnImGuiRender(Ref<RendererBackend> _RendererBackend)
+    {
+        RendererMemoryStats stats = _RendererBackend->GetMemoryStats();
+        if (stats.Heaps.empty())
+        {
+            ImGui::TextDisabled("Memory statistics are not supported by the renderer backend");
+            return;
+        }
+
+        DrawHeaps(stats);
+
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Spacing();
+
+        DrawCategories(stats);
+
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Spacing();
+
+        DrawAllocations(stats);
+    }
+
+    void RendererMemoryPanel::DrawHeaps(const RendererMemoryStats& _Stats)
+    {
+        if (!_Stats.IsBudgetAvailable)
+        {
+            ImGui::TextDisabled("Driver budget is not available (VK_EXT_memory_budget)");
+        }
+
+        for (size_t heapIndex = 0; heapIndex < _Stats.Heaps.size(); ++heapIndex)
+        {
+            const RendererMemoryHeapStats& heap = _Stats.Heaps[heapIndex];
+            ImGui::Text("Heap %zu (%s): %s", heapIndex, heap.IsDeviceLocal ? "device local" : "host",
+                        FormatMemorySize(heap.Size).c_str());
+
+            ImGui::Indent();
+            ImGui::Text("Renderer: %s used of %s allocated", FormatMemorySize(heap.UsedSize).c_str(),
+                        FormatMemorySize(heap.AllocatedSize).c_str());
+
+            // NOTE: Budget is the amount the process can use without overcommitting, not the heap size
+            uint64_t limit = _Stats.IsBudgetAvailable && heap.Budget > 0 ? heap.Budget : heap.Size;
+            uint64_t usage = _Stats.IsBudgetAvailable ? heap.Usage : heap.AllocatedSize;
+            float fraction = limit > 0 ? static_cast<float>(static_cast<double>(usage) / limit) : 0.0f;
+            std::string overlay =
+                std::format("{} / {}", FormatMemorySize(usage), FormatMemorySize(limit)) +
+                (_Stats.IsBudgetAvailable ? " (process usage / budget)" : " (allocated / heap size)");
+            ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), overlay.c_str());
+            ImGui::Unindent();
+        }
+    }
+
+    void RendererMemoryPanel::DrawCategories(const RendererMemoryStats& _Stats)
+    {
+        constexpr size_t kCategoryCount = static_cast<size_t>(RendererMemoryCategory::kInternal) + 1;
+        std::array<uint64_t, kCategoryCount> categorySizes = {};
+        std::array<size_t, kCategoryCount> categoryCounts = {};
+        for (const RendererMemoryAllocationStats& allocation : _Stats.Allocations)
+        {
+            categorySizes[static_cast<size_t>(allocation.Category)] += allocation.Size;
+            ++categoryCounts[static_cast<size_t>(allocation.Category)];
+        }
+
+        for (size_t i = 0; i < kCategoryCount; ++i)
+        {
+            ImGui::Text("%s: %s (%zu)", RendererMemoryCategoryName(static_cast<RendererMemoryCategory>(i)),
+                        FormatMemorySize(categorySizes[i]).c_str(), categoryCounts[i]);
+        }
+    }
+
+    void RendererMemoryPanel::DrawAllocations(const RendererMemoryStats& _Stats)
+    {
+        m_NameFilter.Draw("Filter");
+
+        ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+                                     ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp;
+        if (!ImGui::BeginTable("Allocations", 5, tableFlags))
+        {
+            return;
+        }
+
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Category");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("Heap");
+        ImGui::TableSetupColumn("Dedicated");
+        ImGui::TableHeadersRow();
+
+        // NOTE: Allocations come sorted by size, biggest first
+        for (const RendererMemoryAllocationStats& allocation : _Stats.Allocations)
+        {
+            if (!m_NameFilter.PassFilter(allocation.Name.c_str()))
+            {
+                continue;
+            }
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(allocation.Name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(RendererMemoryCategoryName(allocation.Category));
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(FormatMemorySize(allocation.Size).c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", allocation.HeapIndex);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(allocation.IsDedicated ? "Yes" : "No");
+        }
+
+        ImGui::EndTable();
+    }
+
+}    // namespace Vega
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Vega/Renderer/RendererBackend.hpp"
+
+#include "imgui.h"
+
+namespace Vega
+{
+
+    class RendererMemoryPanel
+    {
+    public:
+        void OnImGuiRender(Ref<RendererBackend> _RendererBackend);
+
+    protected:
+        void DrawHeaps(const RendererMemoryStats& _Stats);
+        void DrawCategories(const RendererMemoryStats& _Stats);
+        void DrawAllocations(const RendererMemoryStats& _Stats);
+
+    protected:
+        ImGuiTextFilter m_NameFilter;
+    };
+
+}    // namespace Vega
@@ -0,0 +1,118 @@
+#include "Vega/Utils/FileWatcher.hpp"
+
+#include "Vega/Utils/Log.hpp"
+
+#include "Platform/Platform.hpp"
+
+#ifdef VEGA_PLATFORM_LINUX
+
+    #include <cerrno>
+    #include <cstring>
+
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+
+namespace Vega
+{
+
+    // NOTE: In place writes end with IN_CLOSE_WRITE, editors saving through a temporary file end with IN_MOVED_TO
+    static constexpr uint32_t kInotifyEventMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+    // NOTE: Upper bound of the time m_IsStopping is not checked
+    static constexpr int kInotifyPollTimeoutMs = 100;
+
+    bool FileWatcher::InitPlatform()
+    {
+        m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_InotifyFd < 0)
+        {
+            VEGA_CORE_ERROR("FileWatcher: inotify_init1 failed: {}", std::strerror(errno));
+            return false;
+        }
+
+        return true;
+    }
+
+    void FileWatcher::ShutdownPlatform()
+    {
+        if (m_InotifyFd >= 0)
+        {
+            close(m_InotifyFd);
+            m_InotifyFd = -1;
+        }
+
+        m_WatchDirectories.clear();
+        m_WatchDirectoryPaths.clear();
+    }
+
+    void FileWatcher::AddPlatformWatch(const std::filesystem::path& _Path)
+    {
+        if (m_InotifyFd < 0)
+        {
+            return;
+        }
+
+        std::filesystem::path directory = _Path.parent_path();
+        if (m_WatchDirectoryPaths.contains(directory.string()))
+        {
+            return;
+        }
+
+        int watchDescriptor = inotify_add_watch(m_InotifyFd, directory.c_str(), kInotifyEventMask);
+        if (watchDescriptor < 0)
+        {
+            VEGA_CORE_WARN("FileWatcher: Failed to watch {}: {}", directory.string(), std::strerror(errno));
+            return;
+        }
+
+        m_WatchDirectories[watchDescriptor] = directory;
+        m_WatchDirectoryPaths.insert(directory.string());
+    }
+
+    void FileWatcher::WatchLoop()
+    {
+        alignas(inotify_event) char buffer[4096];
+
+        pollfd pollFd = {
+            .fd = m_InotifyFd,
+            .events = POLLIN,
+        };
+
+        while (!m_IsStopping)
+        {
+            if (poll(&pollFd, 1, kInotifyPollTimeoutMs) <= 0)
+            {
+                continue;
+            }
+
+            ssize_t length = read(m_InotifyFd, buffer, sizeof(buffer));
+            if (length <= 0)
+            {
+                continue;
+            }
+
+            std::lock_guard lock(m_Mutex);
+            for (char* eventData = buffer; eventData < buffer + length;)
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(eventData);
+                eventData += sizeof(inotify_event) + event->len;
+
+                if (event->len == 0)
+                {
+                    continue;
+                }
+
+                auto directoryIt = m_WatchDirectories.find(event->wd);
+                if (directoryIt == m_WatchDirectories.end())
+                {
+                    continue;
+                }
+
+                NotifyFileChanged((directoryIt->second / event->name).lexically_normal());
+            }
+        }
+    }
+
+}    // namespace Vega
+
+#endif
@@ -55,6 +55,14 @@ namespace Vega
 
         // TODO: implement
         Ref<RenderBuffer> CreateRenderBuffer(const RenderBufferProps& _Props) override { return nullptr; }
+
+        // TODO: implement
+        std::future<std::vector<uint8_t>> ReadbackRenderBuffer(Ref<RenderBuffer> _RenderBuffer, size_t _Offset,
+                                                               size_t _Size) override
+        {
+            return {};
+        }
+        std::future<std::vector<uint8_t>> ReadbackTexture(Ref<Texture> _Texture) override { return {}; }
     };
 
 }    // namespace Vega
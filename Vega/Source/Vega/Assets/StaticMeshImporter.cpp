@@ -0,0 +1,460 @@
+#include "StaticMeshImporter.hpp"
+
+#include "Vega/Core/Application.hpp"
+#include "Vega/Core/Assert.hpp"
+#include "Vega/Renderer/RendererBackend.hpp"
+#include "Vega/Utils/Log.hpp"
+#include "Vega/Utils/Thread.hpp"
+
+#define CGLTF_IMPLEMENTATION
+#include "cgltf.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+namespace Vega
+{
+
+    StaticMeshImporter::StaticMeshImporter(uint32_t _WorkerCount)
+    {
+        uint32_t workerCount = _WorkerCount;
+        if (workerCount == 0)
+        {
+            workerCount = GetDefaultWorkerThreadCount();
+        }
+
+        m_Workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            m_Workers.emplace_back(&StaticMeshImporter::WorkerLoop, this);
+        }
+    }
+
+    StaticMeshImporter::~StaticMeshImporter()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_IsStopping = true;
+        }
+        m_WorkAvailable.notify_all();
+
+        for (std::thread& worker : m_Workers)
+        {
+            worker.join();
+        }
+
+        for (StaticMeshStagedData& mesh : m_ImportedMeshes)
+        {
+            StaticMeshManager::DiscardStagedMesh(mesh);
+        }
+    }
+
+    void StaticMeshImporter::Enqueue(const std::filesystem::path& _Path)
+    {
+        if (!IsSupportedFile(_Path))
+        {
+            VEGA_CORE_ERROR("StaticMeshImporter: Unsupported mesh file: {}", _Path.string());
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_PendingFiles.push_back(_Path);
+        }
+        m_WorkAvailable.notify_one();
+    }
+
+    size_t StaticMeshImporter::RegisterImportedMeshes(StaticMeshManager& _StaticMeshManager,
+                                                      bool _IncludeInFrameWorkload, size_t _MaxMeshCount,
+                                                      std::vector<std::string>* _OutMeshNames)
+    {
+        std::vector<StaticMeshStagedData> readyMeshes;
+        {
+            std::lock_guard lock(m_Mutex);
+            size_t meshCount = m_ImportedMeshes.size();
+            if (_MaxMeshCount != 0 && _MaxMeshCount < meshCount)
+            {
+                meshCount = _MaxMeshCount;
+            }
+
+            readyMeshes.reserve(meshCount);
+            std::move(m_ImportedMeshes.begin(), m_ImportedMeshes.begin() + meshCount,
+                      std::back_inserter(readyMeshes));
+            m_ImportedMeshes.erase(m_ImportedMeshes.begin(), m_ImportedMeshes.begin() + meshCount);
+        }
+
+        if (readyMeshes.empty())
+        {
+            return 0;
+        }
+
+        Ref<RendererBackend> rendererBackend = Application::Get().GetRendererBackend();
+        rendererBackend->BeginUploadBatch();
+        size_t registeredMeshCount = 0;
+        for (StaticMeshStagedData& mesh : readyMeshes)
+        {
+            // NOTE: The same file may be imported twice, AddStagedMesh asserts on duplicate names
+            if (_StaticMeshManager.GetMeshInfo(mesh.MeshName))
+            {
+                VEGA_CORE_WARN("StaticMeshImporter: Skip already registered mesh: {}", mesh.MeshName);
+                StaticMeshManager::DiscardStagedMesh(mesh);
+                continue;
+            }
+
+            _StaticMeshManager.AddStagedMesh(mesh, _IncludeInFrameWorkload);
+            if (_OutMeshNames)
+            {
+                _OutMeshNames->push_back(std::move(mesh.MeshName));
+            }
+            ++registeredMeshCount;
+        }
+        rendererBackend->EndUploadBatch();
+
+        return registeredMeshCount;
+    }
+
+    void StaticMeshImporter::WaitIdle()
+    {
+        std::unique_lock lock(m_Mutex);
+        m_WorkDone.wait(lock, [this]() { return m_PendingFiles.empty() && m_FilesInProgress == 0; });
+    }
+
+    bool StaticMeshImporter::IsIdle()
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_PendingFiles.empty() && m_FilesInProgress == 0;
+    }
+
+    bool StaticMeshImporter::IsSupportedFile(const std::filesystem::path& _Path)
+    {
+        std::string extension = _Path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char _Char) { return static_cast<char>(std::tolower(_Char)); });
+        return extension == ".gltf" || extension == ".glb" || extension == ".obj";
+    }
+
+    std::string StaticMeshImporter::GetMeshNamePrefix(const std::filesystem::path& _Path)
+    {
+        // NOTE: Files with the same stem in different directories must not produce the same mesh names
+        return (_Path.parent_path() / _Path.stem()).generic_string();
+    }
+
+    void StaticMeshImporter::WorkerLoop()
+    {
+        while (true)
+        {
+            std::filesystem::path path;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_WorkAvailable.wait(lock, [this]() { return m_IsStopping || !m_PendingFiles.empty(); });
+                if (m_IsStopping)
+                {
+                    return;
+                }
+
+                path = std::move(m_PendingFiles.front());
+                m_PendingFiles.pop_front();
+                ++m_FilesInProgress;
+            }
+
+            std::vector<StaticMeshStagedData> meshes;
+            ImportFile(path, meshes);
+            for (StaticMeshStagedData& mesh : meshes)
+            {
+                StaticMeshManager::PrepareStagedMesh(mesh);
+            }
+
+            {
+                std::lock_guard lock(m_Mutex);
+                std::move(meshes.begin(), meshes.end(), std::back_inserter(m_ImportedMeshes));
+                --m_FilesInProgress;
+            }
+            m_WorkDone.notify_all();
+        }
+    }
+
+    void StaticMeshImporter::ImportFile(const std::filesystem::path& _Path,
+                                        std::vector<StaticMeshStagedData>& _OutMeshes)
+    {
+        std::string extension = _Path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char _Char) { return static_cast<char>(std::tolower(_Char)); });
+
+        bool isImported = extension == ".obj" ? ImportObj(_Path, _OutMeshes) : ImportGltf(_Path, _OutMeshes);
+        if (!isImported)
+        {
+            VEGA_CORE_ERROR("StaticMeshImporter: Failed to import mesh file: {}", _Path.string());
+        }
+    }
+
+    bool StaticMeshImporter::ImportGltf(const std::filesystem::path& _Path,
+                                        std::vector<StaticMeshStagedData>& _OutMeshes)
+    {
+        std::string pathString = _Path.string();
+
+        cgltf_options options = {};
+        cgltf_data* data = nullptr;
+        if (cgltf_parse_file(&options, pathString.c_str(), &data) != cgltf_result_success)
+        {
+            return false;
+        }
+
+        if (cgltf_load_buffers(&options, data, pathString.c_str()) != cgltf_result_success)
+        {
+            cgltf_free(data);
+            return false;
+        }
+
+        std::string fileName = GetMeshNamePrefix(_Path);
+        for (cgltf_size meshIndex = 0; meshIndex < data->meshes_count; ++meshIndex)
+        {
+            const cgltf_mesh& mesh = data->meshes[meshIndex];
+            std::string meshName = mesh.name ? mesh.name : std::to_string(meshIndex);
+
+            for (cgltf_size primitiveIndex = 0; primitiveIndex < mesh.primitives_count; ++primitiveIndex)
+            {
+                const cgltf_primitive& primitive = mesh.primitives[primitiveIndex];
+                if (primitive.type != cgltf_primitive_type_triangles)
+                {
+                    VEGA_CORE_WARN("StaticMeshImporter: Skip non triangle primitive {} of mesh {} in {}",
+                                   primitiveIndex, meshName, pathString);
+                    continue;
+                }
+
+                const cgltf_accessor* positions = nullptr;
+                for (cgltf_size attributeIndex = 0; attributeIndex < primitive.attributes_count; ++attributeIndex)
+                {
+                    if (primitive.attributes[attributeIndex].type == cgltf_attribute_type_position)
+                    {
+                        positions = primitive.attributes[attributeIndex].data;
+                        break;
+                    }
+                }
+                if (!positions || positions->count == 0)
+                {
+                    continue;
+                }
+
+                if (primitive.indices && !ValidateGltfIndices(primitive.indices, positions->count))
+                {
+                    VEGA_CORE_ERROR("StaticMeshImporter: Index out of range in primitive {} of mesh {} in {}",
+                                    primitiveIndex, meshName, pathString);
+                    continue;
+                }
+
+                size_t indexCount = primitive.indices ? primitive.indices->count : positions->count;
+                StaticMeshStagedData stagedData;
+                if (!StaticMeshManager::ReserveStagedMesh(
+                        std::format("{}/{}/{}", fileName, meshName, primitiveIndex), positions->count, indexCount,
+                        stagedData))
+                {
+                    VEGA_CORE_ERROR("StaticMeshImporter: Failed to reserve staging memory for mesh {} in {}",
+                                    meshName, pathString);
+                    continue;
+                }
+
+                StaticMeshVertex* vertices = stagedData.GetVertices();
+                for (cgltf_size i = 0; i < positions->count; ++i)
+                {
+                    cgltf_accessor_read_float(positions, i, &vertices[i].Position.x, 3);
+                }
+
+                // NOTE: Indices are written in the index type of the GPU buffer the mesh goes to
+                auto writeIndices = [&](auto* _OutIndices) {
+                    using TIndex = std::remove_pointer_t<decltype(_OutIndices)>;
+                    for (size_t i = 0; i < indexCount; ++i)
+                    {
+                        _OutIndices[i] = static_cast<TIndex>(
+                            primitive.indices ? cgltf_accessor_read_index(primitive.indices, i) : i);
+                    }
+                };
+                if (stagedData.IndexType == StaticMeshIndexType::kUint16)
+                {
+                    writeIndices(static_cast<StaticMeshIndex16*>(stagedData.GetIndexData()));
+                }
+                else
+                {
+                    writeIndices(static_cast<StaticMeshIndex*>(stagedData.GetIndexData()));
+                }
+
+                _OutMeshes.push_back(std::move(stagedData));
+            }
+        }
+
+        cgltf_free(data);
+        return true;
+    }
+
+    bool StaticMeshImporter::ValidateGltfIndices(const cgltf_accessor* _Indices, size_t _VertexCount)
+    {
+        for (cgltf_size i = 0; i < _Indices->count; ++i)
+        {
+            if (cgltf_accessor_read_index(_Indices, i) >= _VertexCount)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const char* SkipSpaces(const char* _Begin, const char* _End)
+    {
+        while (_Begin < _End && (*_Begin == ' ' || *_Begin == '\t'))
+        {
+            ++_Begin;
+        }
+        return _Begin;
+    }
+
+    bool StaticMeshImporter::ImportObj(const std::filesystem::path& _Path,
+                                       std::vector<StaticMeshStagedData>& _OutMeshes)
+    {
+        std::ifstream file(_Path, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        std::string content(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        file.read(content.data(), content.size());
+
+        // NOTE: Count elements first to reserve the staging range once and decode into it
+        size_t vertexCount = 0;
+        size_t faceCornerCount = 0;
+        for (size_t lineStart = 0; lineStart < content.size();)
+        {
+            size_t lineEnd = content.find('\n', lineStart);
+            lineEnd = lineEnd == std::string::npos ? content.size() : lineEnd;
+            std::string_view line(content.data() + lineStart, lineEnd - lineStart);
+            if (line.starts_with("v "))
+            {
+                ++vertexCount;
+            }
+            else if (line.starts_with("f "))
+            {
+                size_t cornerCount = 0;
+                for (size_t i = 1; i < line.size(); ++i)
+                {
+                    cornerCount += (line[i - 1] == ' ' || line[i - 1] == '\t') && line[i] != ' ' && line[i] != '\t' &&
+                                   line[i] != '\r';
+                }
+                faceCornerCount += cornerCount >= 3 ? (cornerCount - 2) * 3 : 0;
+            }
+            lineStart = lineEnd + 1;
+        }
+
+        if (vertexCount == 0 || faceCornerCount == 0)
+        {
+            return false;
+        }
+
+        StaticMeshStagedData stagedData;
+        if (!StaticMeshManager::ReserveStagedMesh(GetMeshNamePrefix(_Path), vertexCount, faceCornerCount, stagedData))
+        {
+            return false;
+        }
+
+        StaticMeshVertex* vertices = stagedData.GetVertices();
+        size_t decodedVertexCount = 0;
+        size_t decodedIndexCount = 0;
+        bool is16BitIndex = stagedData.IndexType == StaticMeshIndexType::kUint16;
+        auto pushIndex = [&](StaticMeshIndex _Index) {
+            if (is16BitIndex)
+            {
+                static_cast<StaticMeshIndex16*>(stagedData.GetIndexData())[decodedIndexCount++] =
+                    static_cast<StaticMeshIndex16>(_Index);
+            }
+            else
+            {
+                static_cast<StaticMeshIndex*>(stagedData.GetIndexData())[decodedIndexCount++] = _Index;
+            }
+        };
+
+        for (size_t lineStart = 0; lineStart < content.size();)
+        {
+            size_t lineEnd = content.find('\n', lineStart);
+            lineEnd = lineEnd == std::string::npos ? content.size() : lineEnd;
+            const char* cursor = content.data() + lineStart;
+            const char* end = content.data() + lineEnd;
+            lineStart = lineEnd + 1;
+
+            if (end - cursor < 2 || cursor[1] != ' ')
+            {
+                continue;
+            }
+
+            if (cursor[0] == 'v')
+            {
+                StaticMeshVertex& vertex = vertices[decodedVertexCount++];
+                vertex.Position = glm::vec3(0.0f);
+                cursor += 2;
+                for (glm::length_t i = 0; i < 3; ++i)
+                {
+                    cursor = SkipSpaces(cursor, end);
+                    cursor = std::from_chars(cursor, end, vertex.Position[i]).ptr;
+                }
+            }
+            else if (cursor[0] == 'f')
+            {
+                cursor += 2;
+                StaticMeshIndex firstIndex = 0;
+                StaticMeshIndex previousIndex = 0;
+                uint32_t cornerIndex = 0;
+                while ((cursor = SkipSpaces(cursor, end)) < end && *cursor != '\r')
+                {
+                    int64_t objIndex = 0;
+                    cursor = std::from_chars(cursor, end, objIndex).ptr;
+                    // NOTE: Skip texture coordinate and normal indices (v/vt/vn)
+                    while (cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r')
+                    {
+                        ++cursor;
+                    }
+
+                    // NOTE: OBJ indices are 1-based, negative values are relative to the last vertex
+                    int64_t resolvedIndex =
+                        objIndex < 0 ? static_cast<int64_t>(decodedVertexCount) + objIndex : objIndex - 1;
+                    bool isIndexCountExceeded = cornerIndex >= 2 && decodedIndexCount + 3 > stagedData.IndexCount;
+                    if (resolvedIndex < 0 || resolvedIndex >= static_cast<int64_t>(vertexCount) ||
+                        isIndexCountExceeded)
+                    {
+                        StaticMeshManager::DiscardStagedMesh(stagedData);
+                        return false;
+                    }
+
+                    StaticMeshIndex index = static_cast<StaticMeshIndex>(resolvedIndex);
+                    if (cornerIndex == 0)
+                    {
+                        firstIndex = index;
+                    }
+                    else if (cornerIndex >= 2)
+                    {
+                        // NOTE: Triangulate polygons as a fan
+                        pushIndex(firstIndex);
+                        pushIndex(previousIndex);
+                        pushIndex(index);
+                    }
+                    previousIndex = index;
+                    ++cornerIndex;
+                }
+            }
+        }
+
+        stagedData.IndexCount = decodedIndexCount;
+        if (decodedIndexCount == 0)
+        {
+            StaticMeshManager::DiscardStagedMesh(stagedData);
+            return false;
+        }
+
+        _OutMeshes.push_back(std::move(stagedData));
+        return true;
+    }
+
+}    // namespace Vega
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Vega/Managers/StaticMeshManager.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct cgltf_accessor;
+
+namespace Vega
+{
+
+    /**
+     * @brief Imports static meshes from glTF 2.0 (.gltf, .glb) and Wavefront OBJ files.
+     *
+     * Files are parsed on worker threads. Every mesh reserves a staging range sized from the file before decoding
+     * and its geometry is decoded straight into it in the final GPU layout. Staged meshes are registered with
+     * StaticMeshManager in batches by RegisterImportedMeshes, which must be called on the thread that owns the
+     * renderer and only records the GPU copies of the staged ranges.
+     */
+    class StaticMeshImporter
+    {
+    public:
+        StaticMeshImporter(uint32_t _WorkerCount = 0);
+        ~StaticMeshImporter();
+
+        void Enqueue(const std::filesystem::path& _Path);
+
+        /**
+         * @brief Registers meshes parsed so far with the StaticMeshManager.
+         *
+         * @param _MaxMeshCount Maximum number of meshes to register (0 - all ready meshes).
+         * @param _OutMeshNames Optional, names of the registered meshes are appended to it.
+         * @return size_t Number of registered meshes.
+         */
+        size_t RegisterImportedMeshes(StaticMeshManager& _StaticMeshManager, bool _IncludeInFrameWorkload,
+                                      size_t _MaxMeshCount = 0, std::vector<std::string>* _OutMeshNames = nullptr);
+
+        void WaitIdle();
+        bool IsIdle();
+
+        static bool IsSupportedFile(const std::filesystem::path& _Path);
+
+    protected:
+        void WorkerLoop();
+
+        void ImportFile(const std::filesystem::path& _Path, std::vector<StaticMeshStagedData>& _OutMeshes);
+        static bool ImportGltf(const std::filesystem::path& _Path, std::vector<StaticMeshStagedData>& _OutMeshes);
+        static bool ImportObj(const std::filesystem::path& _Path, std::vector<StaticMeshStagedData>& _OutMeshes);
+
+        static std::string GetMeshNamePrefix(const std::filesystem::path& _Path);
+        // NOTE: Any index outside the vertex range rejects the primitive, it would read past the vertex buffer
+        static bool ValidateGltfIndices(const cgltf_accessor* _Indices, size_t _VertexCount);
+
+    protected:
+        std::vector<std::thread> m_Workers;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_WorkAvailable;
+        std::condition_variable m_WorkDone;
+
+        std::deque<std::filesystem::path> m_PendingFiles;
+        std::vector<StaticMeshStagedData> m_ImportedMeshes;
+        size_t m_FilesInProgress = 0;
+
+        bool m_IsStopping = false;
+    };
+
+}    // namespace Vega
@@ -1,9 +1,17 @@
 #include "StaticMeshManager.hpp"
+#include "StaticMeshMeshletBuilder.hpp"
 
 #include "Vega/Core/Application.hpp"
 #include "Vega/Core/Assert.hpp"
 #include "Vega/Renderer/RendererBackend.hpp"
 
+#include "glm/common.hpp"
+#include "glm/exponential.hpp"
+#include "glm/geometric.hpp"
+
+#include <limits>
+#include <vector>
+
 namespace Vega
 {
 
@@ -16,8 +24,7 @@ namespace Vega
             .Type = RenderBufferType::kVertex,
             .ElementSize = sizeof(StaticMeshVertex),
             .ElementCount = 1024 * 1024,    // TODO: Make configurable
-            .AllocatorType = RenderBufferAllocatorType::kLinear,
-            // TODO: .AllocatorType = RenderBufferAllocatorType::kFreeList,
+            .AllocatorType = RenderBufferAllocatorType::kFreeList,
         });
 
         m_IndexBuffer = rendererBackend->CreateRenderBuffer(RenderBufferProps {
@@ -25,8 +32,15 @@ namespace Vega
             .Type = RenderBufferType::kIndex,
             .ElementSize = sizeof(StaticMeshIndex),
             .ElementCount = 1024 * 1024 * 4,    // TODO: Make configurable
-            .AllocatorType = RenderBufferAllocatorType::kLinear,
-            // TODO: .AllocatorType = RenderBufferAllocatorType::kFreeList,
+            .AllocatorType = RenderBufferAllocatorType::kFreeList,
+        });
+
+        m_IndexBuffer16 = rendererBackend->CreateRenderBuffer(RenderBufferProps {
+            .Name = "StaticMeshManager_IndexBuffer16",
+            .Type = RenderBufferType::kIndex,
+            .ElementSize = sizeof(StaticMeshIndex16),
+            .ElementCount = 1024 * 1024 * 4,    // TODO: Make configurable
+            .AllocatorType = RenderBufferAllocatorType::kFreeList,
         });
     }
 
@@ -34,33 +48,426 @@ namespace Vega
     {
         m_VertexBuffer->Destroy();
         m_IndexBuffer->Destroy();
+        m_IndexBuffer16->Destroy();
     }
 
     StaticMeshManagerMeshInfo StaticMeshManager::AddMesh(std::string_view _MeshName, const StaticMeshVertex* _Vertices,
                                                          size_t _VertexCount, const StaticMeshIndex* _Indices,
-                                                         size_t _IndexCount, bool _IncludeInFrameWorkload)
+                                                         size_t _IndexCount, bool _IncludeInFrameWorkload,
+                                                         bool _IsEvictable)
     {
+        std::string meshName(_MeshName);
+        VEGA_CORE_ASSERT(!m_MeshesInfo.contains(meshName), "StaticMeshManager::AddMesh: Mesh already exists!");
+
         StaticMeshManagerMeshInfo meshInfo;
-        meshInfo.VertexOffset =
-            m_VertexBuffer->LoadRange(_VertexCount * sizeof(StaticMeshVertex), _Vertices, _IncludeInFrameWorkload);
         meshInfo.VertexCount = _VertexCount;
-        meshInfo.IndexOffset =
-            m_IndexBuffer->LoadRange(_IndexCount * sizeof(StaticMeshIndex), _Indices, _IncludeInFrameWorkload);
         meshInfo.IndexCount = _IndexCount;
+        meshInfo.IndexType = GetIndexType(_VertexCount);
+
+        ComputeBounds(_Vertices, _VertexCount, meshInfo.BoundingBox, meshInfo.BoundingSphere);
+
+        meshInfo.MeshletOffset = m_Meshlets.size();
+        if (_IndexCount / 3 > kMeshletMinTriangleCount)
+        {
+            StaticMeshMeshletBuilder::Build(_Vertices, _VertexCount, _Indices, _IndexCount, m_Meshlets);
+        }
+        meshInfo.MeshletCount = m_Meshlets.size() - meshInfo.MeshletOffset;
+
+        UploadMesh(meshInfo, _Vertices, _Indices, _IncludeInFrameWorkload);
+
+        MeshResidency& residency = m_MeshesResidency[meshName];
+        residency.IsEvictable = _IsEvictable;
+        residency.LruIterator = m_LruMeshes.end();
+        if (_IsEvictable)
+        {
+            residency.Vertices.assign(_Vertices, _Vertices + _VertexCount);
+            residency.Indices.assign(_Indices, _Indices + _IndexCount);
+            m_LruMeshes.push_front(meshName);
+            residency.LruIterator = m_LruMeshes.begin();
+        }
+
+        m_MeshesInfo[meshName] = meshInfo;
+
+        EvictToBudget();
+
+        return meshInfo;
+    }
+
+    bool StaticMeshManager::ReserveStagedMesh(std::string_view _MeshName, size_t _VertexCount, size_t _MaxIndexCount,
+                                              StaticMeshStagedData& _OutStagedData)
+    {
+        _OutStagedData.MeshName = _MeshName;
+        _OutStagedData.VertexCount = _VertexCount;
+        _OutStagedData.IndexCount = _MaxIndexCount;
+        _OutStagedData.IndexType = GetIndexType(_VertexCount);
+
+        size_t stagingSize =
+            _OutStagedData.GetIndexDataOffset() + _MaxIndexCount * GetIndexSize(_OutStagedData.IndexType);
+        return Application::Get().GetRendererBackend()->ReserveStagingRange(stagingSize, _OutStagedData.StagingRange);
+    }
+
+    void StaticMeshManager::PrepareStagedMesh(StaticMeshStagedData& _StagedData)
+    {
+        // NOTE: Staging memory may be write combined, reads happen once here on the importing thread
+        const StaticMeshVertex* vertices = _StagedData.GetVertices();
+        ComputeBounds(vertices, _StagedData.VertexCount, _StagedData.BoundingBox, _StagedData.BoundingSphere);
+
+        _StagedData.Meshlets.clear();
+        if (_StagedData.IndexCount / 3 <= kMeshletMinTriangleCount)
+        {
+            return;
+        }
+
+        if (_StagedData.IndexType == StaticMeshIndexType::kUint16)
+        {
+            StaticMeshMeshletBuilder::Build(vertices, _StagedData.VertexCount,
+                                            static_cast<const StaticMeshIndex16*>(_StagedData.GetIndexData()),
+                                            _StagedData.IndexCount, _StagedData.Meshlets);
+        }
+        else
+        {
+            StaticMeshMeshletBuilder::Build(vertices, _StagedData.VertexCount,
+                                            static_cast<const StaticMeshIndex*>(_StagedData.GetIndexData()),
+                                            _StagedData.IndexCount, _StagedData.Meshlets);
+        }
+    }
 
-        m_MeshesInfo[_MeshName.data()] = meshInfo;
+    void StaticMeshManager::DiscardStagedMesh(StaticMeshStagedData& _StagedData)
+    {
+        if (_StagedData.StagingRange.MappedData)
+        {
+            Application::Get().GetRendererBackend()->DiscardStagingRange(_StagedData.StagingRange);
+            _StagedData.StagingRange = {};
+        }
+    }
+
+    StaticMeshManagerMeshInfo StaticMeshManager::AddStagedMesh(StaticMeshStagedData& _StagedData,
+                                                               bool _IncludeInFrameWorkload)
+    {
+        VEGA_CORE_ASSERT(!m_MeshesInfo.contains(_StagedData.MeshName),
+                         "StaticMeshManager::AddStagedMesh: Mesh already exists!");
+        VEGA_CORE_ASSERT(_StagedData.StagingRange.MappedData, "StaticMeshManager::AddStagedMesh: Mesh is not staged!");
+
+        StaticMeshManagerMeshInfo meshInfo;
+        meshInfo.VertexCount = _StagedData.VertexCount;
+        meshInfo.IndexCount = _StagedData.IndexCount;
+        meshInfo.IndexType = _StagedData.IndexType;
+        meshInfo.BoundingBox = _StagedData.BoundingBox;
+        meshInfo.BoundingSphere = _StagedData.BoundingSphere;
+
+        meshInfo.MeshletOffset = m_Meshlets.size();
+        m_Meshlets.insert(m_Meshlets.end(), _StagedData.Meshlets.begin(), _StagedData.Meshlets.end());
+        meshInfo.MeshletCount = _StagedData.Meshlets.size();
+
+        Ref<RendererBackend> rendererBackend = Application::Get().GetRendererBackend();
+        if (!_IncludeInFrameWorkload)
+        {
+            rendererBackend->BeginUploadBatch();
+        }
+
+        // NOTE: Geometry is copied by the GPU from the staging range, the CPU does not touch it again
+        meshInfo.VertexOffset = m_VertexBuffer->LoadRangeFromStaging(
+            meshInfo.VertexCount * sizeof(StaticMeshVertex), _StagedData.StagingRange, 0, _IncludeInFrameWorkload);
+        const Ref<RenderBuffer>& indexBuffer =
+            meshInfo.IndexType == StaticMeshIndexType::kUint16 ? m_IndexBuffer16 : m_IndexBuffer;
+        meshInfo.IndexOffset = indexBuffer->LoadRangeFromStaging(meshInfo.IndexCount * GetIndexSize(meshInfo.IndexType),
+                                                                 _StagedData.StagingRange,
+                                                                 _StagedData.GetIndexDataOffset(),
+                                                                 _IncludeInFrameWorkload);
+        rendererBackend->ReleaseStagingRange(_StagedData.StagingRange, _IncludeInFrameWorkload);
+        _StagedData.StagingRange = {};
+
+        if (!_IncludeInFrameWorkload)
+        {
+            rendererBackend->EndUploadBatch();
+        }
+
+        meshInfo.IsResident = true;
+        m_ResidentMemorySize += GetMeshMemorySize(meshInfo);
+
+        MeshResidency& residency = m_MeshesResidency[_StagedData.MeshName];
+        residency.IsEvictable = false;
+        residency.LruIterator = m_LruMeshes.end();
+
+        m_MeshesInfo[_StagedData.MeshName] = meshInfo;
+
+        EvictToBudget();
 
         return meshInfo;
     }
 
+    void StaticMeshManager::AcquireMesh(std::string_view _MeshName)
+    {
+        std::string meshName(_MeshName);
+        auto residencyIt = m_MeshesResidency.find(meshName);
+        if (residencyIt == m_MeshesResidency.end())
+        {
+            VEGA_CORE_WARN("StaticMeshManager::AcquireMesh: Mesh {} not found!", meshName);
+            return;
+        }
+
+        MeshResidency& residency = residencyIt->second;
+        if (residency.RefCount++ > 0 || !residency.IsEvictable)
+        {
+            return;
+        }
+
+        StaticMeshManagerMeshInfo& meshInfo = m_MeshesInfo.at(meshName);
+        if (meshInfo.IsResident)
+        {
+            m_LruMeshes.erase(residency.LruIterator);
+            residency.LruIterator = m_LruMeshes.end();
+        }
+        else
+        {
+            UploadMesh(meshInfo, residency.Vertices.data(), residency.Indices.data(), false);
+        }
+
+        EvictToBudget();
+    }
+
+    void StaticMeshManager::ReleaseMesh(std::string_view _MeshName)
+    {
+        std::string meshName(_MeshName);
+        auto residencyIt = m_MeshesResidency.find(meshName);
+        if (residencyIt == m_MeshesResidency.end())
+        {
+            return;
+        }
+
+        MeshResidency& residency = residencyIt->second;
+        VEGA_CORE_ASSERT(residency.RefCount > 0, "StaticMeshManager::ReleaseMesh: Mesh is not acquired!");
+        if (--residency.RefCount > 0 || !residency.IsEvictable)
+        {
+            return;
+        }
+
+        m_LruMeshes.push_front(meshName);
+        residency.LruIterator = m_LruMeshes.begin();
+
+        EvictToBudget();
+    }
+
+    void StaticMeshManager::SetMemoryBudget(size_t _MemoryBudget)
+    {
+        m_MemoryBudget = _MemoryBudget;
+        EvictToBudget();
+    }
+
+    void StaticMeshManager::UploadMesh(StaticMeshManagerMeshInfo& _MeshInfo, const StaticMeshVertex* _Vertices,
+                                       const StaticMeshIndex* _Indices, bool _IncludeInFrameWorkload)
+    {
+        _MeshInfo.VertexOffset = m_VertexBuffer->LoadRange(_MeshInfo.VertexCount * sizeof(StaticMeshVertex),
+                                                           _Vertices, _IncludeInFrameWorkload);
+
+        if (_MeshInfo.IndexType == StaticMeshIndexType::kUint16)
+        {
+            std::vector<StaticMeshIndex16> indices16(_MeshInfo.IndexCount);
+            for (size_t i = 0; i < _MeshInfo.IndexCount; ++i)
+            {
+                VEGA_CORE_ASSERT(_Indices[i] < _MeshInfo.VertexCount,
+                                 "StaticMeshManager::UploadMesh: Index out of range!");
+                indices16[i] = static_cast<StaticMeshIndex16>(_Indices[i]);
+            }
+
+            _MeshInfo.IndexOffset = m_IndexBuffer16->LoadRange(_MeshInfo.IndexCount * sizeof(StaticMeshIndex16),
+                                                               indices16.data(), _IncludeInFrameWorkload);
+        }
+        else
+        {
+            _MeshInfo.IndexOffset = m_IndexBuffer->LoadRange(_MeshInfo.IndexCount * sizeof(StaticMeshIndex),
+                                                             _Indices, _IncludeInFrameWorkload);
+        }
+
+        _MeshInfo.IsResident = true;
+        m_ResidentMemorySize += GetMeshMemorySize(_MeshInfo);
+    }
+
+    void StaticMeshManager::EvictMesh(StaticMeshManagerMeshInfo& _MeshInfo)
+    {
+        // NOTE: Frames in flight may still draw the mesh, RenderBuffer reuses the ranges once the GPU finished them
+        m_VertexBuffer->FreeRange(_MeshInfo.VertexOffset, _MeshInfo.VertexCount * sizeof(StaticMeshVertex));
+        if (_MeshInfo.IndexType == StaticMeshIndexType::kUint16)
+        {
+            m_IndexBuffer16->FreeRange(_MeshInfo.IndexOffset, _MeshInfo.IndexCount * sizeof(StaticMeshIndex16));
+        }
+        else
+        {
+            m_IndexBuffer->FreeRange(_MeshInfo.IndexOffset, _MeshInfo.IndexCount * sizeof(StaticMeshIndex));
+        }
+
+        _MeshInfo.IsResident = false;
+        m_ResidentMemorySize -= GetMeshMemorySize(_MeshInfo);
+    }
+
+    void StaticMeshManager::EvictToBudget(std::string_view _KeepMeshName)
+    {
+        while (m_ResidentMemorySize > m_MemoryBudget && !m_LruMeshes.empty() && m_LruMeshes.back() != _KeepMeshName)
+        {
+            std::string meshName = std::move(m_LruMeshes.back());
+            m_LruMeshes.pop_back();
+            m_MeshesResidency.at(meshName).LruIterator = m_LruMeshes.end();
+
+            EvictMesh(m_MeshesInfo.at(meshName));
+        }
+    }
+
+    StaticMeshIndexType StaticMeshManager::GetIndexType(size_t _VertexCount)
+    {
+        return _VertexCount <= static_cast<size_t>(std::numeric_limits<StaticMeshIndex16>::max())
+                   ? StaticMeshIndexType::kUint16
+                   : StaticMeshIndexType::kUint32;
+    }
+
+    size_t StaticMeshManager::GetIndexSize(StaticMeshIndexType _IndexType)
+    {
+        return _IndexType == StaticMeshIndexType::kUint16 ? sizeof(StaticMeshIndex16) : sizeof(StaticMeshIndex);
+    }
+
+    size_t StaticMeshManager::GetMeshMemorySize(const StaticMeshManagerMeshInfo& _MeshInfo)
+    {
+        return _MeshInfo.VertexCount * sizeof(StaticMeshVertex) +
+               _MeshInfo.IndexCount * GetIndexSize(_MeshInfo.IndexType);
+    }
+
+    const StaticMeshManagerMeshInfo* StaticMeshManager::GetMeshInfo(std::string_view _MeshName) const
+    {
+        auto meshInfoIt = m_MeshesInfo.find(_MeshName.data());
+        if (meshInfoIt == m_MeshesInfo.end())
+        {
+            return nullptr;
+        }
+        return &meshInfoIt->second;
+    }
+
+    size_t StaticMeshManager::CullMesh(std::string_view _MeshName, const StaticMeshCullParams& _CullParams,
+                                       std::vector<StaticMeshDrawIndexedCommand>& _OutCommands) const
+    {
+        const StaticMeshManagerMeshInfo* meshInfo = GetMeshInfo(_MeshName);
+        VEGA_CORE_ASSERT(meshInfo, "StaticMeshManager::CullMesh: Mesh not found!");
+
+        glm::vec4 frustumPlanes[6];
+        StaticMeshMeshletBuilder::ExtractFrustumPlanes(_CullParams.ModelViewProjection, frustumPlanes);
+
+        if (!StaticMeshMeshletBuilder::IsSphereVisible(frustumPlanes, meshInfo->BoundingSphere))
+        {
+            return 0;
+        }
+
+        if (meshInfo->MeshletCount == 0)
+        {
+            _OutCommands.push_back(StaticMeshDrawIndexedCommand {
+                .IndexCount = static_cast<uint32_t>(meshInfo->IndexCount),
+                .InstanceCount = 1,
+                .FirstIndex = 0,
+                .VertexOffset = 0,
+                .FirstInstance = 0,
+            });
+            return 1;
+        }
+
+        size_t commandCount = 0;
+        for (size_t i = meshInfo->MeshletOffset; i < meshInfo->MeshletOffset + meshInfo->MeshletCount; ++i)
+        {
+            const StaticMeshMeshlet& meshlet = m_Meshlets[i];
+            if (!StaticMeshMeshletBuilder::IsSphereVisible(frustumPlanes, meshlet.BoundingSphere))
+            {
+                continue;
+            }
+            if (_CullParams.IsConeCullingEnabled &&
+                StaticMeshMeshletBuilder::IsMeshletBackfacing(meshlet, _CullParams.CameraPosition))
+            {
+                continue;
+            }
+
+            // NOTE: Merge with previous command if meshlets are adjacent in the index buffer
+            if (commandCount > 0 &&
+                _OutCommands.back().FirstIndex + _OutCommands.back().IndexCount == meshlet.IndexOffset)
+            {
+                _OutCommands.back().IndexCount += meshlet.IndexCount;
+                continue;
+            }
+
+            _OutCommands.push_back(StaticMeshDrawIndexedCommand {
+                .IndexCount = meshlet.IndexCount,
+                .InstanceCount = 1,
+                .FirstIndex = meshlet.IndexOffset,
+                .VertexOffset = 0,
+                .FirstInstance = 0,
+            });
+            ++commandCount;
+        }
+
+        return commandCount;
+    }
+
+    void StaticMeshManager::ComputeBounds(const StaticMeshVertex* _Vertices, size_t _VertexCount,
+                                          StaticMeshBoundingBox& _OutBoundingBox,
+                                          StaticMeshBoundingSphere& _OutBoundingSphere)
+    {
+        if (_VertexCount == 0)
+        {
+            _OutBoundingBox = { .Min = glm::vec3(0.0f), .Max = glm::vec3(0.0f) };
+            _OutBoundingSphere = { .Center = glm::vec3(0.0f), .Radius = 0.0f };
+            return;
+        }
+
+        // NOTE: Scalar per vertex pass with component-wise min/max, positions are AoS so there is no SIMD load path
+        glm::vec3 boundsMin = _Vertices[0].Position;
+        glm::vec3 boundsMax = _Vertices[0].Position;
+        for (size_t i = 1; i < _VertexCount; ++i)
+        {
+            boundsMin = glm::min(boundsMin, _Vertices[i].Position);
+            boundsMax = glm::max(boundsMax, _Vertices[i].Position);
+        }
+
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        float maxDistanceSquared = 0.0f;
+        for (size_t i = 0; i < _VertexCount; ++i)
+        {
+            glm::vec3 delta = _Vertices[i].Position - center;
+            maxDistanceSquared = glm::max(maxDistanceSquared, glm::dot(delta, delta));
+        }
+
+        _OutBoundingBox = { .Min = boundsMin, .Max = boundsMax };
+        _OutBoundingSphere = { .Center = center, .Radius = glm::sqrt(maxDistanceSquared) };
+    }
+
     void StaticMeshManager::BindMesh(std::string_view _MeshName)
     {
         VEGA_CORE_ASSERT(!_MeshName.empty(), "StaticMeshManager::BindMesh: Mesh name is empty!");
         auto meshInfoIt = m_MeshesInfo.find(_MeshName.data());
         VEGA_CORE_ASSERT(meshInfoIt != m_MeshesInfo.end(), "StaticMeshManager::BindMesh: Mesh not found!");
 
-        m_VertexBuffer->Bind(meshInfoIt->second.VertexOffset);
-        m_IndexBuffer->Bind(meshInfoIt->second.IndexOffset);
+        StaticMeshManagerMeshInfo& meshInfo = meshInfoIt->second;
+        MeshResidency& residency = m_MeshesResidency.at(meshInfoIt->first);
+        if (!meshInfo.IsResident)
+        {
+            // NOTE: Can be called inside rendering, so upload is done outside of the frame command buffer
+            UploadMesh(meshInfo, residency.Vertices.data(), residency.Indices.data(), false);
+            if (residency.RefCount == 0)
+            {
+                m_LruMeshes.push_front(meshInfoIt->first);
+                residency.LruIterator = m_LruMeshes.begin();
+            }
+
+            EvictToBudget(meshInfoIt->first);
+        }
+        else if (residency.RefCount == 0 && residency.IsEvictable)
+        {
+            // NOTE: Binding counts as a use, unreferenced meshes drawn every frame are evicted last
+            m_LruMeshes.splice(m_LruMeshes.begin(), m_LruMeshes, residency.LruIterator);
+        }
+
+        m_VertexBuffer->Bind(meshInfo.VertexOffset);
+        if (meshInfo.IndexType == StaticMeshIndexType::kUint16)
+        {
+            m_IndexBuffer16->Bind(meshInfo.IndexOffset);
+        }
+        else
+        {
+            m_IndexBuffer->Bind(meshInfo.IndexOffset);
+        }
     }
 
 }    // namespace Vega
@@ -3,10 +3,14 @@
 #include "Manager.hpp"
 #include "Vega/Renderer/RenderBuffer.hpp"
 
+#include "glm/ext/matrix_float4x4.hpp"
 #include "glm/ext/vector_float3.hpp"
 
+#include <limits>
+#include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Vega
 {
@@ -17,6 +21,61 @@ namespace Vega
     };
 
     typedef uint32_t StaticMeshIndex;
+    typedef uint16_t StaticMeshIndex16;
+
+    enum class StaticMeshIndexType
+    {
+        kUint16,
+        kUint32,
+    };
+
+    struct StaticMeshBoundingBox
+    {
+        glm::vec3 Min;
+        glm::vec3 Max;
+    };
+
+    struct StaticMeshBoundingSphere
+    {
+        glm::vec3 Center;
+        float Radius;
+    };
+
+    // NOTE: Cluster of up to kMaxVertices unique vertices / kMaxTriangles triangles of a mesh. Triangles of a meshlet
+    //       are a contiguous range of the mesh index buffer, so every meshlet is drawable with a single indexed draw
+    struct StaticMeshMeshlet
+    {
+        static constexpr uint32_t kMaxVertices = 64;
+        static constexpr uint32_t kMaxTriangles = 124;
+
+        uint32_t IndexOffset;
+        uint32_t IndexCount;
+
+        StaticMeshBoundingSphere BoundingSphere;
+
+        // NOTE: Normal cone, the meshlet is backfacing if
+        //       dot(Center - CameraPosition, ConeAxis) >= ConeCutoff * length(Center - CameraPosition) + Radius
+        glm::vec3 ConeAxis;
+        float ConeCutoff;
+    };
+
+    // NOTE: Same layout as VkDrawIndexedIndirectCommand
+    struct StaticMeshDrawIndexedCommand
+    {
+        uint32_t IndexCount;
+        uint32_t InstanceCount;
+        uint32_t FirstIndex;
+        int32_t VertexOffset;
+        uint32_t FirstInstance;
+    };
+
+    struct StaticMeshCullParams
+    {
+        glm::mat4 ModelViewProjection;
+        // NOTE: Camera position in mesh local space
+        glm::vec3 CameraPosition;
+        bool IsConeCullingEnabled = true;
+    };
 
     struct StaticMeshManagerMeshInfo
     {
@@ -24,10 +83,37 @@ namespace Vega
         size_t VertexCount;
         size_t IndexOffset;
         size_t IndexCount;
+        StaticMeshIndexType IndexType;
+
+        // NOTE: Bounds are in mesh local space
+        StaticMeshBoundingBox BoundingBox;
+        StaticMeshBoundingSphere BoundingSphere;
 
-        // TODO: May need add reference count for mesh usage tracking and auto release if set to autorelease
+        // NOTE: Range in StaticMeshManager meshlets storage, MeshletCount is 0 for small meshes
+        size_t MeshletOffset;
+        size_t MeshletCount;
 
-        // TODO: Add BoundingBox, BoundingSphere, etc. (may be in separate struct and manager)
+        bool IsResident;
+    };
+
+    // NOTE: Geometry decoded straight into a reserved staging range, StaticMeshVertex array at the start followed by
+    //       the IndexType index array
+    struct StaticMeshStagedData
+    {
+        std::string MeshName;
+        RenderBufferStagingRange StagingRange;
+        size_t VertexCount = 0;
+        size_t IndexCount = 0;
+        StaticMeshIndexType IndexType = StaticMeshIndexType::kUint32;
+
+        // NOTE: Filled by StaticMeshManager::PrepareStagedMesh
+        StaticMeshBoundingBox BoundingBox;
+        StaticMeshBoundingSphere BoundingSphere;
+        std::vector<StaticMeshMeshlet> Meshlets;
+
+        StaticMeshVertex* GetVertices() const { return static_cast<StaticMeshVertex*>(StagingRange.MappedData); }
+        size_t GetIndexDataOffset() const { return VertexCount * sizeof(StaticMeshVertex); }
+        void* GetIndexData() const { return static_cast<uint8_t*>(StagingRange.MappedData) + GetIndexDataOffset(); }
     };
 
     class StaticMeshManager : public Manager
@@ -38,18 +124,112 @@ namespace Vega
 
         virtual void Destroy() override;
 
+        /**
+         * @brief Registers the mesh and uploads it to the GPU buffers.
+         *
+         * Only evictable meshes keep a CPU copy of their geometry (to reload it after eviction), other meshes stay
+         * resident until the manager is destroyed.
+         */
         StaticMeshManagerMeshInfo AddMesh(std::string_view _MeshName, const StaticMeshVertex* _Vertices,
                                           size_t _VertexCount, const StaticMeshIndex* _Indices, size_t _IndexCount,
-                                          bool _IncludeInFrameWorkload);
+                                          bool _IncludeInFrameWorkload, bool _IsEvictable = false);
+
+        /**
+         * @brief Reserves staging memory for a mesh of up to _MaxIndexCount indices, can be called from any thread.
+         *
+         * The caller decodes the geometry into the reservation, sets the final IndexCount and calls
+         * PrepareStagedMesh. Reservations that are not added must be discarded with DiscardStagedMesh.
+         */
+        static bool ReserveStagedMesh(std::string_view _MeshName, size_t _VertexCount, size_t _MaxIndexCount,
+                                      StaticMeshStagedData& _OutStagedData);
+        // NOTE: Computes bounds and meshlets of the staged geometry, can be called from any thread
+        static void PrepareStagedMesh(StaticMeshStagedData& _StagedData);
+        static void DiscardStagedMesh(StaticMeshStagedData& _StagedData);
 
+        /**
+         * @brief Registers a staged mesh and copies its geometry from the staging range to the GPU buffers.
+         *
+         * The staging range is released. Staged meshes have no CPU copy of their geometry, so they are not evictable.
+         */
+        StaticMeshManagerMeshInfo AddStagedMesh(StaticMeshStagedData& _StagedData, bool _IncludeInFrameWorkload);
+
+        // NOTE: Reloads the mesh if it was evicted
         void BindMesh(std::string_view _MeshName);
 
+        /**
+         * @brief Reference counting of mesh usage (driven by StaticMeshComponent construction/destruction).
+         *
+         * Unreferenced evictable meshes stay resident in LRU order and are evicted from the GPU buffers when resident
+         * memory exceeds the memory budget. Acquiring an evicted mesh loads it again.
+         */
+        void AcquireMesh(std::string_view _MeshName);
+        void ReleaseMesh(std::string_view _MeshName);
+
+        void SetMemoryBudget(size_t _MemoryBudget);
+        size_t GetMemoryBudget() const { return m_MemoryBudget; }
+        size_t GetResidentMemorySize() const { return m_ResidentMemorySize; }
+
+        // NOTE: Returns nullptr if mesh is not found
+        const StaticMeshManagerMeshInfo* GetMeshInfo(std::string_view _MeshName) const;
+
+        /**
+         * @brief Appends draw commands for the visible meshlets of the mesh.
+         *
+         * Meshes without meshlets emit a single command for the whole mesh if its bounding sphere is visible.
+         * Commands are relative to the offsets bound by BindMesh.
+         *
+         * @return size_t Number of appended commands.
+         */
+        size_t CullMesh(std::string_view _MeshName, const StaticMeshCullParams& _CullParams,
+                        std::vector<StaticMeshDrawIndexedCommand>& _OutCommands) const;
+
+        // NOTE: Meshes with more triangles are split into meshlets
+        static constexpr size_t kMeshletMinTriangleCount = StaticMeshMeshlet::kMaxTriangles * 4;
+
+        // NOTE: Every index of a mesh with less than 65536 vertices fits into 16 bits, so such meshes are stored
+        //       in the separate 16-bit index buffer (half of the memory and index fetch bandwidth)
+        static StaticMeshIndexType GetIndexType(size_t _VertexCount);
+        static size_t GetIndexSize(StaticMeshIndexType _IndexType);
+
+    protected:
+        struct MeshResidency
+        {
+            uint32_t RefCount = 0;
+            bool IsEvictable = false;
+            // NOTE: m_LruMeshes.end() if the mesh is not in the LRU list
+            std::list<std::string>::iterator LruIterator;
+
+            // NOTE: CPU copy of the geometry to reload the mesh after eviction, empty for non evictable meshes
+            std::vector<StaticMeshVertex> Vertices;
+            std::vector<StaticMeshIndex> Indices;
+        };
+
+        void UploadMesh(StaticMeshManagerMeshInfo& _MeshInfo, const StaticMeshVertex* _Vertices,
+                        const StaticMeshIndex* _Indices, bool _IncludeInFrameWorkload);
+        void EvictMesh(StaticMeshManagerMeshInfo& _MeshInfo);
+        // NOTE: _KeepMeshName must be at the LRU front (or referenced), it is never evicted
+        void EvictToBudget(std::string_view _KeepMeshName = {});
+
+        static size_t GetMeshMemorySize(const StaticMeshManagerMeshInfo& _MeshInfo);
+
+        static void ComputeBounds(const StaticMeshVertex* _Vertices, size_t _VertexCount,
+                                  StaticMeshBoundingBox& _OutBoundingBox, StaticMeshBoundingSphere& _OutBoundingSphere);
+
     protected:
         // TODO: friend class AssetManager;
     protected:
         Ref<RenderBuffer> m_VertexBuffer;
         Ref<RenderBuffer> m_IndexBuffer;
+        Ref<RenderBuffer> m_IndexBuffer16;
         std::unordered_map<std::string, StaticMeshManagerMeshInfo> m_MeshesInfo;
+        std::vector<StaticMeshMeshlet> m_Meshlets;
+
+        std::unordered_map<std::string, MeshResidency> m_MeshesResidency;
+        // NOTE: Unreferenced resident meshes, most recently released first
+        std::list<std::string> m_LruMeshes;
+
+        size_t m_MemoryBudget = std::numeric_limits<size_t>::max();
+        size_t m_ResidentMemorySize = 0;
     };
 
 }    // namespace Vega
@@ -0,0 +1,174 @@
+#include "StaticMeshMeshletBuilder.hpp"
+
+#include "glm/common.hpp"
+#include "glm/exponential.hpp"
+#include "glm/geometric.hpp"
+#include "glm/gtc/matrix_access.hpp"
+
+#include <limits>
+
+namespace Vega
+{
+
+    template <typename TIndex>
+    void StaticMeshMeshletBuilder::Build(const StaticMeshVertex* _Vertices, size_t _VertexCount,
+                                         const TIndex* _Indices, size_t _IndexCount,
+                                         std::vector<StaticMeshMeshlet>& _OutMeshlets)
+    {
+        // NOTE: Marks the last meshlet that used the vertex to count unique vertices without per-meshlet sets
+        std::vector<uint32_t> vertexMeshletMarks(_VertexCount, std::numeric_limits<uint32_t>::max());
+
+        uint32_t meshletMark = 0;
+        StaticMeshMeshlet meshlet = { .IndexOffset = 0, .IndexCount = 0 };
+        uint32_t meshletVertexCount = 0;
+
+        size_t triangleCount = _IndexCount / 3;
+        for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+        {
+            const TIndex* triangleIndices = _Indices + triangle * 3;
+
+            uint32_t newVertexCount = 0;
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                newVertexCount += vertexMeshletMarks[triangleIndices[corner]] != meshletMark;
+            }
+
+            bool isMeshletFull = meshletVertexCount + newVertexCount > StaticMeshMeshlet::kMaxVertices ||
+                                 meshlet.IndexCount / 3 + 1 > StaticMeshMeshlet::kMaxTriangles;
+            if (isMeshletFull)
+            {
+                ComputeMeshletBounds(_Vertices, _Indices, meshlet);
+                _OutMeshlets.push_back(meshlet);
+
+                ++meshletMark;
+                meshlet = { .IndexOffset = static_cast<uint32_t>(triangle * 3), .IndexCount = 0 };
+                meshletVertexCount = 0;
+            }
+
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t& mark = vertexMeshletMarks[triangleIndices[corner]];
+                meshletVertexCount += mark != meshletMark;
+                mark = meshletMark;
+            }
+            meshlet.IndexCount += 3;
+        }
+
+        if (meshlet.IndexCount > 0)
+        {
+            ComputeMeshletBounds(_Vertices, _Indices, meshlet);
+            _OutMeshlets.push_back(meshlet);
+        }
+    }
+
+    bool StaticMeshMeshletBuilder::IsSphereVisible(const glm::vec4 (&_FrustumPlanes)[6],
+                                                   const StaticMeshBoundingSphere& _Sphere)
+    {
+        for (const glm::vec4& plane : _FrustumPlanes)
+        {
+            if (glm::dot(glm::vec3(plane), _Sphere.Center) + plane.w < -_Sphere.Radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool StaticMeshMeshletBuilder::IsMeshletBackfacing(const StaticMeshMeshlet& _Meshlet,
+                                                       const glm::vec3& _CameraPosition)
+    {
+        glm::vec3 toCenter = _Meshlet.BoundingSphere.Center - _CameraPosition;
+        return glm::dot(toCenter, _Meshlet.ConeAxis) >=
+               _Meshlet.ConeCutoff * glm::length(toCenter) + _Meshlet.BoundingSphere.Radius;
+    }
+
+    void StaticMeshMeshletBuilder::ExtractFrustumPlanes(const glm::mat4& _Matrix, glm::vec4 (&_OutFrustumPlanes)[6])
+    {
+        glm::vec4 rowX = glm::row(_Matrix, 0);
+        glm::vec4 rowY = glm::row(_Matrix, 1);
+        glm::vec4 rowZ = glm::row(_Matrix, 2);
+        glm::vec4 rowW = glm::row(_Matrix, 3);
+
+        _OutFrustumPlanes[0] = rowW + rowX;
+        _OutFrustumPlanes[1] = rowW - rowX;
+        _OutFrustumPlanes[2] = rowW + rowY;
+        _OutFrustumPlanes[3] = rowW - rowY;
+        _OutFrustumPlanes[4] = rowZ;
+        _OutFrustumPlanes[5] = rowW - rowZ;
+
+        for (glm::vec4& plane : _OutFrustumPlanes)
+        {
+            float length = glm::length(glm::vec3(plane));
+            plane = length > 0.0f ? plane / length : plane;
+        }
+    }
+
+    template <typename TIndex>
+    void StaticMeshMeshletBuilder::ComputeMeshletBounds(const StaticMeshVertex* _Vertices, const TIndex* _Indices,
+                                                        StaticMeshMeshlet& _Meshlet)
+    {
+        const TIndex* indices = _Indices + _Meshlet.IndexOffset;
+
+        glm::vec3 boundsMin = _Vertices[indices[0]].Position;
+        glm::vec3 boundsMax = boundsMin;
+        for (uint32_t i = 1; i < _Meshlet.IndexCount; ++i)
+        {
+            boundsMin = glm::min(boundsMin, _Vertices[indices[i]].Position);
+            boundsMax = glm::max(boundsMax, _Vertices[indices[i]].Position);
+        }
+
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        float maxDistanceSquared = 0.0f;
+        for (uint32_t i = 0; i < _Meshlet.IndexCount; ++i)
+        {
+            glm::vec3 delta = _Vertices[indices[i]].Position - center;
+            maxDistanceSquared = glm::max(maxDistanceSquared, glm::dot(delta, delta));
+        }
+        _Meshlet.BoundingSphere = { .Center = center, .Radius = glm::sqrt(maxDistanceSquared) };
+
+        glm::vec3 normalSum(0.0f);
+        for (uint32_t i = 0; i < _Meshlet.IndexCount; i += 3)
+        {
+            const glm::vec3& p0 = _Vertices[indices[i + 0]].Position;
+            const glm::vec3& p1 = _Vertices[indices[i + 1]].Position;
+            const glm::vec3& p2 = _Vertices[indices[i + 2]].Position;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float normalLength = glm::length(normal);
+            normalSum += normalLength > 0.0f ? normal / normalLength : glm::vec3(0.0f);
+        }
+
+        // NOTE: ConeCutoff = 1 never passes the backface test, used for degenerate cones
+        float normalSumLength = glm::length(normalSum);
+        if (normalSumLength <= 0.0f)
+        {
+            _Meshlet.ConeAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+            _Meshlet.ConeCutoff = 1.0f;
+            return;
+        }
+        _Meshlet.ConeAxis = normalSum / normalSumLength;
+
+        float minDot = 1.0f;
+        for (uint32_t i = 0; i < _Meshlet.IndexCount; i += 3)
+        {
+            const glm::vec3& p0 = _Vertices[indices[i + 0]].Position;
+            const glm::vec3& p1 = _Vertices[indices[i + 1]].Position;
+            const glm::vec3& p2 = _Vertices[indices[i + 2]].Position;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float normalLength = glm::length(normal);
+            if (normalLength > 0.0f)
+            {
+                minDot = glm::min(minDot, glm::dot(normal / normalLength, _Meshlet.ConeAxis));
+            }
+        }
+
+        _Meshlet.ConeCutoff = minDot <= 0.0f ? 1.0f : glm::sqrt(1.0f - minDot * minDot);
+    }
+
+    template void StaticMeshMeshletBuilder::Build<StaticMeshIndex>(const StaticMeshVertex*, size_t,
+                                                                   const StaticMeshIndex*, size_t,
+                                                                   std::vector<StaticMeshMeshlet>&);
+    template void StaticMeshMeshletBuilder::Build<StaticMeshIndex16>(const StaticMeshVertex*, size_t,
+                                                                     const StaticMeshIndex16*, size_t,
+                                                                     std::vector<StaticMeshMeshlet>&);
+
+}    // namespace Vega
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "StaticMeshManager.hpp"
+
+#include <vector>
+
+namespace Vega
+{
+
+    class StaticMeshMeshletBuilder
+    {
+    public:
+        /**
+         * @brief Splits mesh triangles into meshlets with bounding sphere and normal cone.
+         *
+         * Triangles are clustered greedily in index buffer order, so the index buffer is left untouched and
+         * every meshlet references a contiguous index range. Importers are expected to provide cache/locality
+         * optimized index order. Instantiated for StaticMeshIndex and StaticMeshIndex16.
+         */
+        template <typename TIndex>
+        static void Build(const StaticMeshVertex* _Vertices, size_t _VertexCount, const TIndex* _Indices,
+                          size_t _IndexCount, std::vector<StaticMeshMeshlet>& _OutMeshlets);
+
+        static bool IsSphereVisible(const glm::vec4 (&_FrustumPlanes)[6], const StaticMeshBoundingSphere& _Sphere);
+        static bool IsMeshletBackfacing(const StaticMeshMeshlet& _Meshlet, const glm::vec3& _CameraPosition);
+
+        // NOTE: Planes in the space of the matrix input, normalized (Vulkan clip space depth range 0..1)
+        static void ExtractFrustumPlanes(const glm::mat4& _Matrix, glm::vec4 (&_OutFrustumPlanes)[6]);
+
+    protected:
+        template <typename TIndex>
+        static void ComputeMeshletBounds(const StaticMeshVertex* _Vertices, const TIndex* _Indices,
+                                         StaticMeshMeshlet& _Meshlet);
+    };
+
+}    // namespace Vega
@@ -1,6 +1,8 @@
 #include "RenderBuffer.hpp"
 #include "RenderBufferAllocator.hpp"
+#include "Vega/Core/Application.hpp"
 #include "Vega/Core/Assert.hpp"
+#include "Vega/Renderer/RendererBackend.hpp"
 
 namespace Vega
 {
@@ -13,7 +15,8 @@ namespace Vega
                 m_Allocator = CreateScope<RenderBufferLinearAllocator>(_Props.ElementSize * _Props.ElementCount);
                 break;
             case RenderBufferAllocatorType::kFreeList:
-                VEGA_CORE_ASSERT("RenderBufferAllocatorType::kFreeList not implemented yet!");
+                m_Allocator = CreateScope<RenderBufferFreeListAllocator>(_Props.ElementSize * _Props.ElementCount);
+                break;
             case RenderBufferAllocatorType::kNone:
             default: break;
         }
@@ -23,6 +26,7 @@ namespace Vega
     {
         DestroyInternal();
         m_Allocator.reset();
+        m_FreedRanges.clear();
     }
 
     void RenderBuffer::Clear(bool _IsNeedZeroMemory)
@@ -34,6 +38,7 @@ namespace Vega
 
         if (m_Allocator)
         {
+            m_FreedRanges.clear();
             m_Allocator->Clear();
             // Implement clearing logic using allocator here
         }
@@ -48,7 +53,8 @@ namespace Vega
         };
         if (m_Allocator)
         {
-            allocateResult = m_Allocator->Allocate(_Size);
+            ReclaimFreedRanges();
+            allocateResult = m_Allocator->Allocate(_Size, GetOffsetAlignment());
             VEGA_CORE_ASSERT(allocateResult.Status == RenderBufferAllocateResultStatus::kSuccess,
                              "RenderBuffer LoadRange: Out of memory! Resize is not supported yet.");
         }
@@ -56,4 +62,64 @@ namespace Vega
         return allocateResult.Offset;
     }
 
+    size_t RenderBuffer::LoadRangeFromStaging(size_t _Size, const RenderBufferStagingRange& _StagingRange,
+                                              size_t _StagingOffset, bool _IncludeInFrameWorkload)
+    {
+        VEGA_CORE_ASSERT(m_Allocator, "RenderBuffer LoadRangeFromStaging: Buffer has no allocator!");
+        VEGA_CORE_ASSERT(_StagingOffset + _Size <= _StagingRange.Size,
+                         "RenderBuffer LoadRangeFromStaging: Range is out of staging range bounds!");
+
+        ReclaimFreedRanges();
+        RenderBufferAllocateResult allocateResult = m_Allocator->Allocate(_Size, GetOffsetAlignment());
+        VEGA_CORE_ASSERT(allocateResult.Status == RenderBufferAllocateResultStatus::kSuccess,
+                         "RenderBuffer LoadRangeFromStaging: Out of memory! Resize is not supported yet.");
+
+        LoadRangeFromStagingInternal(allocateResult.Offset, _Size, _StagingRange, _StagingOffset,
+                                     _IncludeInFrameWorkload);
+        return allocateResult.Offset;
+    }
+
+    void RenderBuffer::FreeRange(size_t _Offset, size_t _Size)
+    {
+        VEGA_CORE_ASSERT(m_Allocator, "RenderBuffer FreeRange: Buffer has no allocator!");
+
+        // NOTE: Uploads do not wait for the graphics queue, so the range must not be overwritten while frames
+        //       recorded up to the current one can still read it
+        uint64_t frameNumber = Application::Get().GetRendererBackend()->GetCurrentFrameNumber();
+        m_FreedRanges.push_back(FreedRange {
+            .Offset = _Offset,
+            .Size = _Size,
+            .FrameNumber = frameNumber,
+        });
+    }
+
+    void RenderBuffer::ReclaimFreedRanges()
+    {
+        if (m_FreedRanges.empty())
+        {
+            return;
+        }
+
+        uint64_t completedFrameNumber = Application::Get().GetRendererBackend()->GetCompletedFrameNumber();
+        std::erase_if(m_FreedRanges, [&](const FreedRange& _Range) {
+            if (_Range.FrameNumber > completedFrameNumber)
+            {
+                return false;
+            }
+            m_Allocator->Free(_Range.Offset, _Range.Size);
+            return true;
+        });
+    }
+
+    void RenderBuffer::WriteRange(size_t _Offset, size_t _Size, const void* _Data, bool _IncludeInFrameWorkload)
+    {
+        if (_Size == 0)
+        {
+            return;
+        }
+
+        VEGA_CORE_ASSERT(_Offset + _Size <= GetSize(), "RenderBuffer WriteRange: Range is out of buffer bounds!");
+        LoadRangeInternal(_Offset, _Size, _Data, _IncludeInFrameWorkload);
+    }
+
 }    // namespace Vega
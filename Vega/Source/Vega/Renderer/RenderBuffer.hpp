@@ -1,10 +1,13 @@
 #pragma once
 
 #include "RenderBufferAllocator.hpp"
+#include "Vega/Core/Assert.hpp"
 #include "Vega/Core/Base.hpp"
 
 #include <cstddef>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace Vega
 {
@@ -16,7 +19,8 @@ namespace Vega
         kUniform,
         kStaging,
         kRead,
-        kStorage,
+        kStorage,               // Device local, written through staging
+        kStorageHostVisible,    // Written directly by the CPU, for data rewritten every frame
     };
 
     struct RenderBufferProps
@@ -28,6 +32,15 @@ namespace Vega
         RenderBufferAllocatorType AllocatorType = RenderBufferAllocatorType::kNone;
     };
 
+    // NOTE: Persistently mapped staging memory reserved with RendererBackend::ReserveStagingRange, it can be filled
+    //       on any thread and is loaded into RenderBuffers on the renderer thread
+    struct RenderBufferStagingRange
+    {
+        void* MappedData = nullptr;
+        size_t Size = 0;
+        uint64_t Id = 0;
+    };
+
     class RenderBuffer
     {
     public:
@@ -37,18 +50,71 @@ namespace Vega
         void Destroy();
         void Clear(bool _IsNeedZeroMemory = false);
         size_t LoadRange(size_t _Size, const void* _Data, bool _IncludeInFrameWorkload);
+        // NOTE: Frames in flight may still read the range, it is reused once the GPU finished the current frame
+        void FreeRange(size_t _Offset, size_t _Size);
+
+        /**
+         * @brief Allocates a range and fills it with _Size bytes at _StagingOffset of the staging range.
+         *
+         * The staging range stays reserved, release it with RendererBackend::ReleaseStagingRange after its last load.
+         */
+        size_t LoadRangeFromStaging(size_t _Size, const RenderBufferStagingRange& _StagingRange, size_t _StagingOffset,
+                                    bool _IncludeInFrameWorkload);
+
+        /**
+         * @brief Writes _Size bytes at _Offset, bypassing the range allocator.
+         *
+         * NOTE: Caller must guarantee that the range is not read by the GPU in frames that are still in flight
+         */
+        void WriteRange(size_t _Offset, size_t _Size, const void* _Data, bool _IncludeInFrameWorkload);
+
+        /**
+         * @brief Writes typed elements starting from element _FirstElement.
+         *
+         * T must match the ElementSize of the buffer, e.g. per-instance data of a storage buffer.
+         */
+        template <typename T>
+        void WriteElements(size_t _FirstElement, std::span<const T> _Elements, bool _IncludeInFrameWorkload)
+        {
+            VEGA_CORE_ASSERT(sizeof(T) == m_RenderBufferProps.ElementSize,
+                             "RenderBuffer WriteElements: Element type size does not match ElementSize!");
+            WriteRange(_FirstElement * sizeof(T), _Elements.size_bytes(), _Elements.data(), _IncludeInFrameWorkload);
+        }
 
         virtual void Bind(size_t _Offset) = 0;
 
+        // NOTE: Offsets returned by LoadRange are multiples of it
+        virtual size_t GetOffsetAlignment() const { return 1; }
+
+        RenderBufferType GetType() const { return m_RenderBufferProps.Type; }
+        size_t GetElementSize() const { return m_RenderBufferProps.ElementSize; }
+        size_t GetElementCount() const { return m_RenderBufferProps.ElementCount; }
+        size_t GetSize() const { return m_RenderBufferProps.ElementSize * m_RenderBufferProps.ElementCount; }
+        // NOTE: Buffers without allocator are always treated as full
+        size_t GetFreeSize() const { return m_Allocator ? m_Allocator->GetFreeSize() : 0; }
+
     protected:
+        struct FreedRange
+        {
+            size_t Offset;
+            size_t Size;
+            uint64_t FrameNumber;
+        };
+
+        void ReclaimFreedRanges();
+
         virtual void DestroyInternal() = 0;
         virtual void LoadRangeInternal(size_t _Offset, size_t _Size, const void* _Data,
                                        bool _IncludeInFrameWorkload) = 0;
+        virtual void LoadRangeFromStagingInternal(size_t _Offset, size_t _Size,
+                                                  const RenderBufferStagingRange& _StagingRange, size_t _StagingOffset,
+                                                  bool _IncludeInFrameWorkload) = 0;
 
     protected:
         RenderBufferProps m_RenderBufferProps;
 
         Scope<RenderBufferAllocator> m_Allocator = nullptr;
+        std::vector<FreedRange> m_FreedRanges;
     };
 
 }    // namespace Vega
@@ -1,5 +1,7 @@
 #include "RenderBufferAllocator.hpp"
 
+#include <iterator>
+
 namespace Vega
 {
 
@@ -8,16 +10,92 @@ namespace Vega
           m_CurrentOffset(0)
     { }
 
-    RenderBufferAllocateResult RenderBufferLinearAllocator::Allocate(size_t _Size)
+    RenderBufferAllocateResult RenderBufferLinearAllocator::Allocate(size_t _Size, size_t _Alignment)
     {
-        if (m_CurrentOffset + _Size > m_TotalSize)
+        size_t allocatedOffset = RenderBufferAlignOffset(m_CurrentOffset, _Alignment);
+        if (allocatedOffset + _Size > m_TotalSize)
         {
             return RenderBufferAllocateResult { RenderBufferAllocateResultStatus::kOutOfMemory, m_CurrentOffset };
         }
 
-        size_t allocatedOffset = m_CurrentOffset;
-        m_CurrentOffset += _Size;
+        m_CurrentOffset = allocatedOffset + _Size;
         return RenderBufferAllocateResult { RenderBufferAllocateResultStatus::kSuccess, allocatedOffset };
     }
 
+    void RenderBufferLinearAllocator::Free(size_t _Offset, size_t _Size)
+    {
+        if (_Offset + _Size == m_CurrentOffset)
+        {
+            m_CurrentOffset = _Offset;
+        }
+    }
+
+    RenderBufferFreeListAllocator::RenderBufferFreeListAllocator(size_t _TotalSize) : RenderBufferAllocator(_TotalSize)
+    {
+        Clear();
+    }
+
+    RenderBufferAllocateResult RenderBufferFreeListAllocator::Allocate(size_t _Size, size_t _Alignment)
+    {
+        // NOTE: First fit, the padding in front of an aligned offset stays a free block
+        for (auto blockIt = m_FreeBlocks.begin(); blockIt != m_FreeBlocks.end(); ++blockIt)
+        {
+            auto [blockOffset, blockSize] = *blockIt;
+            size_t padding = RenderBufferAlignOffset(blockOffset, _Alignment) - blockOffset;
+            if (blockSize < padding + _Size)
+            {
+                continue;
+            }
+
+            m_FreeBlocks.erase(blockIt);
+            if (padding > 0)
+            {
+                m_FreeBlocks.emplace(blockOffset, padding);
+            }
+            if (blockSize > padding + _Size)
+            {
+                m_FreeBlocks.emplace(blockOffset + padding + _Size, blockSize - padding - _Size);
+            }
+            m_FreeSize -= _Size;
+            return RenderBufferAllocateResult { RenderBufferAllocateResultStatus::kSuccess, blockOffset + padding };
+        }
+
+        return RenderBufferAllocateResult { RenderBufferAllocateResultStatus::kOutOfMemory, 0 };
+    }
+
+    void RenderBufferFreeListAllocator::Free(size_t _Offset, size_t _Size)
+    {
+        if (_Size == 0)
+        {
+            return;
+        }
+
+        m_FreeSize += _Size;
+        auto blockIt = m_FreeBlocks.emplace(_Offset, _Size).first;
+
+        auto nextIt = std::next(blockIt);
+        if (nextIt != m_FreeBlocks.end() && blockIt->first + blockIt->second == nextIt->first)
+        {
+            blockIt->second += nextIt->second;
+            m_FreeBlocks.erase(nextIt);
+        }
+
+        if (blockIt != m_FreeBlocks.begin())
+        {
+            auto prevIt = std::prev(blockIt);
+            if (prevIt->first + prevIt->second == blockIt->first)
+            {
+                prevIt->second += blockIt->second;
+                m_FreeBlocks.erase(blockIt);
+            }
+        }
+    }
+
+    void RenderBufferFreeListAllocator::Clear()
+    {
+        m_FreeBlocks.clear();
+        m_FreeBlocks.emplace(0, m_TotalSize);
+        m_FreeSize = m_TotalSize;
+    }
+
 }    // namespace Vega
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <map>
 
 namespace Vega
 {
@@ -24,6 +26,11 @@ namespace Vega
         size_t Offset = 0;
     };
 
+    inline size_t RenderBufferAlignOffset(size_t _Offset, size_t _Alignment)
+    {
+        return (_Offset + _Alignment - 1) / _Alignment * _Alignment;
+    }
+
     class RenderBufferAllocator
     {
     public:
@@ -32,9 +39,13 @@ namespace Vega
 
         void SetTotalSize(size_t _Size) { m_TotalSize = _Size; }
         size_t GetTotalSize() const { return m_TotalSize; }
-        virtual RenderBufferAllocateResult Allocate(size_t _Size) = 0;
+        // NOTE: Returned offset is a multiple of _Alignment (e.g. minStorageBufferOffsetAlignment for storage buffers)
+        virtual RenderBufferAllocateResult Allocate(size_t _Size, size_t _Alignment = 1) = 0;
+        virtual void Free(size_t _Offset, size_t _Size) = 0;
         virtual void Clear() = 0;
 
+        virtual size_t GetFreeSize() const = 0;
+
     protected:
         size_t m_TotalSize = 0;
     };
@@ -44,11 +55,32 @@ namespace Vega
     public:
         RenderBufferLinearAllocator(size_t _TotalSize);
         virtual ~RenderBufferLinearAllocator() override = default;
-        RenderBufferAllocateResult Allocate(size_t _Size) override;
+        RenderBufferAllocateResult Allocate(size_t _Size, size_t _Alignment = 1) override;
+        // NOTE: Only the last allocation can be freed
+        void Free(size_t _Offset, size_t _Size) override;
         void Clear() override { m_CurrentOffset = 0; }
 
+        size_t GetFreeSize() const override { return m_TotalSize - m_CurrentOffset; }
+
     protected:
         size_t m_CurrentOffset = 0;
     };
 
+    class RenderBufferFreeListAllocator : public RenderBufferAllocator
+    {
+    public:
+        RenderBufferFreeListAllocator(size_t _TotalSize);
+        virtual ~RenderBufferFreeListAllocator() override = default;
+        RenderBufferAllocateResult Allocate(size_t _Size, size_t _Alignment = 1) override;
+        void Free(size_t _Offset, size_t _Size) override;
+        void Clear() override;
+
+        size_t GetFreeSize() const override { return m_FreeSize; }
+
+    protected:
+        // NOTE: Free blocks sorted by offset (offset -> size), adjacent blocks are always merged
+        std::map<size_t, size_t> m_FreeBlocks;
+        size_t m_FreeSize = 0;
+    };
+
 }    // namespace Vega
@@ -10,6 +10,11 @@
 #include "Vega/ImGui/ImGuiImpl.hpp"
 #include "Vega/Plugins/PluginLibrary.hpp"
 #include "Vega/Renderer/RendererBackendApi.hpp"
+#include "Vega/Renderer/RendererBackendTypes.hpp"
+
+#include <cstdint>
+#include <future>
+#include <vector>
 
 namespace Vega
 {
@@ -64,6 +69,11 @@ namespace Vega
         virtual void TmpRendergraphExecute() = 0;
         virtual void FramePresent() = 0;
 
+        // NOTE: Number of the frame being recorded, GPU work recorded in it is finished once the completed frame
+        //       number reaches it (backends without frames in flight complete every frame immediately)
+        virtual uint64_t GetCurrentFrameNumber() const { return 0; }
+        virtual uint64_t GetCompletedFrameNumber() const { return 0; }
+
         void SetClearColor(const glm::vec4& _ClearColor) { m_ClearColor = _ClearColor; }
         const glm::vec4& GetClearColor() const { return m_ClearColor; }
 
@@ -72,7 +82,32 @@ namespace Vega
 
         static RendererBackendApi GetAPI() { return s_API; }
 
-        // virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0) = 0;
+        // NOTE: Draws with the currently bound shader, vertex and index buffers
+        virtual void DrawIndexed(uint32_t _IndexCount, uint32_t _FirstIndex, int32_t _VertexOffset) { }
+        // NOTE: Reads _DrawCount tightly packed commands with the layout of VkDrawIndexedIndirectCommand from
+        //       _CommandBuffer at _Offset (kStorage or kStorageHostVisible buffer)
+        virtual void DrawIndexedIndirect(Ref<RenderBuffer> _CommandBuffer, size_t _Offset, uint32_t _DrawCount) { }
+
+        // NOTE: Uploads outside of frame workload between Begin/End are recorded to one command buffer and submitted
+        //       once on EndUploadBatch (calls can be nested)
+        virtual void BeginUploadBatch() { }
+        virtual void EndUploadBatch() { }
+
+        /**
+         * @brief Reserves _Size bytes of mapped staging memory, can be called from any thread.
+         *
+         * The range stays valid until ReleaseStagingRange (or DiscardStagingRange if nothing was loaded from it).
+         *
+         * @return bool False if the backend does not support staging ranges.
+         */
+        virtual bool ReserveStagingRange(size_t _Size, RenderBufferStagingRange& _OutStagingRange) { return false; }
+        // NOTE: The memory is reused once the loads recorded from the range are complete, _IncludeInFrameWorkload
+        //       must match the loads
+        virtual void ReleaseStagingRange(const RenderBufferStagingRange& _StagingRange, bool _IncludeInFrameWorkload)
+        {
+        }
+        // NOTE: Releases a range nothing was loaded from, can be called from any thread
+        virtual void DiscardStagingRange(const RenderBufferStagingRange& _StagingRange) { }
 
         static CreateReturnValue Create(RendererBackendApi _RendererAPI);
 
@@ -87,6 +122,18 @@ namespace Vega
 
         virtual Ref<RenderBuffer> CreateRenderBuffer(const RenderBufferProps& _Props) = 0;
 
+        // NOTE: Readbacks copy into a kRead buffer inside the current frame (must be called outside of rendering) and
+        //       complete once the frame is finished on the GPU, polled at the start of a later frame without stalls
+        virtual std::future<std::vector<uint8_t>> ReadbackRenderBuffer(Ref<RenderBuffer> _RenderBuffer, size_t _Offset,
+                                                                       size_t _Size) = 0;
+        // NOTE: Reads mip 0 of layer 0 (depth aspect of depth textures), tightly packed rows. Returns an invalid
+        //       future (valid() == false) if the texture format can not be read back
+        virtual std::future<std::vector<uint8_t>> ReadbackTexture(Ref<Texture> _Texture) = 0;
+
+        // NOTE: Snapshot of every live device memory allocation (tagged by resource name) and per heap usage
+        virtual RendererMemoryStats GetMemoryStats() const { return {}; }
+        virtual RendererCommandStats GetCommandStats() const { return {}; }
+
         virtual Ref<ImGuiImpl> CreateImGuiImpl() = 0;
 
     protected:
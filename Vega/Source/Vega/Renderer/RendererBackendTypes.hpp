@@ -2,6 +2,10 @@
 
 #include "Vega/Core/Base.hpp"
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace Vega
 {
 
@@ -19,4 +23,49 @@ namespace Vega
 
     }    // namespace RendererBackendConfig
 
+    enum class RendererMemoryCategory : uint8_t
+    {
+        kRenderBuffer = 0U,
+        kTexture,
+        kFrameBuffer,
+        kInternal,    // Staging, uniform rings and other backend owned memory
+    };
+
+    struct RendererMemoryAllocationStats
+    {
+        std::string Name;
+        RendererMemoryCategory Category;
+        uint64_t Size;
+        uint32_t HeapIndex;
+        bool IsDedicated;
+    };
+
+    struct RendererMemoryHeapStats
+    {
+        uint64_t Size = 0;
+        bool IsDeviceLocal = false;
+
+        // NOTE: Device memory objects created by the renderer and the part of it taken by live allocations
+        uint64_t AllocatedSize = 0;
+        uint64_t UsedSize = 0;
+
+        // NOTE: Process wide usage and budget reported by the driver, 0 if IsBudgetAvailable is false
+        uint64_t Usage = 0;
+        uint64_t Budget = 0;
+    };
+
+    struct RendererMemoryStats
+    {
+        std::vector<RendererMemoryHeapStats> Heaps;
+        std::vector<RendererMemoryAllocationStats> Allocations;
+        bool IsBudgetAvailable = false;
+    };
+
+    // NOTE: Binds and dynamic state set while recording the last frame, skipped ones were already set
+    struct RendererCommandStats
+    {
+        uint32_t IssuedStateCommands = 0;
+        uint32_t SkippedStateCommands = 0;
+    };
+
 }    // namespace Vega
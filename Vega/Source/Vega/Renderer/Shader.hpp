@@ -1,7 +1,9 @@
 #pragma once
 
+#include "RenderBuffer.hpp"
 #include "Vega/Core/Assert.hpp"
 
+#include <future>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -123,6 +125,9 @@ namespace Vega
         kPerDraw,
     };
 
+    // NOTE: Index of a uniform resolved by Shader::GetUniformHandle, only valid for the shader that returned it
+    using ShaderUniformHandle = uint32_t;
+
     struct ShaderUniform
     {
         std::string Name;
@@ -131,6 +136,30 @@ namespace Vega
         uint32_t ArrayLength;
     };
 
+    // NOTE: Preprocessor macro passed to every stage of the shader (#define Name Value)
+    struct ShaderDefine
+    {
+        std::string Name;
+        std::string Value = "";
+    };
+
+    // NOTE: Bit i enables ShaderConfig::Keywords[i]
+    using ShaderVariantMask = uint64_t;
+    static constexpr uint32_t kMaxShaderKeywords = 64;
+
+    /**
+     * @brief Feature switch of a shader, every combination of enabled keywords is a separate variant.
+     *
+     * Specialization constant keywords are declared in GLSL as layout(constant_id = N) const bool Name = false;
+     * and only specialize the pipelines of a variant. The other keywords are compiled in as #define Name 1, so
+     * every combination of them is compiled separately.
+     */
+    struct ShaderKeyword
+    {
+        std::string Name;
+        bool IsSpecializationConstant = false;
+    };
+
     struct ShaderConfig
     {
         std::string Name;
@@ -138,17 +167,21 @@ namespace Vega
         uint32_t MaxGroups = 512;
         uint32_t MaxDrawIds = 512;
 
-        std::vector<ShaderUniform> UniformsPerFrame = {};
-        std::vector<ShaderUniform> UniformsPerGroup = {};
-        std::vector<ShaderUniform> UniformsPerDraw = {};
-
         FaceCullMode CullMode = FaceCullMode::kBack;
         PrimitiveTopologyTypes TopologyTypes = PrimitiveTopologyTypeBits::kTriangleList;
 
         ShaderFlags Flags = ShaderFlagBits::kColorWrite;
 
+        // NOTE: Uniforms, storage buffers and vertex inputs are reflected from the compiled stages. Attributes only
+        //       overrides the formats of the vertex inputs in location order (e.g. normalized integers), leave it
+        //       empty to use the formats declared in the vertex stage
         std::vector<ShaderAttributeType> Attributes = {};
 
+        std::vector<ShaderDefine> Defines = {};
+
+        // NOTE: At most kMaxShaderKeywords, variants are requested with Shader::GetVariant
+        std::vector<ShaderKeyword> Keywords = {};
+
         uint32_t GetAttibutesStride() const
         {
             return std::accumulate(
@@ -202,9 +235,20 @@ namespace Vega
         virtual void Create(const ShaderConfig& _ShaderConfig,
                             const std::initializer_list<ShaderStageConfig>& _ShaderStageConfigs) = 0;
 
-        virtual void Initialize() = 0;
+        /**
+         * @brief Starts building the shader stages and pipelines.
+         *
+         * The build runs asynchronously, Bind() fails until it is finished.
+         *
+         * @return std::shared_future<bool> Ready once the build is finished, false if it failed.
+         */
+        virtual std::shared_future<bool> Initialize() = 0;
         virtual void Shutdown() = 0;
 
+        // NOTE: True once the shader has usable pipelines
+        virtual bool IsReady() = 0;
+
+        // NOTE: False if the shader is not ready yet, nothing may be drawn with it then
         virtual bool Bind() = 0;
 
         template <typename T>
@@ -213,9 +257,48 @@ namespace Vega
             SetUniformBufferData(_Name, &_Data, sizeof(T), _Frequency);
         }
 
+        // NOTE: _Name is qualified by the block name as declared in GLSL (e.g. "perDrawUbo.model")
         virtual void SetUniformBufferData(std::string_view _Name, const void* _Data, size_t _Size,
                                           ShaderUpdateFrequency _Frequency) = 0;
 
+        /**
+         * @brief Resolves a uniform name ("Block.member") to a handle for SetUniform().
+         *
+         * The handle keeps the offset, size and update frequency of the uniform, so setting it does no name lookup.
+         * It can be requested before the shader is ready and follows the uniform across reloads, uniforms the
+         * applied build does not declare are skipped by SetUniform().
+         */
+        virtual ShaderUniformHandle GetUniformHandle(std::string_view _Name) = 0;
+
+        // NOTE: Unknown keywords are logged and ignored
+        virtual ShaderVariantMask GetVariantMask(std::initializer_list<std::string_view> _Keywords) const = 0;
+
+        /**
+         * @brief Returns the variant of the shader with the keywords of _Mask enabled.
+         *
+         * Variants are built asynchronously on the first request and cached by mask, Bind() of a variant fails
+         * until its build is finished. The variant is owned by this shader and valid until its Shutdown(). Mask 0
+         * is the shader itself.
+         */
+        virtual Shader* GetVariant(ShaderVariantMask _Mask) = 0;
+
+        template <typename T>
+        void SetUniform(ShaderUniformHandle _Handle, const T& _Data)
+        {
+            SetUniform(_Handle, &_Data, sizeof(T));
+        }
+
+        virtual void SetUniform(ShaderUniformHandle _Handle, const void* _Data, size_t _Size) = 0;
+
+        /**
+         * @brief Binds a range of a storage RenderBuffer to the storage buffer _Name.
+         *
+         * The binding is kept until it is replaced and applied on the next Bind(). _Size of 0 binds the whole
+         * buffer starting at _Offset.
+         */
+        virtual void SetStorageBuffer(std::string_view _Name, const Ref<RenderBuffer>& _RenderBuffer,
+                                      size_t _Offset = 0, size_t _Size = 0) = 0;
+
     protected:
     };
 
@@ -78,6 +78,8 @@ namespace Vega
     class Texture
     {
     public:
+        static constexpr uint32_t kInvalidBindlessIndex = UINT32_MAX;
+
         Texture() = default;
         virtual ~Texture() = default;
 
@@ -94,6 +96,15 @@ namespace Vega
         virtual uint32_t GetHeight() const = 0;
         virtual uint32_t GetMipLevels() const = 0;
         virtual uint32_t GetArraySize() const = 0;
+
+        /**
+         * @brief Slot of the texture in the renderer wide texture array.
+         *
+         * Shaders sample any registered texture through its index, passed per draw or per instance.
+         *
+         * @return uint32_t kInvalidBindlessIndex if the texture is not sampled or bindless textures are unsupported.
+         */
+        virtual uint32_t GetBindlessIndex() const = 0;
     };
 
 }    // namespace Vega
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Vega::Components
+{
+
+    // NOTE: The camera looks along -Z of the entity transform, the first primary camera in the scene is used for
+    //       rendering
+    struct CameraComponent
+    {
+        float VerticalFov = glm::radians(60.0f);
+        float AspectRatio = 16.0f / 9.0f;
+        float NearClip = 0.1f;
+        float FarClip = 1000.0f;
+        bool IsPrimary = true;
+
+        glm::mat4 GetProjectionMatrix() const
+        {
+            // NOTE: Vulkan clip space depth range, Y is flipped by the viewport
+            return glm::perspectiveRH_ZO(VerticalFov, AspectRatio, NearClip, FarClip);
+        }
+    };
+
+}    // namespace Vega::Components
@@ -5,6 +5,8 @@
 namespace Vega::Components
 {
 
+    // NOTE: Mesh is acquired in StaticMeshManager on construction and released on destruction, so MeshName must not
+    //       be changed in place (replace the component instead)
     struct StaticMeshComponent
     {
         std::string MeshName;
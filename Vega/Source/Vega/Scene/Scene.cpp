@@ -2,8 +2,11 @@
 
 #include "Components/HierarchyComponent.hpp"
 #include "Components/NameComponent.hpp"
+#include "Components/StaticMeshComponent.hpp"
 #include "Components/TransformComponent.hpp"
+#include "Vega/Core/Application.hpp"
 #include "Vega/Core/Assert.hpp"
+#include "Vega/Managers/StaticMeshManager.hpp"
 
 #include "entt/entity/fwd.hpp"
 
@@ -49,6 +52,32 @@ namespace Vega
         }
     }
 
+    static Ref<StaticMeshManager> GetStaticMeshManager()
+    {
+        Application& application = Application::Get();
+        if (!application.IsHasManager("StaticMeshManager"))
+        {
+            return nullptr;
+        }
+        return StaticRefCast<StaticMeshManager>(application.GetManager("StaticMeshManager"));
+    }
+
+    void OnStaticMeshConstruct(entt::registry& _Registry, entt::entity _Entity)
+    {
+        if (Ref<StaticMeshManager> staticMeshManager = GetStaticMeshManager())
+        {
+            staticMeshManager->AcquireMesh(_Registry.get<Components::StaticMeshComponent>(_Entity).MeshName);
+        }
+    }
+
+    void OnStaticMeshDestroy(entt::registry& _Registry, entt::entity _Entity)
+    {
+        if (Ref<StaticMeshManager> staticMeshManager = GetStaticMeshManager())
+        {
+            staticMeshManager->ReleaseMesh(_Registry.get<Components::StaticMeshComponent>(_Entity).MeshName);
+        }
+    }
+
     const Components::TransformComponent& Entity::GetTransform()
     {
         VEGA_CORE_ASSERT(HasComponent<Components::TransformComponent>(), "Entity does not have Transform component!");
@@ -92,10 +121,15 @@ namespace Vega
     Scene::Scene()
     {
         m_Registry.on_construct<Components::TransformComponent>().connect<OnTransformConstructOrUpdate>();
+        m_Registry.on_construct<Components::StaticMeshComponent>().connect<OnStaticMeshConstruct>();
+        m_Registry.on_destroy<Components::StaticMeshComponent>().connect<OnStaticMeshDestroy>();
     }
 
     Scene::~Scene()
     {
+        // NOTE: Registry destruction does not emit on_destroy, clear explicitly to release meshes
+        m_Registry.clear<Components::StaticMeshComponent>();
+
         for (auto& sceneSystem : m_SceneSystems)
         {
             sceneSystem->Destroy();
@@ -2,6 +2,7 @@
 #include "Vega/Core/Application.hpp"
 
 #include "Vega/Managers/StaticMeshManager.hpp"
+#include "Vega/Scene/Components/CameraComponent.hpp"
 #include "Vega/Scene/Components/StaticMeshComponent.hpp"
 #include "Vega/Scene/Scene.hpp"
 
@@ -10,10 +11,11 @@ namespace Vega::SceneSystems
 
     SceneSystemStaticMeshDraw::SceneSystemStaticMeshDraw()
     {
-        m_Shader = Application::Get().GetRendererBackend()->CreateShader(
+        Ref<RendererBackend> rendererBackend = Application::Get().GetRendererBackend();
+
+        m_Shader = rendererBackend->CreateShader(
             ShaderConfig {
                 .Name = "EditorLayerTestShader",
-                .Attributes = { ShaderAttributeType::kFloat3 },
         },
             { ShaderStageConfig {
                   .Type = ShaderStageConfig::ShaderStageType::kVertex,
@@ -23,30 +25,104 @@ namespace Vega::SceneSystems
                   .Type = ShaderStageConfig::ShaderStageType::kFragment,
                   .Path = "Assets/Shaders/Source/test.frag",
               } });
+        // NOTE: test.vert applies "model" as the whole clip space transform
+        m_ModelViewProjectionUniform = m_Shader->GetUniformHandle("perDrawUbo.model");
+
+        // NOTE: Ranges are freed right after recording, RenderBuffer reuses them once the GPU finished the frame
+        m_IndirectCommandBuffer = rendererBackend->CreateRenderBuffer(RenderBufferProps {
+            .Name = "SceneSystemStaticMeshDraw_IndirectCommandBuffer",
+            .Type = RenderBufferType::kStorageHostVisible,
+            .ElementSize = sizeof(StaticMeshDrawIndexedCommand),
+            .ElementCount = kMaxDrawCommandCount * 4,    // NOTE: Room for the frames in flight
+            .AllocatorType = RenderBufferAllocatorType::kFreeList,
+        });
     }
 
-    void SceneSystemStaticMeshDraw::Destroy() { m_Shader->Shutdown(); }
+    void SceneSystemStaticMeshDraw::Destroy()
+    {
+        m_IndirectCommandBuffer->Destroy();
+        m_Shader->Shutdown();
+    }
 
     void SceneSystemStaticMeshDraw::OnUpdate(Scene* _Scene) { }
 
     void SceneSystemStaticMeshDraw::OnRender(Scene* _Scene)
     {
-        m_Shader->Bind();
+        if (!m_Shader->Bind())
+        {
+            return;
+        }
 
         Ref<RendererBackend> rendererBackend = Application::Get().GetRendererBackend();
         Ref<StaticMeshManager> staticMeshManager =
             StaticRefCast<StaticMeshManager>(Application::Get().GetManager("StaticMeshManager"));
 
-        _Scene->GetRegistry().view<Components::StaticMeshComponent, Components::TransformComponent>().each(
+        entt::registry& registry = _Scene->GetRegistry();
+
+        // NOTE: Without a camera meshes are drawn in clip space and cone culling is disabled
+        glm::mat4 viewProjection(1.0f);
+        glm::vec3 cameraPosition(0.0f);
+        bool hasCamera = false;
+        for (auto [entity, cameraComp, transformComp] :
+             registry.view<Components::CameraComponent, Components::TransformComponent>().each())
+        {
+            if (cameraComp.IsPrimary)
+            {
+                glm::mat4 cameraTransform = transformComp.GetTransformMatrix();
+                viewProjection = cameraComp.GetProjectionMatrix() * glm::inverse(cameraTransform);
+                cameraPosition = glm::vec3(cameraTransform[3]);
+                hasCamera = true;
+                break;
+            }
+        }
+
+        m_DrawCommands.clear();
+        m_MeshDraws.clear();
+        registry.view<Components::StaticMeshComponent, Components::TransformComponent>().each(
             [&](auto entity, const Components::StaticMeshComponent& meshComp,
                 const Components::TransformComponent& transformComp) {
-                // TODO: Continue implementation
-                // Need to get StaticMeshManager from Application
-                m_Shader->SetUniformBufferData("perDrawUbo.model", transformComp.GetTransformMatrix(),
-                                               ShaderUpdateFrequency::kPerDraw);
-                staticMeshManager->BindMesh(meshComp.MeshName);
-                rendererBackend->TestFoo();
+                glm::mat4 transform = transformComp.GetTransformMatrix();
+
+                StaticMeshCullParams cullParams = {
+                    .ModelViewProjection = viewProjection * transform,
+                    .CameraPosition = hasCamera ? glm::vec3(glm::inverse(transform) * glm::vec4(cameraPosition, 1.0f))
+                                                : glm::vec3(0.0f),
+                    .IsConeCullingEnabled = hasCamera,
+                };
+                size_t firstCommand = m_DrawCommands.size();
+                size_t commandCount = staticMeshManager->CullMesh(meshComp.MeshName, cullParams, m_DrawCommands);
+                if (commandCount > 0)
+                {
+                    m_MeshDraws.push_back(MeshDraw {
+                        .MeshName = meshComp.MeshName,
+                        .ModelViewProjection = cullParams.ModelViewProjection,
+                        .FirstCommand = firstCommand,
+                        .CommandCount = commandCount,
+                    });
+                }
             });
+
+        if (m_DrawCommands.empty())
+        {
+            return;
+        }
+
+        VEGA_CORE_ASSERT(m_DrawCommands.size() <= kMaxDrawCommandCount,
+                         "SceneSystemStaticMeshDraw::OnRender: Too many draw commands!");
+        size_t commandsSize = m_DrawCommands.size() * sizeof(StaticMeshDrawIndexedCommand);
+        size_t commandsOffset = m_IndirectCommandBuffer->LoadRange(commandsSize, m_DrawCommands.data(), true);
+
+        for (const MeshDraw& meshDraw : m_MeshDraws)
+        {
+            m_Shader->SetUniform(m_ModelViewProjectionUniform, meshDraw.ModelViewProjection);
+            staticMeshManager->BindMesh(meshDraw.MeshName);
+            rendererBackend->DrawIndexedIndirect(m_IndirectCommandBuffer,
+                                                 commandsOffset + meshDraw.FirstCommand *
+                                                                      sizeof(StaticMeshDrawIndexedCommand),
+                                                 static_cast<uint32_t>(meshDraw.CommandCount));
+        }
+
+        m_IndirectCommandBuffer->FreeRange(commandsOffset, commandsSize);
     }
 
 }    // namespace Vega::SceneSystems
@@ -2,8 +2,15 @@
 
 #include "SceneSystem.hpp"
 
+#include "Vega/Managers/StaticMeshManager.hpp"
+#include "Vega/Renderer/RenderBuffer.hpp"
 #include "Vega/Renderer/Shader.hpp"
 
+#include "glm/ext/matrix_float4x4.hpp"
+
+#include <string_view>
+#include <vector>
+
 namespace Vega::SceneSystems
 {
 
@@ -19,8 +26,27 @@ namespace Vega::SceneSystems
 
         virtual void OnRender(Scene* _Scene) override;
 
+        // NOTE: Maximum number of indirect draw commands per frame
+        static constexpr size_t kMaxDrawCommandCount = 64 * 1024;
+
+    protected:
+        // NOTE: Range of m_DrawCommands emitted for one mesh instance
+        struct MeshDraw
+        {
+            std::string_view MeshName;
+            glm::mat4 ModelViewProjection;
+            size_t FirstCommand;
+            size_t CommandCount;
+        };
+
     protected:
         Ref<Shader> m_Shader;
+        ShaderUniformHandle m_ModelViewProjectionUniform;
+
+        // NOTE: Culled commands of all meshes are uploaded once per frame and drawn with one indirect draw per mesh
+        Ref<RenderBuffer> m_IndirectCommandBuffer;
+        std::vector<StaticMeshDrawIndexedCommand> m_DrawCommands;
+        std::vector<MeshDraw> m_MeshDraws;
     };
 
 }    // namespace Vega::SceneSystems
@@ -0,0 +1,158 @@
+#include "FileWatcher.hpp"
+
+#include "Vega/Utils/Log.hpp"
+
+namespace Vega
+{
+
+    FileWatcher::FileWatcher()
+    {
+        if (!InitPlatform())
+        {
+            VEGA_CORE_ERROR("FileWatcher: Failed to initialize, file changes are not reported");
+            return;
+        }
+
+        m_Thread = std::thread(&FileWatcher::WatchLoop, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        m_IsStopping = true;
+        if (m_Thread.joinable())
+        {
+            m_Thread.join();
+        }
+
+        ShutdownPlatform();
+    }
+
+    void FileWatcher::AddFile(const std::filesystem::path& _Path)
+    {
+        std::filesystem::path path = NormalizePath(_Path);
+
+        std::lock_guard lock(m_Mutex);
+        if (m_FileRefCounts[path.string()]++ == 0)
+        {
+            AddPlatformWatch(path);
+        }
+    }
+
+    void FileWatcher::RemoveFile(const std::filesystem::path& _Path)
+    {
+        std::string path = NormalizePath(_Path).string();
+
+        std::lock_guard lock(m_Mutex);
+        auto fileIt = m_FileRefCounts.find(path);
+        if (fileIt == m_FileRefCounts.end())
+        {
+            return;
+        }
+
+        // NOTE: Directory watches are kept, events for files that are no longer watched are ignored
+        if (--fileIt->second == 0)
+        {
+            m_FileRefCounts.erase(fileIt);
+            m_ChangedFiles.erase(path);
+#ifndef VEGA_PLATFORM_LINUX
+            m_WriteTimes.erase(path);
+#endif
+        }
+    }
+
+    bool FileWatcher::PollChangedFiles(std::vector<std::filesystem::path>& _OutChangedFiles)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        size_t changedFileCount = _OutChangedFiles.size();
+
+        std::lock_guard lock(m_Mutex);
+        for (auto fileIt = m_ChangedFiles.begin(); fileIt != m_ChangedFiles.end();)
+        {
+            if (now - fileIt->second < kSettleTime)
+            {
+                ++fileIt;
+                continue;
+            }
+
+            _OutChangedFiles.emplace_back(fileIt->first);
+            fileIt = m_ChangedFiles.erase(fileIt);
+        }
+
+        return _OutChangedFiles.size() != changedFileCount;
+    }
+
+    std::filesystem::path FileWatcher::NormalizePath(const std::filesystem::path& _Path)
+    {
+        std::error_code errorCode;
+        std::filesystem::path absolutePath = std::filesystem::absolute(_Path, errorCode);
+        return (errorCode ? _Path : absolutePath).lexically_normal();
+    }
+
+    void FileWatcher::NotifyFileChanged(const std::filesystem::path& _Path)
+    {
+        std::string path = _Path.string();
+        if (m_FileRefCounts.contains(path))
+        {
+            m_ChangedFiles[path] = std::chrono::steady_clock::now();
+        }
+    }
+
+#ifndef VEGA_PLATFORM_LINUX
+
+    // NOTE: Fallback for platforms without a native watcher implementation
+    static constexpr std::chrono::milliseconds kWriteTimePollInterval = std::chrono::milliseconds(250);
+
+    bool FileWatcher::InitPlatform() { return true; }
+
+    void FileWatcher::ShutdownPlatform() { m_WriteTimes.clear(); }
+
+    void FileWatcher::AddPlatformWatch(const std::filesystem::path& _Path)
+    {
+        std::error_code errorCode;
+        m_WriteTimes[_Path.string()] = std::filesystem::last_write_time(_Path, errorCode);
+    }
+
+    void FileWatcher::WatchLoop()
+    {
+        std::vector<std::string> paths;
+        std::vector<std::filesystem::file_time_type> writeTimes;
+
+        while (!m_IsStopping)
+        {
+            std::this_thread::sleep_for(kWriteTimePollInterval);
+
+            paths.clear();
+            {
+                std::lock_guard lock(m_Mutex);
+                for (const auto& [path, writeTime] : m_WriteTimes)
+                {
+                    paths.push_back(path);
+                }
+            }
+
+            // NOTE: File system queries run without the lock
+            writeTimes.resize(paths.size());
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                std::error_code errorCode;
+                writeTimes[i] = std::filesystem::last_write_time(paths[i], errorCode);
+            }
+
+            std::lock_guard lock(m_Mutex);
+            for (size_t i = 0; i < paths.size(); ++i)
+            {
+                auto writeTimeIt = m_WriteTimes.find(paths[i]);
+                if (writeTimeIt == m_WriteTimes.end() || writeTimeIt->second == writeTimes[i])
+                {
+                    continue;
+                }
+
+                writeTimeIt->second = writeTimes[i];
+                NotifyFileChanged(paths[i]);
+            }
+        }
+    }
+
+#endif
+
+}    // namespace Vega
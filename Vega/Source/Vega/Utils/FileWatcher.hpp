@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Platform/Platform.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Vega
+{
+
+    /**
+     * @brief Watches files for changes on a background thread.
+     *
+     * Uses inotify on Linux and polls modification times on other platforms. On Linux the directories of the files
+     * are watched, so files replaced through a rename (as most editors save) are reported too. A change is reported
+     * once the file was quiet for kSettleTime, a save written in several chunks is reported once.
+     */
+    class FileWatcher
+    {
+    public:
+        static constexpr std::chrono::milliseconds kSettleTime = std::chrono::milliseconds(100);
+
+        FileWatcher();
+        ~FileWatcher();
+
+        // NOTE: Files are reference counted, every AddFile needs a matching RemoveFile
+        void AddFile(const std::filesystem::path& _Path);
+        void RemoveFile(const std::filesystem::path& _Path);
+
+        /**
+         * @brief Takes the files changed since the last call.
+         *
+         * Never waits for the watcher thread longer than a short lock.
+         *
+         * @return bool False if no watched file has changed.
+         */
+        bool PollChangedFiles(std::vector<std::filesystem::path>& _OutChangedFiles);
+
+        // NOTE: Absolute lexically normal path, used as the key of watched and reported files
+        static std::filesystem::path NormalizePath(const std::filesystem::path& _Path);
+
+    protected:
+        // NOTE: Implemented per platform, m_Mutex is locked while AddPlatformWatch is called
+        bool InitPlatform();
+        void ShutdownPlatform();
+        void AddPlatformWatch(const std::filesystem::path& _Path);
+        void WatchLoop();
+
+        // NOTE: m_Mutex must be locked
+        void NotifyFileChanged(const std::filesystem::path& _Path);
+
+    protected:
+        std::thread m_Thread;
+        std::atomic<bool> m_IsStopping = false;
+
+        std::mutex m_Mutex;
+        std::unordered_map<std::string, uint32_t> m_FileRefCounts;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_ChangedFiles;
+
+#ifdef VEGA_PLATFORM_LINUX
+        int m_InotifyFd = -1;
+        std::unordered_map<int, std::filesystem::path> m_WatchDirectories;
+        std::unordered_set<std::string> m_WatchDirectoryPaths;
+#else
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_WriteTimes;
+#endif
+    };
+
+}    // namespace Vega
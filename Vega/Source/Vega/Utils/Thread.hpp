@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+namespace Vega
+{
+
+    /**
+     * @brief Number of background workers that leaves one hardware thread for the main thread.
+     *
+     * std::thread::hardware_concurrency() returns 0 if the value is not computable, at least one worker is used then.
+     */
+    inline uint32_t GetDefaultWorkerThreadCount()
+    {
+        uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+        return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1;
+    }
+
+}    // namespace Vega
@@ -59,6 +59,7 @@ namespace Vega
             .DescriptorPool = rendererBackend->GetImGuiDescriptorPool(),
             .MinImageCount = swapchainSupportInfo.Capabilities.minImageCount,
             .ImageCount = static_cast<uint32_t>(vkSwapchain.GetImagesCount()),
+            .PipelineCache = rendererBackend->GetVkPipelineCache(),
             .PipelineInfoMain = {
                 .MSAASamples = VK_SAMPLE_COUNT_1_BIT,
                 .PipelineRenderingCreateInfo = pipelineRenderingCreateInfo,
@@ -102,6 +103,10 @@ namespace Vega
 
         ImGui_ImplVulkan_RenderDrawData(mainDrawData, commandBuffer);
 
+        // NOTE: The ImGui backend binds its own pipeline, buffers and descriptor sets
+        rendererBackend->GetCurrentCommandState().Invalidate();
+        rendererBackend->SetBoundShader(nullptr);
+
         rendererBackend->VulkanEndRendering();
         // }
     }
@@ -31,8 +31,6 @@ namespace Vega
 
         PFN_vkCmdBeginRenderingKHR VkCmdBeginRenderingKHR;
         PFN_vkCmdEndRenderingKHR VkCmdEndRenderingKHR;
-
-        shaderc_compiler* ShaderCompiler;
     };
 
     typedef uint32_t VulkanDeviceSupportFlags;
@@ -45,7 +43,9 @@ namespace Vega
             kNoneBit = 0x00,
             kNativeDynamicStateBit = 0x01,
             kDynamicStateBit = 0x02,
-            kLineSmoothRasterizationBit = 0x04
+            kLineSmoothRasterizationBit = 0x04,
+            kMemoryBudgetBit = 0x08,
+            kBindlessTexturesBit = 0x10,
         };
 
     }    // namespace VulkanDeviceSupportFlagBits
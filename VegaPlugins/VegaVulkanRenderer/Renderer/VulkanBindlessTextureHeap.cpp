@@ -0,0 +1,237 @@
+#include "VulkanBindlessTextureHeap.hpp"
+
+#include "Vega/Renderer/Texture.hpp"
+#include "Vega/Utils/Log.hpp"
+
+#include "Utils/VulkanUtils.hpp"
+#include "VulkanRendererBackend.hpp"
+
+#include <algorithm>
+
+namespace Vega
+{
+
+    void VulkanBindlessTextureHeap::Create()
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+        const VulkanContext& context = rendererBackend->GetVkContext();
+        VkDevice logicalDevice = deviceWrapper.GetLogicalDevice();
+
+        if (!(deviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kBindlessTexturesBit))
+        {
+            VEGA_CORE_WARN("Bindless textures are not supported, textures have no bindless index");
+            return;
+        }
+
+        m_Capacity = std::min(kMaxTextureCount, deviceWrapper.GetMaxBindlessTextureCount());
+
+        VkResult createLayoutResult = CreateDescriptorSetLayout(m_DescriptorSetLayout);
+        if (!VulkanResultIsSuccess(createLayoutResult))
+        {
+            VEGA_CORE_CRITICAL("Failed to create bindless texture set layout: {}",
+                               VulkanResultString(createLayoutResult, true));
+            m_DescriptorSetLayout = VK_NULL_HANDLE;
+            return;
+        }
+
+        VkDescriptorPoolSize poolSize = {
+            .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = m_Capacity,
+        };
+        VkDescriptorPoolCreateInfo poolInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+            .maxSets = 1,
+            .poolSizeCount = 1,
+            .pPoolSizes = &poolSize,
+        };
+        VK_CHECK(vkCreateDescriptorPool(logicalDevice, &poolInfo, context.VkAllocator, &m_DescriptorPool));
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_DESCRIPTOR_POOL,
+                                 m_DescriptorPool, "bindless_texture_descriptor_pool");
+
+        VkDescriptorSetAllocateInfo allocateInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorPool = m_DescriptorPool,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &m_DescriptorSetLayout,
+        };
+        VK_CHECK(vkAllocateDescriptorSets(logicalDevice, &allocateInfo, &m_DescriptorSet));
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_DESCRIPTOR_SET,
+                                 m_DescriptorSet, "bindless_texture_descriptor_set");
+
+        const VkPhysicalDeviceFeatures& features = deviceWrapper.GetPhysicalDeviceFeatures();
+        VkSamplerCreateInfo samplerInfo = {
+            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+            .magFilter = VK_FILTER_LINEAR,
+            .minFilter = VK_FILTER_LINEAR,
+            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+            .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            .anisotropyEnable = features.samplerAnisotropy,
+            .maxAnisotropy = features.samplerAnisotropy
+                                 ? deviceWrapper.GetPhysicalDeviceProperties().limits.maxSamplerAnisotropy
+                                 : 1.0f,
+            .minLod = 0.0f,
+            .maxLod = VK_LOD_CLAMP_NONE,
+        };
+        VK_CHECK(vkCreateSampler(logicalDevice, &samplerInfo, context.VkAllocator, &m_DefaultSampler));
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_SAMPLER,
+                                 m_DefaultSampler, "bindless_texture_default_sampler");
+
+        VEGA_CORE_INFO("Bindless texture heap created with {} slots", m_Capacity);
+    }
+
+    void VulkanBindlessTextureHeap::Destroy()
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
+        const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_UsedSlotCount > m_FreeSlots.size() + m_RetiredSlots.size())
+        {
+            VEGA_CORE_WARN("{} textures were not unregistered from the bindless heap before shutdown",
+                           m_UsedSlotCount - m_FreeSlots.size() - m_RetiredSlots.size());
+        }
+
+        // NOTE: The set is freed together with the pool
+        vkDestroyDescriptorPool(logicalDevice, m_DescriptorPool, vkAllocator);
+        vkDestroyDescriptorSetLayout(logicalDevice, m_DescriptorSetLayout, vkAllocator);
+        vkDestroySampler(logicalDevice, m_DefaultSampler, vkAllocator);
+        m_DescriptorPool = VK_NULL_HANDLE;
+        m_DescriptorSetLayout = VK_NULL_HANDLE;
+        m_DescriptorSet = VK_NULL_HANDLE;
+        m_DefaultSampler = VK_NULL_HANDLE;
+
+        m_Capacity = 0;
+        m_UsedSlotCount = 0;
+        m_FreeSlots.clear();
+        m_RetiredSlots.clear();
+    }
+
+    VkResult VulkanBindlessTextureHeap::CreateDescriptorSetLayout(VkDescriptorSetLayout& _OutLayout) const
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+
+        VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                                VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            .bindingCount = 1,
+            .pBindingFlags = &bindingFlags,
+        };
+        VkDescriptorSetLayoutBinding binding = {
+            .binding = kBinding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = m_Capacity,
+            .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
+        };
+        VkDescriptorSetLayoutCreateInfo layoutInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .pNext = &bindingFlagsInfo,
+            .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+            .bindingCount = 1,
+            .pBindings = &binding,
+        };
+
+        return vkCreateDescriptorSetLayout(rendererBackend->GetVkDeviceWrapper().GetLogicalDevice(), &layoutInfo,
+                                           rendererBackend->GetVkContext().VkAllocator, &_OutLayout);
+    }
+
+    uint32_t VulkanBindlessTextureHeap::Register(VkImageView _ImageView, VkSampler _Sampler)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!IsCreated())
+        {
+            return Texture::kInvalidBindlessIndex;
+        }
+
+        uint32_t index;
+        if (!m_FreeSlots.empty())
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else if (m_UsedSlotCount < m_Capacity)
+        {
+            index = m_UsedSlotCount++;
+        }
+        else
+        {
+            VEGA_CORE_ERROR("Bindless texture heap is full ({} slots)", m_Capacity);
+            return Texture::kInvalidBindlessIndex;
+        }
+
+        WriteDescriptor(index, _ImageView, _Sampler);
+        return index;
+    }
+
+    void VulkanBindlessTextureHeap::Update(uint32_t _Index, VkImageView _ImageView, VkSampler _Sampler)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        VEGA_CORE_ASSERT(_Index < m_UsedSlotCount, "Updated bindless texture slot is not registered!");
+        WriteDescriptor(_Index, _ImageView, _Sampler);
+    }
+
+    void VulkanBindlessTextureHeap::Unregister(uint32_t _Index)
+    {
+        uint64_t timelineValue = VulkanRendererBackend::GetVkRendererBackend()->GetCurrentFrameNumber();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!IsCreated())
+        {
+            return;
+        }
+        VEGA_CORE_ASSERT(_Index < m_UsedSlotCount, "Unregistered bindless texture slot is not registered!");
+
+        // NOTE: The stale descriptor is left in place, partially bound slots are never read by valid draws
+        m_RetiredSlots.emplace_back(RetiredSlot { .Index = _Index, .TimelineValue = timelineValue });
+    }
+
+    void VulkanBindlessTextureHeap::Reclaim(uint64_t _CompletedTimelineValue)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        std::erase_if(m_RetiredSlots, [&](const RetiredSlot& _Slot) {
+            if (_Slot.TimelineValue > _CompletedTimelineValue)
+            {
+                return false;
+            }
+            m_FreeSlots.push_back(_Slot.Index);
+            return true;
+        });
+    }
+
+    uint32_t VulkanBindlessTextureHeap::GetTextureCount()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_UsedSlotCount - static_cast<uint32_t>(m_FreeSlots.size() + m_RetiredSlots.size());
+    }
+
+    void VulkanBindlessTextureHeap::WriteDescriptor(uint32_t _Index, VkImageView _ImageView, VkSampler _Sampler)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+
+        VkDescriptorImageInfo imageInfo = {
+            .sampler = _Sampler != VK_NULL_HANDLE ? _Sampler : m_DefaultSampler,
+            .imageView = _ImageView,
+            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        };
+        VkWriteDescriptorSet descriptorWrite = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = m_DescriptorSet,
+            .dstBinding = kBinding,
+            .dstArrayElement = _Index,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .pImageInfo = &imageInfo,
+        };
+
+        // NOTE: Update after bind allows writing slots while recorded command buffers use the set
+        vkUpdateDescriptorSets(rendererBackend->GetVkDeviceWrapper().GetLogicalDevice(), 1, &descriptorWrite, 0,
+                               nullptr);
+    }
+
+}    // namespace Vega
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Vega
+{
+
+    /**
+     * @brief VulkanBindlessTextureHeap class
+     *
+     * Renderer wide update after bind array of combined image samplers. Every sampled texture registers into a
+     * stable slot, shaders declare the array at set 3 binding 0 and index it with an id passed per draw (push
+     * constants) or per instance (storage buffers), so draws that use different textures share one descriptor set.
+     */
+    class VulkanBindlessTextureHeap
+    {
+    public:
+        static constexpr uint32_t kDescriptorSetIndex = 3;
+        static constexpr uint32_t kBinding = 0;
+        static constexpr uint32_t kMaxTextureCount = 16384;
+
+        // NOTE: The heap stays empty if the device does not support bindless textures
+        void Create();
+        void Destroy();
+
+        // NOTE: Every layout created here is compatible with the heap set, so shaders own their copy of it
+        VkResult CreateDescriptorSetLayout(VkDescriptorSetLayout& _OutLayout) const;
+
+        /**
+         * @brief Writes the view to a free slot, the slot index is stable until it is unregistered.
+         *
+         * Thread safe. The default sampler is used if _Sampler is VK_NULL_HANDLE.
+         *
+         * @return uint32_t Texture::kInvalidBindlessIndex if the heap is full or not created.
+         */
+        uint32_t Register(VkImageView _ImageView, VkSampler _Sampler);
+
+        // NOTE: Replaces the view of a registered slot, used when a texture recreates its image
+        void Update(uint32_t _Index, VkImageView _ImageView, VkSampler _Sampler);
+
+        // NOTE: Frames in flight may still sample the slot, so it is reused once the graphics timeline passes them
+        void Unregister(uint32_t _Index);
+
+        void Reclaim(uint64_t _CompletedTimelineValue);
+
+        inline bool IsCreated() const { return m_DescriptorSet != VK_NULL_HANDLE; }
+        inline VkDescriptorSet GetDescriptorSet() const { return m_DescriptorSet; }
+        inline uint32_t GetCapacity() const { return m_Capacity; }
+        uint32_t GetTextureCount();
+
+    protected:
+        struct RetiredSlot
+        {
+            uint32_t Index;
+            uint64_t TimelineValue;
+        };
+
+        void WriteDescriptor(uint32_t _Index, VkImageView _ImageView, VkSampler _Sampler);
+
+    protected:
+        std::mutex m_Mutex;
+
+        VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_DescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+        VkSampler m_DefaultSampler = VK_NULL_HANDLE;
+
+        uint32_t m_Capacity = 0;
+        // NOTE: Slots below are either registered, free or retired
+        uint32_t m_UsedSlotCount = 0;
+        std::vector<uint32_t> m_FreeSlots;
+        std::vector<RetiredSlot> m_RetiredSlots;
+    };
+
+}    // namespace Vega
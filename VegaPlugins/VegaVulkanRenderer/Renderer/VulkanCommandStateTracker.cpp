@@ -0,0 +1,82 @@
+#include "VulkanCommandStateTracker.hpp"
+
+namespace Vega
+{
+
+    void VulkanCommandStateTracker::Reset()
+    {
+        m_State = {};
+        m_IssuedCommandCount = 0;
+        m_SkippedCommandCount = 0;
+    }
+
+    void VulkanCommandStateTracker::Invalidate() { m_State = {}; }
+
+    bool VulkanCommandStateTracker::BindGraphicsPipeline(VkPipeline _Pipeline)
+    {
+        return Track(m_State.GraphicsPipeline, _Pipeline);
+    }
+
+    bool VulkanCommandStateTracker::BindVertexBuffer(VkBuffer _Buffer, VkDeviceSize _Offset)
+    {
+        return Track(m_State.VertexBuffer, VertexBufferState { .Buffer = _Buffer, .Offset = _Offset });
+    }
+
+    bool VulkanCommandStateTracker::BindIndexBuffer(VkBuffer _Buffer, VkDeviceSize _Offset, VkIndexType _IndexType)
+    {
+        return Track(m_State.IndexBuffer,
+                     IndexBufferState { .Buffer = _Buffer, .Offset = _Offset, .IndexType = _IndexType });
+    }
+
+    bool VulkanCommandStateTracker::SetPrimitiveTopology(VkPrimitiveTopology _Topology)
+    {
+        return Track(m_State.PrimitiveTopology, _Topology);
+    }
+
+    bool VulkanCommandStateTracker::SetFrontFace(VkFrontFace _FrontFace)
+    {
+        return Track(m_State.FrontFace, _FrontFace);
+    }
+
+    bool VulkanCommandStateTracker::SetStencilReference(uint32_t _StencilReference)
+    {
+        return Track(m_State.StencilReference, _StencilReference);
+    }
+
+    bool VulkanCommandStateTracker::SetStencilCompareMask(uint32_t _StencilCompareMask)
+    {
+        return Track(m_State.StencilCompareMask, _StencilCompareMask);
+    }
+
+    bool VulkanCommandStateTracker::SetStencilWriteMask(uint32_t _StencilWriteMask)
+    {
+        return Track(m_State.StencilWriteMask, _StencilWriteMask);
+    }
+
+    bool VulkanCommandStateTracker::SetStencilOp(VkStencilOp _FailOp, VkStencilOp _PassOp, VkStencilOp _DepthFailOp,
+                                                 VkCompareOp _CompareOp)
+    {
+        return Track(m_State.StencilOp, StencilOpState {
+                                            .FailOp = _FailOp,
+                                            .PassOp = _PassOp,
+                                            .DepthFailOp = _DepthFailOp,
+                                            .CompareOp = _CompareOp,
+                                        });
+    }
+
+    bool VulkanCommandStateTracker::SetStencilTestEnabled(bool _StencilTestEnabled)
+    {
+        return Track(m_State.StencilTestEnabled, _StencilTestEnabled);
+    }
+
+    bool VulkanCommandStateTracker::SetDepthTestEnabled(bool _DepthTestEnabled)
+    {
+        return Track(m_State.DepthTestEnabled, _DepthTestEnabled);
+    }
+
+    bool VulkanCommandStateTracker::SetDepthWriteEnabled(bool _DepthWriteEnabled)
+    {
+        return Track(m_State.DepthWriteEnabled, _DepthWriteEnabled);
+    }
+
+}    // namespace Vega
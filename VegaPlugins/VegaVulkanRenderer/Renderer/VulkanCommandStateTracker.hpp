@@ -0,0 +1,109 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+
+#include <cstdint>
+#include <optional>
+
+namespace Vega
+{
+
+    /**
+     * @brief VulkanCommandStateTracker class
+     *
+     * Mirrors the pipeline, vertex and index buffer and dynamic state recorded into one command buffer. Every
+     * function stores the new value and returns false if it is already set, the caller skips the command then.
+     * Consecutive draws mostly share pipeline and buffers, so most binds never reach the driver.
+     */
+    class VulkanCommandStateTracker
+    {
+    public:
+        // NOTE: State is undefined at the start of a command buffer, the counters restart with it
+        void Reset();
+
+        // NOTE: Commands recorded around the tracker (e.g. by the ImGui backend) may have changed any state
+        void Invalidate();
+
+        bool BindGraphicsPipeline(VkPipeline _Pipeline);
+        bool BindVertexBuffer(VkBuffer _Buffer, VkDeviceSize _Offset);
+        bool BindIndexBuffer(VkBuffer _Buffer, VkDeviceSize _Offset, VkIndexType _IndexType);
+
+        bool SetPrimitiveTopology(VkPrimitiveTopology _Topology);
+        bool SetFrontFace(VkFrontFace _FrontFace);
+        bool SetStencilReference(uint32_t _StencilReference);
+        bool SetStencilCompareMask(uint32_t _StencilCompareMask);
+        bool SetStencilWriteMask(uint32_t _StencilWriteMask);
+        bool SetStencilOp(VkStencilOp _FailOp, VkStencilOp _PassOp, VkStencilOp _DepthFailOp, VkCompareOp _CompareOp);
+        bool SetStencilTestEnabled(bool _StencilTestEnabled);
+        bool SetDepthTestEnabled(bool _DepthTestEnabled);
+        bool SetDepthWriteEnabled(bool _DepthWriteEnabled);
+
+        inline uint32_t GetIssuedCommandCount() const { return m_IssuedCommandCount; }
+        inline uint32_t GetSkippedCommandCount() const { return m_SkippedCommandCount; }
+
+    protected:
+        struct VertexBufferState
+        {
+            VkBuffer Buffer;
+            VkDeviceSize Offset;
+
+            bool operator==(const VertexBufferState&) const = default;
+        };
+
+        struct IndexBufferState
+        {
+            VkBuffer Buffer;
+            VkDeviceSize Offset;
+            VkIndexType IndexType;
+
+            bool operator==(const IndexBufferState&) const = default;
+        };
+
+        struct StencilOpState
+        {
+            VkStencilOp FailOp;
+            VkStencilOp PassOp;
+            VkStencilOp DepthFailOp;
+            VkCompareOp CompareOp;
+
+            bool operator==(const StencilOpState&) const = default;
+        };
+
+        // NOTE: Empty values are unknown, the next command is always recorded
+        struct State
+        {
+            std::optional<VkPipeline> GraphicsPipeline;
+            std::optional<VertexBufferState> VertexBuffer;
+            std::optional<IndexBufferState> IndexBuffer;
+            std::optional<VkPrimitiveTopology> PrimitiveTopology;
+            std::optional<VkFrontFace> FrontFace;
+            std::optional<uint32_t> StencilReference;
+            std::optional<uint32_t> StencilCompareMask;
+            std::optional<uint32_t> StencilWriteMask;
+            std::optional<StencilOpState> StencilOp;
+            std::optional<bool> StencilTestEnabled;
+            std::optional<bool> DepthTestEnabled;
+            std::optional<bool> DepthWriteEnabled;
+        };
+
+        template <typename T>
+        bool Track(std::optional<T>& _Current, const T& _Value)
+        {
+            if (_Current == _Value)
+            {
+                ++m_SkippedCommandCount;
+                return false;
+            }
+            _Current = _Value;
+            ++m_IssuedCommandCount;
+            return true;
+        }
+
+    protected:
+        State m_State;
+
+        uint32_t m_IssuedCommandCount = 0;
+        uint32_t m_SkippedCommandCount = 0;
+    };
+
+}    // namespace Vega
@@ -7,6 +7,7 @@
     #include "GLFW/glfw3.h"
 #endif
 
+#include <algorithm>
 #include <array>
 
 // TODO: use Aggregate with designated initializers for VK structs
@@ -42,6 +43,8 @@ namespace Vega
         VulkanPhysicalDeviceQueueFamilyInfo QueueFamilyInfo;
         VkPhysicalDeviceExtendedDynamicStateFeaturesEXT DynamicStateNext;
         VkPhysicalDeviceLineRasterizationFeaturesEXT SmoothLineNext;
+        VkPhysicalDeviceDescriptorIndexingFeatures DescriptorIndexingNext;
+        VkPhysicalDeviceDescriptorIndexingProperties DescriptorIndexingProperties;
         bool SupportsDeviceLocalHostVisible;
     };
 
@@ -123,11 +126,15 @@ namespace Vega
                                                           availableExtensions.data()));
             for (uint32_t i = 0; i < availableExtensionCount; ++i)
             {
-                if (std::string_view(availableExtensions[i].extensionName) == "VK_KHR_portability_subset"sv)
+                std::string_view extensionName = availableExtensions[i].extensionName;
+                if (extensionName == "VK_KHR_portability_subset"sv)
                 {
                     VEGA_CORE_INFO("Adding required extension 'VK_KHR_portability_subset'.");
                     portabilityRequired = true;
-                    break;
+                }
+                else if (extensionName == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)
+                {
+                    m_SupportFlags |= VulkanDeviceSupportFlagBits::kMemoryBudgetBit;
                 }
             }
         }
@@ -154,18 +161,34 @@ namespace Vega
             extensionNames.push_back(VK_EXT_LINE_RASTERIZATION_EXTENSION_NAME);
         }
 
+        if ((m_SupportFlags & VulkanDeviceSupportFlagBits::kMemoryBudgetBit))
+        {
+            extensionNames.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
+
         VkPhysicalDeviceFeatures2 deviceFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR };
         {    // TODO: remove scope???
             deviceFeatures.features.samplerAnisotropy = m_PhysicalDeviceFeatures.samplerAnisotropy;
             deviceFeatures.features.fillModeNonSolid = m_PhysicalDeviceFeatures.fillModeNonSolid;
+            deviceFeatures.features.multiDrawIndirect = m_PhysicalDeviceFeatures.multiDrawIndirect;
 
+            bool isBindlessSupported = m_SupportFlags & VulkanDeviceSupportFlagBits::kBindlessTexturesBit;
             VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT,
+                .shaderSampledImageArrayNonUniformIndexing = isBindlessSupported,
+                .descriptorBindingSampledImageUpdateAfterBind = isBindlessSupported,
+                .descriptorBindingUpdateUnusedWhilePending = isBindlessSupported,
                 .descriptorBindingPartiallyBound = VK_TRUE,    // TODO: Check if supported?
+                .runtimeDescriptorArray = isBindlessSupported,
+            };
+            VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+                .pNext = &descriptorIndexingFeatures,
+                .timelineSemaphore = VK_TRUE,
             };
             VkPhysicalDeviceSynchronization2Features sync2Features = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
-                .pNext = &descriptorIndexingFeatures,
+                .pNext = &timelineSemaphoreFeatures,
                 .synchronization2 = VK_TRUE,
             };
             VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extendedDynamicStateFeatures = {
@@ -276,8 +299,15 @@ namespace Vega
         VK_CHECK(vkCreateCommandPool(m_LogicalDevice, &poolCreateInfo, _Context.VkAllocator, &m_GraphicsCommandPool));
         VEGA_CORE_INFO("Graphics command pool created.");
 
+        poolCreateInfo.queueFamilyIndex = static_cast<uint32_t>(m_PhysicalDeviceQueueFamilyInfo.TransferQueueIndex);
+        VK_CHECK(vkCreateCommandPool(m_LogicalDevice, &poolCreateInfo, _Context.VkAllocator, &m_TransferCommandPool));
+        VEGA_CORE_INFO("Transfer command pool created ({} queue family).",
+                       IsTransferQueueFamilySeparate() ? "dedicated" : "graphics");
+
         DetectDepthFormat();
 
+        m_MemoryAllocator.Init(_Context, m_LogicalDevice, m_PhysicalDeviceMemoryProperties);
+
         return true;
     }
 
@@ -290,6 +320,10 @@ namespace Vega
 
         VEGA_CORE_INFO("Destroying command pools...");
         vkDestroyCommandPool(m_LogicalDevice, m_GraphicsCommandPool, _Context.VkAllocator);
+        vkDestroyCommandPool(m_LogicalDevice, m_TransferCommandPool, _Context.VkAllocator);
+
+        VEGA_CORE_INFO("Releasing device memory...");
+        m_MemoryAllocator.Shutdown(_Context);
 
         VEGA_CORE_INFO("Destroying logical device...");
         vkDestroyDevice(m_LogicalDevice, _Context.VkAllocator);
@@ -387,6 +421,22 @@ namespace Vega
         return 0;
     }
 
+    bool VulkanDeviceWrapper::QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& _OutBudget) const
+    {
+        if (!(m_SupportFlags & VulkanDeviceSupportFlagBits::kMemoryBudgetBit))
+        {
+            return false;
+        }
+
+        _OutBudget = { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT };
+        VkPhysicalDeviceMemoryProperties2 memoryProperties = {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+            .pNext = &_OutBudget,
+        };
+        vkGetPhysicalDeviceMemoryProperties2(m_PhysicalDevice, &memoryProperties);
+        return true;
+    }
+
     bool VulkanDeviceWrapper::SelectPhysicalDevice(VkInstance _VkInstance)
     {
         uint32_t physicalDeviceCount = 0;
@@ -417,8 +467,12 @@ namespace Vega
         VK_CHECK(vkEnumeratePhysicalDevices(_VkInstance, &physicalDeviceCount, physicalDevices.data()));
         for (size_t i = 0; i < physicalDevices.size(); ++i)
         {
+            VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES,
+            };
             VkPhysicalDeviceDriverProperties driverProperties = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES,
+                .pNext = &descriptorIndexingProperties,
             };
             VkPhysicalDeviceProperties2 properties2 = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
@@ -430,8 +484,16 @@ namespace Vega
             VkPhysicalDeviceFeatures features;
             vkGetPhysicalDeviceFeatures(physicalDevices[i], &features);
 
+            VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingNext = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES,
+            };
+            VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreNext = {
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+                .pNext = &descriptorIndexingNext,
+            };
             VkPhysicalDeviceLineRasterizationFeaturesEXT smoothLineNext = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_LINE_RASTERIZATION_FEATURES_EXT,
+                .pNext = &timelineSemaphoreNext,
             };
             VkPhysicalDeviceExtendedDynamicStateFeaturesEXT dynamicStateNext = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT,
@@ -448,6 +510,13 @@ namespace Vega
 
             VEGA_CORE_INFO("Evaluating device: {}, index {}.", properties.deviceName, i);
 
+            // NOTE: Transfer queue uploads are synchronized with the graphics queue through timeline semaphores
+            if (properties.apiVersion < VK_API_VERSION_1_2 || !timelineSemaphoreNext.timelineSemaphore)
+            {
+                VEGA_CORE_INFO("Device does not support timeline semaphores, skipping.");
+                continue;
+            }
+
             bool supportsDeviceLocalHostVisible = false;
             for (uint32_t j = 0; j < memory.memoryTypeCount; ++j)
             {
@@ -472,6 +541,8 @@ namespace Vega
                 bestDeviceInfo.QueueFamilyInfo = physicalDeviceMeetsRequirementsResult.QueueFamilyInfo;
                 bestDeviceInfo.DynamicStateNext = dynamicStateNext;
                 bestDeviceInfo.SmoothLineNext = smoothLineNext;
+                bestDeviceInfo.DescriptorIndexingNext = descriptorIndexingNext;
+                bestDeviceInfo.DescriptorIndexingProperties = descriptorIndexingProperties;
                 bestDeviceInfo.SupportsDeviceLocalHostVisible = supportsDeviceLocalHostVisible;
 
                 if (requirements.PrioritizeDiscreteGpu && properties.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
@@ -543,6 +614,26 @@ namespace Vega
             m_SupportFlags |= VulkanDeviceSupportFlagBits::kLineSmoothRasterizationBit;
         }
 
+        const VkPhysicalDeviceDescriptorIndexingFeatures& indexing = bestDeviceInfo.DescriptorIndexingNext;
+        if (indexing.runtimeDescriptorArray && indexing.descriptorBindingPartiallyBound &&
+            indexing.descriptorBindingUpdateUnusedWhilePending &&
+            indexing.descriptorBindingSampledImageUpdateAfterBind && indexing.shaderSampledImageArrayNonUniformIndexing)
+        {
+            // NOTE: Combined image samplers count against both the sampled image and the sampler limits
+            const VkPhysicalDeviceDescriptorIndexingProperties& limits = bestDeviceInfo.DescriptorIndexingProperties;
+            m_SupportFlags |= VulkanDeviceSupportFlagBits::kBindlessTexturesBit;
+            m_MaxBindlessTextureCount = std::min({
+                limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                limits.maxDescriptorSetUpdateAfterBindSamplers,
+                limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+            });
+        }
+        else
+        {
+            VEGA_CORE_INFO("Device does not support update after bind texture arrays, bindless textures disabled.");
+        }
+
         return true;
     }
 
@@ -589,6 +680,11 @@ namespace Vega
                     ++currentTransferScore;
                 }
             }
+            else if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            {
+                // NOTE: Other graphics families are not dedicated transfer families either
+                ++currentTransferScore;
+            }
 
             if (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT)
             {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VulkanBase.hpp"
+#include "VulkanMemoryAllocator.hpp"
 
 namespace Vega
 {
@@ -37,19 +38,53 @@ namespace Vega
         }
         inline VkQueue GetGraphicsQueue() const { return m_GraphicsQueue; }
         inline VkQueue GetPresentQueue() const { return m_PresentQueue; }
+        inline VkQueue GetTransferQueue() const { return m_TransferQueue; }
         inline VkFormat GetDepthFormat() const { return m_DepthFormat; }
         inline uint8_t GetDepthChannelCount() const { return m_DepthChannelCount; }
         inline VkCommandPool GetGraphicsCommandPool() const { return m_GraphicsCommandPool; }
+        inline VkCommandPool GetTransferCommandPool() const { return m_TransferCommandPool; }
+
+        // NOTE: Resources written on the transfer queue need queue family ownership transfer to graphics if true
+        inline bool IsTransferQueueFamilySeparate() const
+        {
+            return m_PhysicalDeviceQueueFamilyInfo.TransferQueueIndex !=
+                   m_PhysicalDeviceQueueFamilyInfo.GraphicsQueueIndex;
+        }
         inline const VkPhysicalDeviceFeatures& GetPhysicalDeviceFeatures() const { return m_PhysicalDeviceFeatures; }
+        inline const VkPhysicalDeviceProperties& GetPhysicalDeviceProperties() const
+        {
+            return m_PhysicalDeviceProperties;
+        }
 
         uint32_t GetMemoryTypeIndex(uint32_t _TypeBits, VkMemoryPropertyFlags _Properties) const;
         inline uint32_t GetMinUniformBufferOffsetAligment() const
         {
             return m_PhysicalDeviceProperties.limits.minUniformBufferOffsetAlignment;
         }
+        inline uint32_t GetMaxUniformBufferRange() const
+        {
+            return m_PhysicalDeviceProperties.limits.maxUniformBufferRange;
+        }
+        inline VkDeviceSize GetMinStorageBufferOffsetAlignment() const
+        {
+            return m_PhysicalDeviceProperties.limits.minStorageBufferOffsetAlignment;
+        }
+        inline VkDeviceSize GetNonCoherentAtomSize() const
+        {
+            return m_PhysicalDeviceProperties.limits.nonCoherentAtomSize;
+        }
 
         inline const VulkanDeviceSupportFlags GetSupportFlags() const { return m_SupportFlags; }
 
+        // NOTE: Size limit of update after bind sampled image arrays, 0 if bindless textures are not supported
+        inline uint32_t GetMaxBindlessTextureCount() const { return m_MaxBindlessTextureCount; }
+
+        // NOTE: Current heap budgets and process usage, false if VK_EXT_memory_budget is not supported
+        bool QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& _OutBudget) const;
+
+        // NOTE: The allocator is internally synchronized, so it is available through the const device wrapper
+        inline VulkanMemoryAllocator& GetMemoryAllocator() const { return m_MemoryAllocator; }
+
     protected:
         bool SelectPhysicalDevice(VkInstance _VkInstance);
 
@@ -69,6 +104,7 @@ namespace Vega
         VkQueue m_ComputeQueue;
 
         VkCommandPool m_GraphicsCommandPool;
+        VkCommandPool m_TransferCommandPool;
 
         VkPhysicalDeviceProperties m_PhysicalDeviceProperties;
         VkPhysicalDeviceFeatures m_PhysicalDeviceFeatures;
@@ -78,6 +114,9 @@ namespace Vega
         uint8_t m_DepthChannelCount;
 
         VulkanDeviceSupportFlags m_SupportFlags = 0;
+        uint32_t m_MaxBindlessTextureCount = 0;
+
+        mutable VulkanMemoryAllocator m_MemoryAllocator;
     };
 
 }    // namespace Vega
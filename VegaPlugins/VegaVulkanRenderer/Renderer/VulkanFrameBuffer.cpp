@@ -22,6 +22,7 @@ namespace Vega
             for (size_t i = 0; i < imageCount; ++i)
             {
                 Ref<VulkanTexture> texture = CreateRef<VulkanTexture>();
+                texture->SetMemoryCategory(RendererMemoryCategory::kFrameBuffer);
                 texture->Create(std::format("VulkanFrameBuffer_{}_{}", m_Props.Name, i),
                                 {
                                     .Width = m_Props.Width,
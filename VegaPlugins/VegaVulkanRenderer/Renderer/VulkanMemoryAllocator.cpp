@@ -0,0 +1,342 @@
+#include "VulkanMemoryAllocator.hpp"
+
+#include "Utils/VulkanUtils.hpp"
+#include "Vega/Utils/Log.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace Vega
+{
+
+    // NOTE: Allocations bigger than half of the pool block size always get dedicated memory
+    static constexpr VkDeviceSize kDefaultBlockSize = 256ULL * 1024 * 1024;
+    static constexpr VkDeviceSize kSmallHeapSize = 1024ULL * 1024 * 1024;
+
+    void VulkanMemoryAllocator::Init(const VulkanContext& _Context, VkDevice _LogicalDevice,
+                                     const VkPhysicalDeviceMemoryProperties& _MemoryProperties)
+    {
+        m_Context = &_Context;
+        m_LogicalDevice = _LogicalDevice;
+        m_MemoryProperties = _MemoryProperties;
+
+        m_AllocationRecords.clear();
+        m_HeapAllocatedSizes.assign(m_MemoryProperties.memoryHeapCount, 0);
+        m_HeapUsedSizes.assign(m_MemoryProperties.memoryHeapCount, 0);
+
+        m_Pools.clear();
+        m_Pools.resize(m_MemoryProperties.memoryTypeCount * 2);
+        for (uint32_t memoryTypeIndex = 0; memoryTypeIndex < m_MemoryProperties.memoryTypeCount; ++memoryTypeIndex)
+        {
+            VkDeviceSize heapSize =
+                m_MemoryProperties.memoryHeaps[m_MemoryProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+            VkDeviceSize blockSize = heapSize <= kSmallHeapSize ? heapSize / 8 : kDefaultBlockSize;
+
+            for (uint32_t resourceType = 0; resourceType < 2; ++resourceType)
+            {
+                m_Pools[memoryTypeIndex * 2 + resourceType] = VulkanMemoryPool {
+                    .MemoryTypeIndex = memoryTypeIndex,
+                    .ResourceType = static_cast<VulkanMemoryResourceType>(resourceType),
+                    .BlockSize = blockSize,
+                };
+            }
+        }
+    }
+
+    void VulkanMemoryAllocator::Shutdown(const VulkanContext& _Context)
+    {
+        std::lock_guard lock(m_Mutex);
+
+        for (VulkanMemoryPool& pool : m_Pools)
+        {
+            for (Scope<VulkanMemoryBlock>& block : pool.Blocks)
+            {
+                if (block->UsedSize > 0)
+                {
+                    VEGA_CORE_WARN("VulkanMemoryAllocator: {} bytes of memory type {} are still in use on shutdown",
+                                   block->UsedSize, pool.MemoryTypeIndex);
+                }
+                FreeDeviceMemory(block->Memory, block->Size, pool.MemoryTypeIndex, block->MappedData != nullptr);
+            }
+            pool.Blocks.clear();
+        }
+        m_Pools.clear();
+
+        if (m_DeviceMemoryCount > 0)
+        {
+            VEGA_CORE_WARN("VulkanMemoryAllocator: {} dedicated allocations were not freed", m_DeviceMemoryCount);
+            m_DeviceMemoryCount = 0;
+        }
+
+        for (const auto& [key, record] : m_AllocationRecords)
+        {
+            VEGA_CORE_WARN("VulkanMemoryAllocator: '{}' ({} bytes) was not freed", record.Name, record.Size);
+        }
+        m_AllocationRecords.clear();
+
+        m_LogicalDevice = VK_NULL_HANDLE;
+        m_Context = nullptr;
+    }
+
+    bool VulkanMemoryAllocator::Allocate(const VkMemoryRequirements& _Requirements, uint32_t _MemoryTypeIndex,
+                                         VulkanMemoryResourceType _ResourceType, bool _IsDedicatedPreferred,
+                                         std::string_view _Name, RendererMemoryCategory _Category,
+                                         VulkanMemoryAllocation& _OutAllocation)
+    {
+        std::lock_guard lock(m_Mutex);
+
+        size_t poolIndex = _MemoryTypeIndex * 2 + static_cast<uint32_t>(_ResourceType);
+        VulkanMemoryPool& pool = m_Pools[poolIndex];
+
+        _OutAllocation = VulkanMemoryAllocation {
+            .Size = _Requirements.size,
+            .MemoryTypeIndex = _MemoryTypeIndex,
+            .MemoryProperties = m_MemoryProperties.memoryTypes[_MemoryTypeIndex].propertyFlags,
+        };
+
+        if (_IsDedicatedPreferred || _Requirements.size > pool.BlockSize / 2)
+        {
+            if (!AllocateDeviceMemory(_Requirements.size, _MemoryTypeIndex, _Name, _OutAllocation.Memory,
+                                      _OutAllocation.MappedData))
+            {
+                return false;
+            }
+            TrackAllocation(_OutAllocation, _Name, _Category);
+            return true;
+        }
+
+        for (Scope<VulkanMemoryBlock>& block : pool.Blocks)
+        {
+            if (AllocateFromBlock(*block, _Requirements.size, _Requirements.alignment, _OutAllocation.Offset))
+            {
+                _OutAllocation.Memory = block->Memory;
+                _OutAllocation.Block = block.get();
+                _OutAllocation.MappedData =
+                    block->MappedData ? static_cast<uint8_t*>(block->MappedData) + _OutAllocation.Offset : nullptr;
+                TrackAllocation(_OutAllocation, _Name, _Category);
+                return true;
+            }
+        }
+
+        Scope<VulkanMemoryBlock> block = CreateScope<VulkanMemoryBlock>();
+        block->Size = pool.BlockSize;
+        block->PoolIndex = poolIndex;
+        if (!AllocateDeviceMemory(block->Size, _MemoryTypeIndex,
+                                  std::format("memory_block_{}_{}", _MemoryTypeIndex, pool.Blocks.size()),
+                                  block->Memory, block->MappedData))
+        {
+            return false;
+        }
+        block->FreeRanges.emplace(0, block->Size);
+
+        AllocateFromBlock(*block, _Requirements.size, _Requirements.alignment, _OutAllocation.Offset);
+        _OutAllocation.Memory = block->Memory;
+        _OutAllocation.Block = block.get();
+        _OutAllocation.MappedData =
+            block->MappedData ? static_cast<uint8_t*>(block->MappedData) + _OutAllocation.Offset : nullptr;
+
+        pool.Blocks.push_back(std::move(block));
+        TrackAllocation(_OutAllocation, _Name, _Category);
+        return true;
+    }
+
+    void VulkanMemoryAllocator::Free(VulkanMemoryAllocation& _Allocation)
+    {
+        if (_Allocation.Memory == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        std::lock_guard lock(m_Mutex);
+
+        UntrackAllocation(_Allocation);
+
+        if (!_Allocation.Block)
+        {
+            FreeDeviceMemory(_Allocation.Memory, _Allocation.Size, _Allocation.MemoryTypeIndex,
+                             _Allocation.MappedData != nullptr);
+            _Allocation = {};
+            return;
+        }
+
+        VulkanMemoryBlock* block = _Allocation.Block;
+        FreeToBlock(*block, _Allocation.Offset, _Allocation.Size);
+
+        // NOTE: Keep one empty block per pool to avoid allocation ping-pong
+        VulkanMemoryPool& pool = m_Pools[block->PoolIndex];
+        if (block->UsedSize == 0 && pool.Blocks.size() > 1)
+        {
+            for (auto blockIt = pool.Blocks.begin(); blockIt != pool.Blocks.end(); ++blockIt)
+            {
+                if (blockIt->get() == block)
+                {
+                    FreeDeviceMemory(block->Memory, block->Size, pool.MemoryTypeIndex, block->MappedData != nullptr);
+                    pool.Blocks.erase(blockIt);
+                    break;
+                }
+            }
+        }
+
+        _Allocation = {};
+    }
+
+    void VulkanMemoryAllocator::GetStats(RendererMemoryStats& _OutStats) const
+    {
+        std::lock_guard lock(m_Mutex);
+
+        _OutStats.Heaps.resize(m_MemoryProperties.memoryHeapCount);
+        for (uint32_t heapIndex = 0; heapIndex < m_MemoryProperties.memoryHeapCount; ++heapIndex)
+        {
+            RendererMemoryHeapStats& heapStats = _OutStats.Heaps[heapIndex];
+            heapStats.Size = m_MemoryProperties.memoryHeaps[heapIndex].size;
+            heapStats.IsDeviceLocal = m_MemoryProperties.memoryHeaps[heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+            heapStats.AllocatedSize = m_HeapAllocatedSizes[heapIndex];
+            heapStats.UsedSize = m_HeapUsedSizes[heapIndex];
+        }
+
+        _OutStats.Allocations.clear();
+        _OutStats.Allocations.reserve(m_AllocationRecords.size());
+        for (const auto& [key, record] : m_AllocationRecords)
+        {
+            _OutStats.Allocations.push_back(RendererMemoryAllocationStats {
+                .Name = record.Name,
+                .Category = record.Category,
+                .Size = record.Size,
+                .HeapIndex = m_MemoryProperties.memoryTypes[record.MemoryTypeIndex].heapIndex,
+                .IsDedicated = record.IsDedicated,
+            });
+        }
+        std::sort(_OutStats.Allocations.begin(), _OutStats.Allocations.end(),
+                  [](const RendererMemoryAllocationStats& _Lhs, const RendererMemoryAllocationStats& _Rhs) {
+                      return _Lhs.Size > _Rhs.Size;
+                  });
+    }
+
+    bool VulkanMemoryAllocator::AllocateDeviceMemory(VkDeviceSize _Size, uint32_t _MemoryTypeIndex,
+                                                     std::string_view _Name, VkDeviceMemory& _OutMemory,
+                                                     void*& _OutMappedData)
+    {
+        VkMemoryAllocateInfo memoryAllocateInfo = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = _Size,
+            .memoryTypeIndex = _MemoryTypeIndex,
+        };
+
+        VkResult allocateResult =
+            vkAllocateMemory(m_LogicalDevice, &memoryAllocateInfo, m_Context->VkAllocator, &_OutMemory);
+        if (!VulkanResultIsSuccess(allocateResult))
+        {
+            uint32_t heapIndex = m_MemoryProperties.memoryTypes[_MemoryTypeIndex].heapIndex;
+            VEGA_CORE_ERROR("Failed to allocate device memory {} ({} bytes): {}", _Name, _Size,
+                            VulkanResultString(allocateResult, true));
+            VEGA_CORE_ERROR("Heap {}: {} of {} bytes allocated by the renderer in {} allocations", heapIndex,
+                            m_HeapAllocatedSizes[heapIndex], m_MemoryProperties.memoryHeaps[heapIndex].size,
+                            m_AllocationRecords.size());
+            _OutMemory = VK_NULL_HANDLE;
+            return false;
+        }
+
+        VK_SET_DEBUG_OBJECT_NAME(m_Context->PfnSetDebugUtilsObjectNameEXT, m_LogicalDevice,
+                                 VK_OBJECT_TYPE_DEVICE_MEMORY, _OutMemory, std::string(_Name).c_str());
+
+        _OutMappedData = nullptr;
+        if (m_MemoryProperties.memoryTypes[_MemoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            VK_CHECK(vkMapMemory(m_LogicalDevice, _OutMemory, 0, VK_WHOLE_SIZE, 0, &_OutMappedData));
+        }
+
+        ++m_DeviceMemoryCount;
+        m_HeapAllocatedSizes[m_MemoryProperties.memoryTypes[_MemoryTypeIndex].heapIndex] += _Size;
+        return true;
+    }
+
+    void VulkanMemoryAllocator::FreeDeviceMemory(VkDeviceMemory _Memory, VkDeviceSize _Size, uint32_t _MemoryTypeIndex,
+                                                 bool _IsMapped)
+    {
+        if (_IsMapped)
+        {
+            vkUnmapMemory(m_LogicalDevice, _Memory);
+        }
+        vkFreeMemory(m_LogicalDevice, _Memory, m_Context->VkAllocator);
+        --m_DeviceMemoryCount;
+        m_HeapAllocatedSizes[m_MemoryProperties.memoryTypes[_MemoryTypeIndex].heapIndex] -= _Size;
+    }
+
+    void VulkanMemoryAllocator::TrackAllocation(const VulkanMemoryAllocation& _Allocation, std::string_view _Name,
+                                                RendererMemoryCategory _Category)
+    {
+        m_AllocationRecords[{ _Allocation.Memory, _Allocation.Offset }] = VulkanMemoryAllocationRecord {
+            .Name = std::string(_Name),
+            .Category = _Category,
+            .Size = _Allocation.Size,
+            .MemoryTypeIndex = _Allocation.MemoryTypeIndex,
+            .IsDedicated = _Allocation.Block == nullptr,
+        };
+        m_HeapUsedSizes[m_MemoryProperties.memoryTypes[_Allocation.MemoryTypeIndex].heapIndex] += _Allocation.Size;
+    }
+
+    void VulkanMemoryAllocator::UntrackAllocation(const VulkanMemoryAllocation& _Allocation)
+    {
+        if (m_AllocationRecords.erase({ _Allocation.Memory, _Allocation.Offset }) != 0)
+        {
+            m_HeapUsedSizes[m_MemoryProperties.memoryTypes[_Allocation.MemoryTypeIndex].heapIndex] -= _Allocation.Size;
+        }
+    }
+
+    bool VulkanMemoryAllocator::AllocateFromBlock(VulkanMemoryBlock& _Block, VkDeviceSize _Size,
+                                                  VkDeviceSize _Alignment, VkDeviceSize& _OutOffset)
+    {
+        // NOTE: First fit, alignment padding stays in the free list
+        for (auto rangeIt = _Block.FreeRanges.begin(); rangeIt != _Block.FreeRanges.end(); ++rangeIt)
+        {
+            auto [rangeOffset, rangeSize] = *rangeIt;
+            VkDeviceSize alignedOffset = (rangeOffset + _Alignment - 1) / _Alignment * _Alignment;
+            VkDeviceSize padding = alignedOffset - rangeOffset;
+            if (padding + _Size > rangeSize)
+            {
+                continue;
+            }
+
+            _Block.FreeRanges.erase(rangeIt);
+            if (padding > 0)
+            {
+                _Block.FreeRanges.emplace(rangeOffset, padding);
+            }
+            if (padding + _Size < rangeSize)
+            {
+                _Block.FreeRanges.emplace(alignedOffset + _Size, rangeSize - padding - _Size);
+            }
+
+            _Block.UsedSize += _Size;
+            _OutOffset = alignedOffset;
+            return true;
+        }
+
+        return false;
+    }
+
+    void VulkanMemoryAllocator::FreeToBlock(VulkanMemoryBlock& _Block, VkDeviceSize _Offset, VkDeviceSize _Size)
+    {
+        _Block.UsedSize -= _Size;
+        auto rangeIt = _Block.FreeRanges.emplace(_Offset, _Size).first;
+
+        auto nextIt = std::next(rangeIt);
+        if (nextIt != _Block.FreeRanges.end() && rangeIt->first + rangeIt->second == nextIt->first)
+        {
+            rangeIt->second += nextIt->second;
+            _Block.FreeRanges.erase(nextIt);
+        }
+
+        if (rangeIt != _Block.FreeRanges.begin())
+        {
+            auto prevIt = std::prev(rangeIt);
+            if (prevIt->first + prevIt->second == rangeIt->first)
+            {
+                prevIt->second += rangeIt->second;
+                _Block.FreeRanges.erase(rangeIt);
+            }
+        }
+    }
+
+}    // namespace Vega
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Vega/Core/Base.hpp"
+#include "Vega/Renderer/RendererBackendTypes.hpp"
+#include "VulkanBase.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Vega
+{
+
+    enum class VulkanMemoryResourceType : uint32_t
+    {
+        kLinear = 0U,    // Buffers and linear tiling images
+        kOptimal,        // Optimal tiling images
+    };
+
+    struct VulkanMemoryBlock
+    {
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        VkDeviceSize Size = 0;
+        void* MappedData = nullptr;
+
+        // NOTE: Free ranges sorted by offset (offset -> size), adjacent ranges are always merged
+        std::map<VkDeviceSize, VkDeviceSize> FreeRanges;
+        VkDeviceSize UsedSize = 0;
+
+        size_t PoolIndex = 0;
+    };
+
+    struct VulkanMemoryAllocation
+    {
+        VkDeviceMemory Memory = VK_NULL_HANDLE;
+        VkDeviceSize Offset = 0;
+        VkDeviceSize Size = 0;
+
+        // NOTE: Points to Offset inside the memory, nullptr if memory is not host visible
+        void* MappedData = nullptr;
+
+        uint32_t MemoryTypeIndex = 0;
+        VkMemoryPropertyFlags MemoryProperties = 0;
+
+        // NOTE: nullptr for dedicated allocations
+        VulkanMemoryBlock* Block = nullptr;
+    };
+
+    struct VulkanMemoryAllocationRecord
+    {
+        std::string Name;
+        RendererMemoryCategory Category;
+        VkDeviceSize Size;
+        uint32_t MemoryTypeIndex;
+        bool IsDedicated;
+    };
+
+    struct VulkanMemoryPool
+    {
+        uint32_t MemoryTypeIndex;
+        VulkanMemoryResourceType ResourceType;
+        VkDeviceSize BlockSize;
+        std::vector<Scope<VulkanMemoryBlock>> Blocks;
+    };
+
+    /**
+     * @brief VulkanMemoryAllocator class
+     *
+     * Sub-allocates device memory from large blocks, one pool per memory type and resource type (linear resources
+     * and optimal images never share a block, so bufferImageGranularity is always respected). Big resources and
+     * resources that prefer it get a dedicated VkDeviceMemory. Host visible blocks are persistently mapped.
+     * Every live allocation is recorded with its name and category so memory usage can be inspected at runtime.
+     */
+    class VulkanMemoryAllocator
+    {
+    public:
+        VulkanMemoryAllocator() = default;
+        // NOTE: Owns the device memory blocks and their bookkeeping, copies would free them twice
+        VulkanMemoryAllocator(const VulkanMemoryAllocator&) = delete;
+        VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) = delete;
+
+        void Init(const VulkanContext& _Context, VkDevice _LogicalDevice,
+                  const VkPhysicalDeviceMemoryProperties& _MemoryProperties);
+        void Shutdown(const VulkanContext& _Context);
+
+        bool Allocate(const VkMemoryRequirements& _Requirements, uint32_t _MemoryTypeIndex,
+                      VulkanMemoryResourceType _ResourceType, bool _IsDedicatedPreferred, std::string_view _Name,
+                      RendererMemoryCategory _Category, VulkanMemoryAllocation& _OutAllocation);
+        void Free(VulkanMemoryAllocation& _Allocation);
+
+        // NOTE: Number of live VkDeviceMemory objects, blocks and dedicated allocations
+        size_t GetDeviceMemoryCount() const { return m_DeviceMemoryCount; }
+
+        // NOTE: Fills heaps (without driver budget) and allocations sorted by size, biggest first
+        void GetStats(RendererMemoryStats& _OutStats) const;
+
+    protected:
+        bool AllocateDeviceMemory(VkDeviceSize _Size, uint32_t _MemoryTypeIndex, std::string_view _Name,
+                                  VkDeviceMemory& _OutMemory, void*& _OutMappedData);
+        void FreeDeviceMemory(VkDeviceMemory _Memory, VkDeviceSize _Size, uint32_t _MemoryTypeIndex, bool _IsMapped);
+
+        void TrackAllocation(const VulkanMemoryAllocation& _Allocation, std::string_view _Name,
+                             RendererMemoryCategory _Category);
+        void UntrackAllocation(const VulkanMemoryAllocation& _Allocation);
+
+        static bool AllocateFromBlock(VulkanMemoryBlock& _Block, VkDeviceSize _Size, VkDeviceSize _Alignment,
+                                      VkDeviceSize& _OutOffset);
+        static void FreeToBlock(VulkanMemoryBlock& _Block, VkDeviceSize _Offset, VkDeviceSize _Size);
+
+    protected:
+        const VulkanContext* m_Context = nullptr;
+        VkDevice m_LogicalDevice = VK_NULL_HANDLE;
+        VkPhysicalDeviceMemoryProperties m_MemoryProperties;
+
+        // NOTE: Indexed by MemoryTypeIndex * 2 + ResourceType
+        std::vector<VulkanMemoryPool> m_Pools;
+
+        size_t m_DeviceMemoryCount = 0;
+
+        // NOTE: Live allocations keyed by (memory, offset)
+        std::map<std::pair<VkDeviceMemory, VkDeviceSize>, VulkanMemoryAllocationRecord> m_AllocationRecords;
+        // NOTE: Indexed by heap index
+        std::vector<VkDeviceSize> m_HeapAllocatedSizes;
+        std::vector<VkDeviceSize> m_HeapUsedSizes;
+
+        mutable std::mutex m_Mutex;
+    };
+
+}    // namespace Vega
@@ -0,0 +1,205 @@
+#include "VulkanPipelineCache.hpp"
+
+#include "Utils/VulkanUtils.hpp"
+#include "Vega/Utils/Log.hpp"
+#include "VulkanRendererBackend.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <system_error>
+
+namespace Vega
+{
+
+    // NOTE: Bump when the file layout changes
+    static constexpr uint32_t kPipelineCacheFileVersion = 1;
+    static constexpr uint32_t kPipelineCacheFileMagic = 0x43504756;    // "VGPC"
+
+    // NOTE: Written in front of the driver data, the driver header is validated as well since some drivers crash on
+    //       foreign data instead of rejecting it
+    struct VulkanPipelineCacheFileHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t VendorId;
+        uint32_t DeviceId;
+        uint32_t DriverVersion;
+        uint8_t PipelineCacheUuid[VK_UUID_SIZE];
+        uint64_t DataSize;
+    };
+
+    void VulkanPipelineCache::Create(const std::filesystem::path& _Path)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanContext& context = rendererBackend->GetVkContext();
+        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
+
+        m_Path = _Path;
+
+        std::vector<uint8_t> initialData;
+        if (LoadData(initialData))
+        {
+            VEGA_CORE_INFO("Loaded pipeline cache ({} bytes) from {}", initialData.size(), m_Path.string());
+        }
+
+        VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .initialDataSize = initialData.size(),
+            .pInitialData = initialData.empty() ? nullptr : initialData.data(),
+        };
+
+        VkResult result =
+            vkCreatePipelineCache(logicalDevice, &pipelineCacheCreateInfo, context.VkAllocator, &m_PipelineCache);
+        if (!VulkanResultIsSuccess(result) && !initialData.empty())
+        {
+            VEGA_CORE_WARN("Pipeline cache data was rejected ({}), starting with an empty cache",
+                           VulkanResultString(result, true));
+            pipelineCacheCreateInfo.initialDataSize = 0;
+            pipelineCacheCreateInfo.pInitialData = nullptr;
+            result =
+                vkCreatePipelineCache(logicalDevice, &pipelineCacheCreateInfo, context.VkAllocator, &m_PipelineCache);
+        }
+
+        if (!VulkanResultIsSuccess(result))
+        {
+            VEGA_CORE_ERROR("Failed to create pipeline cache: {}", VulkanResultString(result, true));
+            m_PipelineCache = VK_NULL_HANDLE;
+            return;
+        }
+
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_PIPELINE_CACHE,
+                                 m_PipelineCache, "pipeline_cache");
+    }
+
+    void VulkanPipelineCache::Destroy()
+    {
+        if (m_PipelineCache == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        SaveData();
+
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        vkDestroyPipelineCache(rendererBackend->GetVkDeviceWrapper().GetLogicalDevice(), m_PipelineCache,
+                               rendererBackend->GetVkContext().VkAllocator);
+        m_PipelineCache = VK_NULL_HANDLE;
+    }
+
+    bool VulkanPipelineCache::LoadData(std::vector<uint8_t>& _OutData) const
+    {
+        const VkPhysicalDeviceProperties& properties =
+            VulkanRendererBackend::GetVkRendererBackend()->GetVkDeviceWrapper().GetPhysicalDeviceProperties();
+
+        std::error_code errorCode;
+        uint64_t fileSize = std::filesystem::file_size(m_Path, errorCode);
+        if (errorCode)
+        {
+            return false;
+        }
+
+        std::ifstream file(m_Path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        VulkanPipelineCacheFileHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.Magic != kPipelineCacheFileMagic ||
+            header.Version != kPipelineCacheFileVersion)
+        {
+            VEGA_CORE_WARN("Pipeline cache {} has an unknown format, ignoring it", m_Path.string());
+            return false;
+        }
+
+        if (header.VendorId != properties.vendorID || header.DeviceId != properties.deviceID ||
+            header.DriverVersion != properties.driverVersion ||
+            std::memcmp(header.PipelineCacheUuid, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            VEGA_CORE_INFO("Pipeline cache {} was created by another device or driver, ignoring it", m_Path.string());
+            return false;
+        }
+
+        if (header.DataSize < sizeof(VkPipelineCacheHeaderVersionOne) || header.DataSize != fileSize - sizeof(header))
+        {
+            VEGA_CORE_WARN("Pipeline cache {} is truncated, ignoring it", m_Path.string());
+            return false;
+        }
+
+        _OutData.resize(header.DataSize);
+        if (!file.read(reinterpret_cast<char*>(_OutData.data()), header.DataSize))
+        {
+            VEGA_CORE_WARN("Pipeline cache {} is truncated, ignoring it", m_Path.string());
+            _OutData.clear();
+            return false;
+        }
+
+        VkPipelineCacheHeaderVersionOne driverHeader;
+        std::memcpy(&driverHeader, _OutData.data(), sizeof(driverHeader));
+        if (driverHeader.headerSize < sizeof(driverHeader) ||
+            driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+            driverHeader.vendorID != properties.vendorID || driverHeader.deviceID != properties.deviceID ||
+            std::memcmp(driverHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            VEGA_CORE_WARN("Pipeline cache {} has a mismatching driver header, ignoring it", m_Path.string());
+            _OutData.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void VulkanPipelineCache::SaveData() const
+    {
+        const VulkanDeviceWrapper& deviceWrapper = VulkanRendererBackend::GetVkRendererBackend()->GetVkDeviceWrapper();
+        const VkPhysicalDeviceProperties& properties = deviceWrapper.GetPhysicalDeviceProperties();
+        VkDevice logicalDevice = deviceWrapper.GetLogicalDevice();
+
+        size_t dataSize = 0;
+        VK_CHECK(vkGetPipelineCacheData(logicalDevice, m_PipelineCache, &dataSize, nullptr));
+        if (dataSize == 0)
+        {
+            return;
+        }
+
+        std::vector<uint8_t> data(dataSize);
+        VK_CHECK(vkGetPipelineCacheData(logicalDevice, m_PipelineCache, &dataSize, data.data()));
+
+        VulkanPipelineCacheFileHeader header = {
+            .Magic = kPipelineCacheFileMagic,
+            .Version = kPipelineCacheFileVersion,
+            .VendorId = properties.vendorID,
+            .DeviceId = properties.deviceID,
+            .DriverVersion = properties.driverVersion,
+            .DataSize = dataSize,
+        };
+        std::memcpy(header.PipelineCacheUuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(m_Path.parent_path(), errorCode);
+
+        std::filesystem::path temporaryPath = m_Path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open() || !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+                !file.write(reinterpret_cast<const char*>(data.data()), dataSize))
+            {
+                VEGA_CORE_WARN("Failed to write pipeline cache: {}", temporaryPath.string());
+                return;
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, m_Path, errorCode);
+        if (errorCode)
+        {
+            VEGA_CORE_WARN("Failed to write pipeline cache {}: {}", m_Path.string(), errorCode.message());
+            std::filesystem::remove(temporaryPath, errorCode);
+            return;
+        }
+
+        VEGA_CORE_INFO("Saved pipeline cache ({} bytes) to {}", dataSize, m_Path.string());
+    }
+
+}    // namespace Vega
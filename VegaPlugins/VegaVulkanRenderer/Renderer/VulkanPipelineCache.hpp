@@ -0,0 +1,40 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace Vega
+{
+
+    /**
+     * @brief VulkanPipelineCache class
+     *
+     * Device level VkPipelineCache shared by every pipeline creation. The cache data is loaded from disk on create
+     * and written back on destroy. Data from another vendor, device, driver version or pipeline cache UUID is
+     * discarded instead of being handed to the driver.
+     */
+    class VulkanPipelineCache
+    {
+    public:
+        static constexpr std::string_view kDefaultFileName = "pipeline_cache.bin";
+
+        void Create(const std::filesystem::path& _Path);
+        void Destroy();
+
+        inline VkPipelineCache GetVkPipelineCache() const { return m_PipelineCache; }
+
+    protected:
+        bool LoadData(std::vector<uint8_t>& _OutData) const;
+        void SaveData() const;
+
+    protected:
+        std::filesystem::path m_Path;
+
+        VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+    };
+
+}    // namespace Vega
@@ -0,0 +1,89 @@
+#include "VulkanPipelineStateCache.hpp"
+
+#include "Vega/Utils/Log.hpp"
+#include "VulkanRendererBackend.hpp"
+
+namespace Vega
+{
+
+    void VulkanPipelineStateCache::Destroy()
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Entries.empty())
+        {
+            VEGA_CORE_WARN("{} graphics pipelines were not released before shutdown", m_Entries.size());
+        }
+        for (auto& [stateHash, entry] : m_Entries)
+        {
+            vkDestroyPipeline(logicalDevice, entry.Pipeline, rendererBackend->GetVkContext().VkAllocator);
+        }
+        m_Entries.clear();
+    }
+
+    VkPipeline VulkanPipelineStateCache::Acquire(uint64_t _StateHash, const CreateFunction& _CreatePipeline)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto entryIt = m_Entries.find(_StateHash);
+            if (entryIt != m_Entries.end())
+            {
+                ++entryIt->second.RefCount;
+                return entryIt->second.Pipeline;
+            }
+        }
+
+        // NOTE: Created without the lock, another thread may create the same state meanwhile
+        VkPipeline pipeline = _CreatePipeline();
+        if (!pipeline)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto [entryIt, isInserted] = m_Entries.try_emplace(_StateHash, Entry { .Pipeline = pipeline });
+        if (!isInserted)
+        {
+            // NOTE: Not used by anyone yet, so it can be destroyed right away
+            VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+            vkDestroyPipeline(rendererBackend->GetVkDeviceWrapper().GetLogicalDevice(), pipeline,
+                              rendererBackend->GetVkContext().VkAllocator);
+        }
+        ++entryIt->second.RefCount;
+        return entryIt->second.Pipeline;
+    }
+
+    void VulkanPipelineStateCache::Release(uint64_t _StateHash)
+    {
+        VkPipeline retiredPipeline = VK_NULL_HANDLE;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto entryIt = m_Entries.find(_StateHash);
+            if (entryIt == m_Entries.end())
+            {
+                VEGA_CORE_ASSERT(false, "Released graphics pipeline is not in the cache!");
+                return;
+            }
+
+            if (--entryIt->second.RefCount > 0)
+            {
+                return;
+            }
+            retiredPipeline = entryIt->second.Pipeline;
+            m_Entries.erase(entryIt);
+        }
+
+        VulkanRendererBackend::GetVkRendererBackend()->RetireShaderObjects(VulkanRetiredShaderObjects {
+            .Pipelines = { retiredPipeline },
+        });
+    }
+
+    size_t VulkanPipelineStateCache::GetPipelineCount()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Entries.size();
+    }
+
+}    // namespace Vega
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace Vega
+{
+
+    /**
+     * @brief VulkanPipelineStateCache class
+     *
+     * Renderer wide set of graphics pipelines keyed by a hash of everything that affects them (stages and their
+     * specialization, vertex layout, raster, depth, stencil and blend state, attachment formats). A pipeline is
+     * created by its first user and shared with every later user of the same state, it is retired once the last
+     * user releases it.
+     */
+    class VulkanPipelineStateCache
+    {
+    public:
+        using CreateFunction = std::function<VkPipeline()>;
+
+        // NOTE: Destroys pipelines that were never released, the device must be idle
+        void Destroy();
+
+        /**
+         * @brief Returns the pipeline of _StateHash, _CreatePipeline is called if no user holds it yet.
+         *
+         * Thread safe, pipelines of different states are created in parallel.
+         *
+         * @return VkPipeline VK_NULL_HANDLE if the creation failed, nothing has to be released then.
+         */
+        VkPipeline Acquire(uint64_t _StateHash, const CreateFunction& _CreatePipeline);
+
+        // NOTE: Main thread only, frames in flight may still use the pipeline, so it is retired to the backend
+        void Release(uint64_t _StateHash);
+
+        size_t GetPipelineCount();
+
+    protected:
+        struct Entry
+        {
+            VkPipeline Pipeline = VK_NULL_HANDLE;
+            uint32_t RefCount = 0;
+        };
+
+    protected:
+        std::mutex m_Mutex;
+        std::unordered_map<uint64_t, Entry> m_Entries;
+    };
+
+}    // namespace Vega
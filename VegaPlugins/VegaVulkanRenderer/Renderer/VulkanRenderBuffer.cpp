@@ -6,6 +6,8 @@
 #include "Vega/Utils/Log.hpp"
 #include "VulkanRendererBackend.hpp"
 
+#include <cstring>
+
 namespace Vega
 {
 
@@ -25,47 +27,47 @@ namespace Vega
         };
 
         VK_CHECK(vkCreateBuffer(logicalDevice, &bufferCreateInfo, context.VkAllocator, &m_VkBuffer));
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_BUFFER,
+                                 m_VkBuffer, _Props.Name.data());
 
         vkGetBufferMemoryRequirements(logicalDevice, m_VkBuffer, &m_MemoryRequirements);
         uint32_t memoryTypeIndex = rendererBackend->GetVkDeviceWrapper().GetMemoryTypeIndex(
             m_MemoryRequirements.memoryTypeBits, m_VkRenderBufferInfo.MemoryProperties);
-        VkMemoryAllocateInfo memoryAllocateInfo = {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = m_MemoryRequirements.size,
-            .memoryTypeIndex = memoryTypeIndex,
-        };
 
-        VkResult allocateResult =
-            vkAllocateMemory(logicalDevice, &memoryAllocateInfo, context.VkAllocator, &m_BufferMemory);
-        if (!VulkanResultIsSuccess(allocateResult))
+        // NOTE: Host visible memory comes already persistently mapped from the allocator
+        VulkanMemoryAllocator& memoryAllocator = rendererBackend->GetVkDeviceWrapper().GetMemoryAllocator();
+        if (!memoryAllocator.Allocate(m_MemoryRequirements, memoryTypeIndex, VulkanMemoryResourceType::kLinear, false,
+                                      _Props.Name, RendererMemoryCategory::kRenderBuffer, m_Allocation))
         {
-            VEGA_CORE_ERROR("Failed to allocate memory for render buffer: {}",
-                            VulkanResultString(allocateResult, true));
             VEGA_CORE_ASSERT(false, "Failed to allocate memory for render buffer");
             return;
         }
 
-        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_DEVICE_MEMORY,
-                                 m_BufferMemory, _Props.Name.data());
-
-        VK_CHECK(vkBindBufferMemory(logicalDevice, m_VkBuffer, m_BufferMemory, 0));
+        VK_CHECK(vkBindBufferMemory(logicalDevice, m_VkBuffer, m_Allocation.Memory, m_Allocation.Offset));
     }
 
     void VulkanRenderBuffer::Bind(size_t _Offset)
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
         VkCommandBuffer commandBuffer = rendererBackend->GetCurrentGraphicsCommandBuffer();
+        VulkanCommandStateTracker& commandState = rendererBackend->GetCurrentCommandState();
         if (m_RenderBufferProps.Type == RenderBufferType::kVertex)
         {
-            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_VkBuffer, reinterpret_cast<VkDeviceSize*>(&_Offset));
+            if (commandState.BindVertexBuffer(m_VkBuffer, _Offset))
+            {
+                vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_VkBuffer, reinterpret_cast<VkDeviceSize*>(&_Offset));
+            }
         }
         else if (m_RenderBufferProps.Type == RenderBufferType::kIndex)
         {
-            // TODO: Support different index types
-            vkCmdBindIndexBuffer(commandBuffer, m_VkBuffer, _Offset, VK_INDEX_TYPE_UINT32);
+            if (commandState.BindIndexBuffer(m_VkBuffer, _Offset, GetVkIndexType()))
+            {
+                vkCmdBindIndexBuffer(commandBuffer, m_VkBuffer, _Offset, GetVkIndexType());
+            }
         }
         else
         {
+            // NOTE: Storage buffers are bound through Shader::SetStorageBuffer
             VEGA_CORE_ASSERT(false, "Binding is only supported for Vertex and Index RenderBufferTypes!");
         }
     }
@@ -78,7 +80,8 @@ namespace Vega
 
         VK_CHECK(vkDeviceWaitIdle(logicalDevice));
 
-        vkFreeMemory(logicalDevice, m_BufferMemory, vkAllocator);
+        rendererBackend->DiscardFrameCopies(m_VkBuffer);
+        rendererBackend->GetVkDeviceWrapper().GetMemoryAllocator().Free(m_Allocation);
         vkDestroyBuffer(logicalDevice, m_VkBuffer, vkAllocator);
     }
 
@@ -86,68 +89,164 @@ namespace Vega
                                                bool _IncludeInFrameWorkload)
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
-        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
 
         if (IsVulkanRenderBufferDeviceLocal() && !IsVulkanRenderBufferHostVisible())
         {
-            Ref<VulkanRenderBuffer> stagingBuffer = rendererBackend->GetCurrentStagingBuffer();
-            size_t stagingOffset = stagingBuffer->LoadRange(_Size, _Data, _IncludeInFrameWorkload);
-            VEGA_CORE_INFO("CopyRangeInternal: stagingOffset={}, size={}, _Offset={}", stagingOffset, _Size, _Offset);
-            CopyRangeInternal(stagingOffset, stagingBuffer->GetVkBuffer(), _Offset, _Size, _IncludeInFrameWorkload);
+            // NOTE: Uploads outside of the frame always go through the transfer queue
+            if (!_IncludeInFrameWorkload)
+            {
+                rendererBackend->BeginUploadBatch();
+            }
+
+            VulkanStagingAllocation stagingAllocation =
+                rendererBackend->AllocateStagingMemory(_Size, _IncludeInFrameWorkload);
+            std::memcpy(stagingAllocation.MappedData, _Data, _Size);
+            CopyRangeInternal(stagingAllocation.Offset, stagingAllocation.Buffer, _Offset, _Size,
+                              _IncludeInFrameWorkload);
+
+            if (!_IncludeInFrameWorkload)
+            {
+                rendererBackend->EndUploadBatch();
+            }
         }
         else
         {
-            void* mappedData;
-            vkMapMemory(logicalDevice, m_BufferMemory, _Offset, _Size, 0, &mappedData);
-            std::memcpy(mappedData, _Data, _Size);
-            vkUnmapMemory(logicalDevice, m_BufferMemory);
+            VEGA_CORE_ASSERT(m_Allocation.MappedData, "Host visible RenderBuffer is not mapped!");
+            std::memcpy(static_cast<uint8_t*>(m_Allocation.MappedData) + _Offset, _Data, _Size);
+            FlushRange(_Offset, _Size);
         }
     }
 
-    void VulkanRenderBuffer::CopyRangeInternal(size_t _SrcOffset, VkBuffer _SrcBuffer, size_t _DstOffset, size_t _Size,
-                                               bool _IncludeInFrameWorkload)
+    void VulkanRenderBuffer::LoadRangeFromStagingInternal(size_t _Offset, size_t _Size,
+                                                          const RenderBufferStagingRange& _StagingRange,
+                                                          size_t _StagingOffset, bool _IncludeInFrameWorkload)
     {
+        if (!IsVulkanRenderBufferDeviceLocal() || IsVulkanRenderBufferHostVisible())
+        {
+            LoadRangeInternal(_Offset, _Size, static_cast<const uint8_t*>(_StagingRange.MappedData) + _StagingOffset,
+                              _IncludeInFrameWorkload);
+            return;
+        }
+
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
 
-        VkCommandBuffer commandBuffer;
+        // NOTE: Uploads outside of the frame always go through the transfer queue
         if (!_IncludeInFrameWorkload)
         {
-            // TODO: Optimize wait idle (maybe we can remove it at all)
-            VK_CHECK(vkQueueWaitIdle(rendererBackend->GetVkDeviceWrapper().GetGraphicsQueue()));
-            commandBuffer = rendererBackend->CreateAndBeginSingleUseCommandBuffer();
+            rendererBackend->BeginUploadBatch();
         }
-        else
+
+        VulkanStagingAllocation stagingAllocation = rendererBackend->GetStagingReservation(_StagingRange);
+        CopyRangeInternal(stagingAllocation.Offset + _StagingOffset, stagingAllocation.Buffer, _Offset, _Size,
+                          _IncludeInFrameWorkload);
+
+        if (!_IncludeInFrameWorkload)
+        {
+            rendererBackend->EndUploadBatch();
+        }
+    }
+
+    void VulkanRenderBuffer::FlushRange(size_t _Offset, size_t _Size)
+    {
+        if (IsVulkanRenderBufferHostCoherent())
         {
-            commandBuffer = rendererBackend->GetCurrentGraphicsCommandBuffer();
+            return;
         }
 
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+
+        // NOTE: Flushed range must be aligned to nonCoherentAtomSize (or reach the end of the memory)
+        VkDeviceSize atomSize = deviceWrapper.GetNonCoherentAtomSize();
+        VkDeviceSize memoryOffset = m_Allocation.Offset + _Offset;
+        VkDeviceSize memorySize = m_Allocation.Block ? m_Allocation.Block->Size : m_Allocation.Size;
+        VkDeviceSize alignedOffset = (memoryOffset / atomSize) * atomSize;
+        VkDeviceSize alignedEnd = ((memoryOffset + _Size + atomSize - 1) / atomSize) * atomSize;
+
+        VkMappedMemoryRange memoryRange = {
+            .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+            .memory = m_Allocation.Memory,
+            .offset = alignedOffset,
+            .size = alignedEnd >= memorySize ? VK_WHOLE_SIZE : alignedEnd - alignedOffset,
+        };
+        VK_CHECK(vkFlushMappedMemoryRanges(deviceWrapper.GetLogicalDevice(), 1, &memoryRange));
+    }
+
+    size_t VulkanRenderBuffer::GetOffsetAlignment() const
+    {
+        const VulkanDeviceWrapper& deviceWrapper = VulkanRendererBackend::GetVkRendererBackend()->GetVkDeviceWrapper();
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        {
+            return static_cast<size_t>(deviceWrapper.GetMinStorageBufferOffsetAlignment());
+        }
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+        {
+            return static_cast<size_t>(deviceWrapper.GetMinUniformBufferOffsetAligment());
+        }
+        return 1;
+    }
+
+    VkPipelineStageFlags2 VulkanRenderBuffer::GetWriteStageMask() const
+    {
+        VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        {
+            stageMask |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        }
+        return stageMask;
+    }
+
+    VkAccessFlags2 VulkanRenderBuffer::GetWriteAccessMask() const
+    {
+        VkAccessFlags2 accessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        {
+            accessMask |= VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        }
+        return accessMask;
+    }
+
+    void VulkanRenderBuffer::CopyRangeInternal(size_t _SrcOffset, VkBuffer _SrcBuffer, size_t _DstOffset, size_t _Size,
+                                               bool _IncludeInFrameWorkload)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+
         VkBufferCopy copyRegion = {
             .srcOffset = _SrcOffset,
             .dstOffset = _DstOffset,
             .size = _Size,
         };
-        VEGA_CORE_INFO("Copying buffer range: srcOffset={}, dstOffset={}, size={}", _SrcOffset, _DstOffset, _Size);
-        vkCmdCopyBuffer(commandBuffer, _SrcBuffer, m_VkBuffer, 1, &copyRegion);
 
         if (!_IncludeInFrameWorkload)
         {
-            rendererBackend->DestroyAndEndSingleUseCommandBuffer(
-                commandBuffer, rendererBackend->GetVkDeviceWrapper().GetGraphicsQueue(),
-                rendererBackend->GetVkDeviceWrapper().GetGraphicsCommandPool());
+            // NOTE: Synchronization and ownership transfer are done per batch by the renderer backend
+            VEGA_CORE_ASSERT(rendererBackend->IsUploadBatchActive(), "Out of frame copies require an upload batch!");
+            rendererBackend->UploadBatchCopyBuffer(_SrcBuffer, m_VkBuffer, copyRegion);
+            return;
         }
-        else
-        {
-            VkMemoryBarrier memoryBarrier = {
-                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
-                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_MEMORY_READ_BIT |
-                                 VK_ACCESS_TRANSFER_READ_BIT,
-                .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_MEMORY_READ_BIT |
-                                 VK_ACCESS_TRANSFER_READ_BIT,
-            };
 
-            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1,
-                                 &memoryBarrier, 0, nullptr, 0, nullptr);
+        // NOTE: Copies are coalesced and synchronized once per frame by the renderer backend
+        VkPipelineStageFlags2 dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 dstAccessMask = VK_ACCESS_2_NONE;
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
+        {
+            dstStageMask |= VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+            dstAccessMask |= VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+        }
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+        {
+            dstStageMask |= VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+            dstAccessMask |= VK_ACCESS_2_INDEX_READ_BIT;
+        }
+        if (m_VkRenderBufferInfo.Usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+        {
+            dstStageMask |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            dstAccessMask |= VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
         }
+
+        rendererBackend->QueueFrameCopyBuffer(_SrcBuffer, m_VkBuffer, copyRegion, dstStageMask, dstAccessMask);
     }
 
     VulkanRenderBufferInfoByType VulkanRenderBuffer::GetVulkanRenderBufferInfoByType(RenderBufferType _Type)
@@ -191,13 +290,35 @@ namespace Vega
                 };
             }
             case RenderBufferType::kStorage: {
-                VEGA_CORE_ASSERT(false, "Storage RenderBufferType is not supported yet!");
-                return {};
+                return {
+                    .Usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    .MemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                };
+            }
+            case RenderBufferType::kStorageHostVisible: {
+                return {
+                    .Usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    .MemoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                };
             }
             default: VEGA_CORE_ASSERT(false, "Unsupported RenderBufferType!"); return {};
         }
     }
 
+    VkIndexType VulkanRenderBuffer::GetVkIndexType() const
+    {
+        switch (m_RenderBufferProps.ElementSize)
+        {
+            case sizeof(uint16_t): return VK_INDEX_TYPE_UINT16;
+            case sizeof(uint32_t): return VK_INDEX_TYPE_UINT32;
+            default:
+                VEGA_CORE_ASSERT(false, "Index RenderBuffer element size must be 2 or 4 bytes!");
+                return VK_INDEX_TYPE_UINT32;
+        }
+    }
+
     bool VulkanRenderBuffer::IsVulkanRenderBufferHostVisible()
     {
         return (m_VkRenderBufferInfo.MemoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ==
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vega/Renderer/RenderBuffer.hpp"
+#include "VulkanMemoryAllocator.hpp"
 
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_core.h>
@@ -25,6 +26,9 @@ namespace Vega
         // void Resize(size_t _NewElementCount);
 
         virtual void Bind(size_t _Offset = 0) override;
+
+        // NOTE: Storage and uniform ranges are bound by offset, so they follow the device offset alignment
+        size_t GetOffsetAlignment() const override;
         // void Unbind();
 
         // void MapMemory();
@@ -36,16 +40,31 @@ namespace Vega
 
         VkBuffer GetVkBuffer() const { return m_VkBuffer; }
 
+        // NOTE: Host visible buffers are persistently mapped for the whole lifetime, nullptr otherwise
+        void* GetMappedData() const { return m_Allocation.MappedData; }
+
+        // NOTE: No-op for host coherent memory
+        void FlushRange(size_t _Offset, size_t _Size);
+
+        // NOTE: Stages and accesses that may write the buffer inside a frame, host writes are visible on submit
+        VkPipelineStageFlags2 GetWriteStageMask() const;
+        VkAccessFlags2 GetWriteAccessMask() const;
+
     protected:
         virtual void DestroyInternal() override;
 
         void LoadRangeInternal(size_t _Offset, size_t _Size, const void* _Data, bool _IncludeInFrameWorkload) override;
+        void LoadRangeFromStagingInternal(size_t _Offset, size_t _Size, const RenderBufferStagingRange& _StagingRange,
+                                          size_t _StagingOffset, bool _IncludeInFrameWorkload) override;
 
         void CopyRangeInternal(size_t _SrcOffset, VkBuffer _SrcBuffer, size_t _DstOffset, size_t _Size,
                                bool _IncludeInFrameWorkload);
 
         VulkanRenderBufferInfoByType GetVulkanRenderBufferInfoByType(RenderBufferType _Type);
 
+        // NOTE: Index type is deduced from the element size of kIndex buffers
+        VkIndexType GetVkIndexType() const;
+
         bool IsVulkanRenderBufferHostVisible();
         bool IsVulkanRenderBufferDeviceLocal();
         bool IsVulkanRenderBufferHostCoherent();
@@ -56,7 +75,7 @@ namespace Vega
         VulkanRenderBufferInfoByType m_VkRenderBufferInfo;
 
         VkMemoryRequirements m_MemoryRequirements;
-        VkDeviceMemory m_BufferMemory;
+        VulkanMemoryAllocation m_Allocation;
     };
 
 }    // namespace Vega
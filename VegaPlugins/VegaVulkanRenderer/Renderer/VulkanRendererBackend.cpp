@@ -19,7 +19,8 @@
 #include "Platform/VulkanPlatform.hpp"
 #include "Utils/VulkanUtils.hpp"
 
-#include <shaderc/shaderc.h>
+#include <algorithm>
+#include <tuple>
 
 namespace Vega
 {
@@ -154,7 +155,33 @@ namespace Vega
             return false;
         }
 
-        m_VkContext.ShaderCompiler = shaderc_compiler_initialize();
+        VkSemaphoreTypeCreateInfo timelineCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+            .initialValue = 0,
+        };
+        VkSemaphoreCreateInfo timelineSemaphoreCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+            .pNext = &timelineCreateInfo,
+        };
+        VkDevice logicalDevice = m_VkDeviceWrapper.GetLogicalDevice();
+        VK_CHECK(vkCreateSemaphore(logicalDevice, &timelineSemaphoreCreateInfo, m_VkContext.VkAllocator,
+                                   &m_TransferTimelineSemaphore));
+        VK_CHECK(vkCreateSemaphore(logicalDevice, &timelineSemaphoreCreateInfo, m_VkContext.VkAllocator,
+                                   &m_GraphicsTimelineSemaphore));
+        VK_SET_DEBUG_OBJECT_NAME(m_VkContext.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_SEMAPHORE,
+                                 m_TransferTimelineSemaphore, "transfer_timeline_semaphore");
+        VK_SET_DEBUG_OBJECT_NAME(m_VkContext.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_SEMAPHORE,
+                                 m_GraphicsTimelineSemaphore, "graphics_timeline_semaphore");
+
+        m_StagingRingBuffer.Create("staging_ring_buffer", kStagingRingBufferSize);
+
+        m_ShaderCache.Init(VulkanShaderCache::kDefaultDirectory);
+        m_PipelineCache.Create(std::filesystem::path(VulkanShaderCache::kDefaultDirectory) /
+                               VulkanPipelineCache::kDefaultFileName);
+        m_ShaderBuildQueue.Create();
+        m_ShaderFileWatcher = CreateScope<FileWatcher>();
+        m_BindlessTextureHeap.Create();
 
         return true;
     }
@@ -167,10 +194,39 @@ namespace Vega
 
         DestroyImGuiDescriptorPool();
 
-        if (m_VkContext.ShaderCompiler)
+        // NOTE: The device is idle, so every pending readback is complete
+        ProcessCompletedReadbacks();
+        for (Ref<VulkanRenderBuffer>& readBuffer : m_FreeReadbackBuffers)
+        {
+            readBuffer->Destroy();
+        }
+        m_FreeReadbackBuffers.clear();
+
+        m_StagingRingBuffer.Destroy();
+
+        for (Scope<VulkanUploadBatch>& uploadBatch : m_UploadBatches)
         {
-            shaderc_compiler_release(m_VkContext.ShaderCompiler);
+            vkFreeCommandBuffers(logicalDevice, m_VkDeviceWrapper.GetTransferCommandPool(), 1,
+                                 &uploadBatch->CommandBuffer);
         }
+        m_UploadBatches.clear();
+        m_PendingOwnershipAcquires.clear();
+        m_PendingFrameCopies.clear();
+
+        m_PipelineStateCache.Destroy();
+        DestroyRetiredShaderObjects(true);
+        m_BindlessTextureHeap.Destroy();
+
+        vkDestroySemaphore(logicalDevice, m_TransferTimelineSemaphore, m_VkContext.VkAllocator);
+        m_TransferTimelineSemaphore = VK_NULL_HANDLE;
+        vkDestroySemaphore(logicalDevice, m_GraphicsTimelineSemaphore, m_VkContext.VkAllocator);
+        m_GraphicsTimelineSemaphore = VK_NULL_HANDLE;
+
+        m_ShaderFileWatcher.reset();
+        m_ShaderBuildQueue.Destroy();
+
+        // NOTE: Every pipeline is destroyed by now, so the saved data contains everything created this session
+        m_PipelineCache.Destroy();
 
         VEGA_CORE_TRACE("Destroying Vulkan device...");
         m_VkDeviceWrapper.Shutdown(m_VkContext);
@@ -230,7 +286,6 @@ namespace Vega
             m_QueueCompleteSemaphores.resize(maxFramesInFlight);
             m_InFlightFences.resize(maxFramesInFlight);
 
-            m_StagingBuffers.reserve(maxFramesInFlight);
             for (uint32_t i = 0; i < maxFramesInFlight; ++i)
             {
                 VkSemaphoreCreateInfo semaphoreCreateInfo = {
@@ -248,25 +303,21 @@ namespace Vega
                 };
 
                 VK_CHECK(vkCreateFence(logicalDevice, &fenceCreateInfo, m_VkContext.VkAllocator, &m_InFlightFences[i]));
-
-                m_StagingBuffers.emplace_back(CreateRef<VulkanRenderBuffer>(RenderBufferProps {
-                    .Name = std::format("{}_staging_buffer_{}", windowTitle, i),
-                    .Type = RenderBufferType::kStaging,
-                    .ElementSize = 1,
-                    .ElementCount = 256 * 1024 * 1024,
-                    .AllocatorType = RenderBufferAllocatorType::kLinear,
-                }));
             }
         }
 
         CreateGraphicsCommandBuffer(_Window);
 
+        m_UniformRingBuffer.Create("uniform_ring_buffer", kUniformRingBufferFrameSize,
+                                   m_VkSwapchain.GetMaxFramesInFlight());
+
         VEGA_CORE_TRACE("Creating Vulkan depth buffer for window {} . . .", windowTitle);
         m_DepthBufferTextures.clear();
         m_DepthBufferTextures.reserve(m_VkSwapchain.GetImagesCount());
         for (size_t i = 0; i < m_VkSwapchain.GetImagesCount(); ++i)
         {
             Ref<VulkanTexture> depthBufferTexture = CreateRef<VulkanTexture>();
+            depthBufferTexture->SetMemoryCategory(RendererMemoryCategory::kFrameBuffer);
             depthBufferTexture->VulkanCreate(
                 std::format("{}_depth_buffer_{}", windowTitle, i),
                 TextureProps {
@@ -292,12 +343,6 @@ namespace Vega
     {
         VkDevice logicalDevice = m_VkDeviceWrapper.GetLogicalDevice();
 
-        for (Ref<VulkanRenderBuffer> stagingBuffer : m_StagingBuffers)
-        {
-            stagingBuffer->Clear();
-            stagingBuffer->Destroy();
-        }
-
         for (VkSemaphore semaphore : m_ImageAvailableSemaphores)
         {
             vkDestroySemaphore(logicalDevice, semaphore, m_VkContext.VkAllocator);
@@ -322,6 +367,14 @@ namespace Vega
         }
         m_GraphicsCommandBuffer.clear();
 
+        for (VkCommandBuffer commandBuffer : m_FramePrologueCommandBuffers)
+        {
+            vkFreeCommandBuffers(logicalDevice, m_VkDeviceWrapper.GetGraphicsCommandPool(), 1, &commandBuffer);
+        }
+        m_FramePrologueCommandBuffers.clear();
+
+        m_UniformRingBuffer.Destroy();
+
         for (Ref<VulkanTexture> depthBufferTexture : m_DepthBufferTextures)
         {
             depthBufferTexture->Destroy();
@@ -414,7 +467,14 @@ namespace Vega
 
         VK_CHECK(vkResetFences(logicalDevice, 1, &m_InFlightFences[m_CurrentFrame]));
 
-        m_StagingBuffers[m_CurrentFrame]->Clear();
+        m_StagingRingBuffer.Reclaim();
+        m_UniformRingBuffer.BeginFrame(m_CurrentFrame);
+        ProcessCompletedReadbacks();
+        ProcessShaderReloads();
+
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(logicalDevice, m_GraphicsTimelineSemaphore, &completedValue));
+        m_BindlessTextureHeap.Reclaim(completedValue);
 
         return true;
     }
@@ -426,6 +486,10 @@ namespace Vega
         CommandBufferReset(commandBuffer);
         CommandBufferBegin(commandBuffer, false, false, false);
 
+        // NOTE: Dynamic state is undefined in a new command buffer, so the defaults below are always recorded
+        GetCurrentCommandState().Reset();
+        m_BoundShader = nullptr;
+
         SetWinding();
 
         SetStencilReference(0);
@@ -445,23 +509,73 @@ namespace Vega
     {
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
         CommandBufferEnd(commandBuffer);
+
+        const VulkanCommandStateTracker& commandState = GetCurrentCommandState();
+        m_LastFrameCommandStats = {
+            .IssuedStateCommands = commandState.GetIssuedCommandCount(),
+            .SkippedStateCommands = commandState.GetSkippedCommandCount(),
+        };
     }
 
     void VulkanRendererBackend::FrameSubmit()
     {
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
 
-        VkPipelineStageFlags stageFlags[1] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        // NOTE: Ownership acquires and frame copies go to a separate command buffer submitted right before the frame
+        //       one, the frame command buffer may already be inside a rendering scope when they are issued
+        VkCommandBuffer commandBuffers[2] = { VK_NULL_HANDLE, commandBuffer };
+        uint32_t commandBufferCount = 1;
+        if (!m_PendingOwnershipAcquires.empty() || !m_PendingFrameCopies.empty())
+        {
+            commandBuffers[0] = m_FramePrologueCommandBuffers[m_CurrentFrame];
+            commandBufferCount = 2;
+
+            CommandBufferReset(commandBuffers[0]);
+            CommandBufferBegin(commandBuffers[0], true, false, false);
+            if (!m_PendingOwnershipAcquires.empty())
+            {
+                RecordOwnershipAcquires(commandBuffers[0]);
+            }
+            if (!m_PendingFrameCopies.empty())
+            {
+                RecordFrameCopies(commandBuffers[0]);
+            }
+            CommandBufferEnd(commandBuffers[0]);
+        }
+
+        // NOTE: Uploads are first read by indirect draws, vertex input or compute, so earlier frame work does not
+        //       wait for the transfer queue. Prologue copies may write the same ranges as uploads, so transfers wait
+        //       as well (write after write)
+        VkSemaphore waitSemaphores[2] = { m_ImageAvailableSemaphores[m_CurrentFrame], m_TransferTimelineSemaphore };
+        VkPipelineStageFlags stageFlags[2] = {
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT |
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        };
+        uint64_t waitValues[2] = { 0, m_TransferTimelineValue };
+
+        ++m_GraphicsTimelineValue;
+        VkSemaphore signalSemaphores[2] = { m_QueueCompleteSemaphores[m_CurrentFrame], m_GraphicsTimelineSemaphore };
+        uint64_t signalValues[2] = { 0, m_GraphicsTimelineValue };
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            .waitSemaphoreValueCount = 2,
+            .pWaitSemaphoreValues = waitValues,
+            .signalSemaphoreValueCount = 2,
+            .pSignalSemaphoreValues = signalValues,
+        };
 
         VkSubmitInfo submitInfo = {
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-            .waitSemaphoreCount = 1,
-            .pWaitSemaphores = &m_ImageAvailableSemaphores[m_CurrentFrame],
+            .pNext = &timelineSubmitInfo,
+            .waitSemaphoreCount = 2,
+            .pWaitSemaphores = waitSemaphores,
             .pWaitDstStageMask = stageFlags,
-            .commandBufferCount = 1,
-            .pCommandBuffers = &commandBuffer,
-            .signalSemaphoreCount = 1,
-            .pSignalSemaphores = &m_QueueCompleteSemaphores[m_CurrentFrame],
+            .commandBufferCount = commandBufferCount,
+            .pCommandBuffers = commandBufferCount == 2 ? commandBuffers : &commandBuffers[1],
+            .signalSemaphoreCount = 2,
+            .pSignalSemaphores = signalSemaphores,
         };
 
         VkResult result =
@@ -630,6 +744,7 @@ namespace Vega
         std::string_view windowTitle = _Window->GetTitle();
 
         m_GraphicsCommandBuffer.resize(m_VkSwapchain.GetImagesCount());
+        m_GraphicsCommandStates.resize(m_GraphicsCommandBuffer.size());
         for (size_t i = 0; i < m_GraphicsCommandBuffer.size(); ++i)
         {
             VkCommandBufferAllocateInfo commandBufferAllocateInfo = {
@@ -646,6 +761,24 @@ namespace Vega
                                      VK_OBJECT_TYPE_COMMAND_BUFFER, m_GraphicsCommandBuffer[i],
                                      std::format("{}_command_buffer_{}", windowTitle, i).c_str());
         }
+
+        m_FramePrologueCommandBuffers.resize(m_VkSwapchain.GetMaxFramesInFlight());
+        for (size_t i = 0; i < m_FramePrologueCommandBuffers.size(); ++i)
+        {
+            VkCommandBufferAllocateInfo commandBufferAllocateInfo = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .commandPool = m_VkDeviceWrapper.GetGraphicsCommandPool(),
+                .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .commandBufferCount = 1,
+            };
+
+            VK_CHECK(vkAllocateCommandBuffers(logicalDevice, &commandBufferAllocateInfo,
+                                              &m_FramePrologueCommandBuffers[i]));
+
+            VK_SET_DEBUG_OBJECT_NAME(m_VkContext.PfnSetDebugUtilsObjectNameEXT, logicalDevice,
+                                     VK_OBJECT_TYPE_COMMAND_BUFFER, m_FramePrologueCommandBuffers[i],
+                                     std::format("{}_frame_prologue_command_buffer_{}", windowTitle, i).c_str());
+        }
         VEGA_CORE_TRACE("Vulkan command buffers created.");
 
         return true;
@@ -655,6 +788,11 @@ namespace Vega
     {
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
         VkFrontFace vkWinding = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        if (!GetCurrentCommandState().SetFrontFace(vkWinding))
+        {
+            return;
+        }
+
         if (m_VkDeviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
         {
             vkCmdSetFrontFace(commandBuffer, vkWinding);
@@ -671,12 +809,22 @@ namespace Vega
 
     void VulkanRendererBackend::SetStencilReference(uint32_t _StencilReference)
     {
+        if (!GetCurrentCommandState().SetStencilReference(_StencilReference))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
         vkCmdSetStencilReference(commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, _StencilReference);
     }
 
     void VulkanRendererBackend::SetStencilCompareMask(uint32_t _StencilCompareMask)
     {
+        if (!GetCurrentCommandState().SetStencilCompareMask(_StencilCompareMask))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
         vkCmdSetStencilCompareMask(commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, _StencilCompareMask);
     }
@@ -684,6 +832,11 @@ namespace Vega
     void VulkanRendererBackend::SetStencilOp(VkStencilOp _FailOp, VkStencilOp _PassOp, VkStencilOp _DepthFailOp,
                                              VkCompareOp _CompareOp)
     {
+        if (!GetCurrentCommandState().SetStencilOp(_FailOp, _PassOp, _DepthFailOp, _CompareOp))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
 
         if (m_VkDeviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
@@ -704,12 +857,22 @@ namespace Vega
 
     void VulkanRendererBackend::SetStencilWriteMask(uint32_t _StencilWriteMask)
     {
+        if (!GetCurrentCommandState().SetStencilWriteMask(_StencilWriteMask))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
         vkCmdSetStencilWriteMask(commandBuffer, VK_STENCIL_FACE_FRONT_AND_BACK, _StencilWriteMask);
     }
 
     void VulkanRendererBackend::SetStencilTestEnabled(bool _StencilTestEnabled)
     {
+        if (!GetCurrentCommandState().SetStencilTestEnabled(_StencilTestEnabled))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
 
         if (m_VkDeviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
@@ -728,6 +891,11 @@ namespace Vega
 
     void VulkanRendererBackend::SetDepthTestEnabled(bool _DepthTestEnabled)
     {
+        if (!GetCurrentCommandState().SetDepthTestEnabled(_DepthTestEnabled))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
 
         if (m_VkDeviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
@@ -746,6 +914,11 @@ namespace Vega
 
     void VulkanRendererBackend::SetDepthWriteEnabled(bool _DepthWriteEnabled)
     {
+        if (!GetCurrentCommandState().SetDepthWriteEnabled(_DepthWriteEnabled))
+        {
+            return;
+        }
+
         VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
 
         if (m_VkDeviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
@@ -767,9 +940,114 @@ namespace Vega
         return m_GraphicsCommandBuffer[m_CurrentFrame];
     }
 
-    Ref<VulkanRenderBuffer> VulkanRendererBackend::GetCurrentStagingBuffer() const
+    VulkanStagingAllocation VulkanRendererBackend::AllocateStagingMemory(size_t _Size, bool _IncludeInFrameWorkload)
+    {
+        VEGA_CORE_ASSERT(_IncludeInFrameWorkload || IsUploadBatchActive(),
+                         "Out of frame staging memory requires an upload batch!");
+
+        // NOTE: Values of the next frame submit or of the active upload batch submit
+        VulkanStagingFence fence = { m_TransferTimelineSemaphore, m_TransferTimelineValue + 1 };
+        if (_IncludeInFrameWorkload)
+        {
+            fence = { m_GraphicsTimelineSemaphore, m_GraphicsTimelineValue + 1 };
+        }
+
+        if (_Size > m_StagingRingBuffer.GetSize() / 4)
+        {
+            return m_StagingRingBuffer.AllocateTemporary(_Size, fence);
+        }
+
+        VulkanStagingAllocation allocation;
+        while (!m_StagingRingBuffer.TryAllocate(_Size, fence, allocation))
+        {
+            // NOTE: Waiting is only possible for submitted work, a ring full of current work or of reserved staging
+            //       ranges falls back to a temporary buffer
+            VulkanStagingFence oldestFence;
+            if (!m_StagingRingBuffer.GetOldestFence(oldestFence) || oldestFence.TimelineSemaphore == VK_NULL_HANDLE)
+            {
+                return m_StagingRingBuffer.AllocateTemporary(_Size, fence);
+            }
+
+            uint64_t submittedValue = oldestFence.TimelineSemaphore == m_GraphicsTimelineSemaphore
+                                          ? m_GraphicsTimelineValue
+                                          : m_TransferTimelineValue;
+            if (oldestFence.Value > submittedValue)
+            {
+                return m_StagingRingBuffer.AllocateTemporary(_Size, fence);
+            }
+
+            VkSemaphoreWaitInfo waitInfo = {
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                .semaphoreCount = 1,
+                .pSemaphores = &oldestFence.TimelineSemaphore,
+                .pValues = &oldestFence.Value,
+            };
+            VK_CHECK(vkWaitSemaphores(m_VkDeviceWrapper.GetLogicalDevice(), &waitInfo, UINT64_MAX));
+        }
+        return allocation;
+    }
+
+    bool VulkanRendererBackend::ReserveStagingRange(size_t _Size, RenderBufferStagingRange& _OutStagingRange)
+    {
+        // NOTE: Called from worker threads, the reservation never waits for the GPU
+        VulkanStagingFence pendingFence = m_StagingRingBuffer.CreatePendingFence();
+
+        VulkanStagingAllocation allocation;
+        if (_Size > m_StagingRingBuffer.GetSize() / 4 ||
+            !m_StagingRingBuffer.TryAllocate(_Size, pendingFence, allocation))
+        {
+            allocation = m_StagingRingBuffer.AllocateTemporary(_Size, pendingFence);
+        }
+
+        {
+            std::lock_guard lock(m_StagingReservationsMutex);
+            m_StagingReservations[pendingFence.Value] = allocation;
+        }
+
+        _OutStagingRange = RenderBufferStagingRange {
+            .MappedData = allocation.MappedData,
+            .Size = _Size,
+            .Id = pendingFence.Value,
+        };
+        return true;
+    }
+
+    void VulkanRendererBackend::ReleaseStagingRange(const RenderBufferStagingRange& _StagingRange,
+                                                    bool _IncludeInFrameWorkload)
+    {
+        VEGA_CORE_ASSERT(_IncludeInFrameWorkload || IsUploadBatchActive(),
+                         "Out of frame staging range release requires an upload batch!");
+
+        VulkanStagingFence fence = { m_TransferTimelineSemaphore, m_TransferTimelineValue + 1 };
+        if (_IncludeInFrameWorkload)
+        {
+            fence = { m_GraphicsTimelineSemaphore, m_GraphicsTimelineValue + 1 };
+        }
+        ResolveStagingReservation(_StagingRange, fence);
+    }
+
+    void VulkanRendererBackend::DiscardStagingRange(const RenderBufferStagingRange& _StagingRange)
+    {
+        // NOTE: Timeline value 0 is always reached
+        ResolveStagingReservation(_StagingRange, { m_GraphicsTimelineSemaphore, 0 });
+    }
+
+    VulkanStagingAllocation VulkanRendererBackend::GetStagingReservation(const RenderBufferStagingRange& _StagingRange)
+    {
+        std::lock_guard lock(m_StagingReservationsMutex);
+        auto reservationIt = m_StagingReservations.find(_StagingRange.Id);
+        VEGA_CORE_ASSERT(reservationIt != m_StagingReservations.end(), "Staging range is not reserved!");
+        return reservationIt->second;
+    }
+
+    void VulkanRendererBackend::ResolveStagingReservation(const RenderBufferStagingRange& _StagingRange,
+                                                          const VulkanStagingFence& _Fence)
     {
-        return m_StagingBuffers[m_CurrentFrame];
+        {
+            std::lock_guard lock(m_StagingReservationsMutex);
+            m_StagingReservations.erase(_StagingRange.Id);
+        }
+        m_StagingRingBuffer.ResolvePendingFence({ VK_NULL_HANDLE, _StagingRange.Id }, _Fence);
     }
 
     void VulkanRendererBackend::BeginRendering(const glm::ivec2& _ViewportOffset, const glm::uvec2& _ViewportSize,
@@ -786,6 +1064,44 @@ namespace Vega
         vkCmdDraw(commandBuffer, 3, 1, 0, 0);
     }
 
+    void VulkanRendererBackend::DrawIndexed(uint32_t _IndexCount, uint32_t _FirstIndex, int32_t _VertexOffset)
+    {
+        VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
+        if (m_BoundShader)
+        {
+            m_BoundShader->FlushUniforms(commandBuffer);
+        }
+        vkCmdDrawIndexed(commandBuffer, _IndexCount, 1, _FirstIndex, _VertexOffset, 0);
+    }
+
+    void VulkanRendererBackend::DrawIndexedIndirect(Ref<RenderBuffer> _CommandBuffer, size_t _Offset,
+                                                    uint32_t _DrawCount)
+    {
+        VEGA_CORE_ASSERT(_CommandBuffer->GetType() == RenderBufferType::kStorage ||
+                             _CommandBuffer->GetType() == RenderBufferType::kStorageHostVisible,
+                         "DrawIndexedIndirect: Command buffer must be a storage RenderBuffer!");
+
+        VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
+        if (m_BoundShader)
+        {
+            m_BoundShader->FlushUniforms(commandBuffer);
+        }
+
+        VkBuffer vkBuffer = StaticRefCast<VulkanRenderBuffer>(_CommandBuffer)->GetVkBuffer();
+        constexpr uint32_t kStride = sizeof(VkDrawIndexedIndirectCommand);
+        if (m_VkDeviceWrapper.GetPhysicalDeviceFeatures().multiDrawIndirect)
+        {
+            vkCmdDrawIndexedIndirect(commandBuffer, vkBuffer, _Offset, _DrawCount, kStride);
+            return;
+        }
+
+        // NOTE: Without multiDrawIndirect drawCount must be 0 or 1, commands are still read by the GPU
+        for (uint32_t i = 0; i < _DrawCount; ++i)
+        {
+            vkCmdDrawIndexedIndirect(commandBuffer, vkBuffer, _Offset + i * kStride, 1, kStride);
+        }
+    }
+
     void VulkanRendererBackend::EndRendering() { VulkanEndRendering(); }
 
     void VulkanRendererBackend::VulkanBeginRendering(
@@ -855,6 +1171,7 @@ namespace Vega
         {
             m_VkContext.VkCmdBeginRenderingKHR(commandBuffer, &renderInfo);
         }
+        m_IsRendering = true;
     }
 
     void VulkanRendererBackend::VulkanEndRendering()
@@ -869,6 +1186,7 @@ namespace Vega
         {
             m_VkContext.VkCmdEndRenderingKHR(commandBuffer);
         }
+        m_IsRendering = false;
     }
 
     // NOTE: may need to separate to set viewport and set scissor
@@ -992,6 +1310,281 @@ namespace Vega
         vkFreeCommandBuffers(m_VkDeviceWrapper.GetLogicalDevice(), _CommandPool, 1, &_CommandBuffer);
     }
 
+    void VulkanRendererBackend::BeginUploadBatch()
+    {
+        if (m_UploadBatchDepth++ > 0)
+        {
+            return;
+        }
+
+        UploadBatchAcquire();
+    }
+
+    void VulkanRendererBackend::EndUploadBatch()
+    {
+        VEGA_CORE_ASSERT(m_UploadBatchDepth > 0, "EndUploadBatch called without BeginUploadBatch!");
+        if (--m_UploadBatchDepth > 0)
+        {
+            return;
+        }
+
+        UploadBatchSubmit();
+    }
+
+    void VulkanRendererBackend::UploadBatchCopyBuffer(VkBuffer _SrcBuffer, VkBuffer _DstBuffer,
+                                                      const VkBufferCopy& _CopyRegion)
+    {
+        vkCmdCopyBuffer(m_ActiveUploadBatch->CommandBuffer, _SrcBuffer, _DstBuffer, 1, &_CopyRegion);
+
+        if (!m_VkDeviceWrapper.IsTransferQueueFamilySeparate())
+        {
+            return;
+        }
+
+        const VulkanPhysicalDeviceQueueFamilyInfo& queueFamilyInfo =
+            m_VkDeviceWrapper.GetPhysicalDeviceQueueFamilyInfo();
+        m_ActiveUploadBatch->OwnershipReleases.push_back(VkBufferMemoryBarrier2 {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_2_NONE,
+            .dstAccessMask = VK_ACCESS_2_NONE,
+            .srcQueueFamilyIndex = static_cast<uint32_t>(queueFamilyInfo.TransferQueueIndex),
+            .dstQueueFamilyIndex = static_cast<uint32_t>(queueFamilyInfo.GraphicsQueueIndex),
+            .buffer = _DstBuffer,
+            .offset = _CopyRegion.dstOffset,
+            .size = _CopyRegion.size,
+        });
+    }
+
+    void VulkanRendererBackend::UploadBatchAcquire()
+    {
+        VkDevice logicalDevice = m_VkDeviceWrapper.GetLogicalDevice();
+
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(logicalDevice, m_TransferTimelineSemaphore, &completedValue));
+
+        VulkanUploadBatch* oldestUploadBatch = nullptr;
+        for (Scope<VulkanUploadBatch>& uploadBatch : m_UploadBatches)
+        {
+            if (!oldestUploadBatch || uploadBatch->TimelineValue < oldestUploadBatch->TimelineValue)
+            {
+                oldestUploadBatch = uploadBatch.get();
+            }
+        }
+
+        if (oldestUploadBatch && oldestUploadBatch->TimelineValue <= completedValue)
+        {
+            m_ActiveUploadBatch = oldestUploadBatch;
+        }
+        else if (m_UploadBatches.size() < kMaxUploadBatchesInFlight)
+        {
+            Scope<VulkanUploadBatch> uploadBatch = CreateScope<VulkanUploadBatch>();
+
+            VkCommandBufferAllocateInfo commandBufferAllocateInfo = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .commandPool = m_VkDeviceWrapper.GetTransferCommandPool(),
+                .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .commandBufferCount = 1,
+            };
+            VK_CHECK(vkAllocateCommandBuffers(logicalDevice, &commandBufferAllocateInfo, &uploadBatch->CommandBuffer));
+
+            m_ActiveUploadBatch = uploadBatch.get();
+            m_UploadBatches.push_back(std::move(uploadBatch));
+        }
+        else
+        {
+            // NOTE: Only happens when more than kMaxUploadBatchesInFlight batches are streamed in a single frame
+            VkSemaphoreWaitInfo waitInfo = {
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                .semaphoreCount = 1,
+                .pSemaphores = &m_TransferTimelineSemaphore,
+                .pValues = &oldestUploadBatch->TimelineValue,
+            };
+            VK_CHECK(vkWaitSemaphores(logicalDevice, &waitInfo, UINT64_MAX));
+            m_ActiveUploadBatch = oldestUploadBatch;
+        }
+
+        m_ActiveUploadBatch->OwnershipReleases.clear();
+
+        CommandBufferReset(m_ActiveUploadBatch->CommandBuffer);
+        CommandBufferBegin(m_ActiveUploadBatch->CommandBuffer, true, false, false);
+    }
+
+    void VulkanRendererBackend::UploadBatchSubmit()
+    {
+        VkCommandBuffer commandBuffer = m_ActiveUploadBatch->CommandBuffer;
+        std::vector<VkBufferMemoryBarrier2>& ownershipReleases = m_ActiveUploadBatch->OwnershipReleases;
+
+        if (!ownershipReleases.empty())
+        {
+            VkDependencyInfo dependencyInfo = {
+                .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                .bufferMemoryBarrierCount = static_cast<uint32_t>(ownershipReleases.size()),
+                .pBufferMemoryBarriers = ownershipReleases.data(),
+            };
+            vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+            for (const VkBufferMemoryBarrier2& ownershipRelease : ownershipReleases)
+            {
+                VkBufferMemoryBarrier2 ownershipAcquire = ownershipRelease;
+                ownershipAcquire.srcStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                                                VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT |
+                                                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+                ownershipAcquire.srcAccessMask = VK_ACCESS_2_NONE;
+                ownershipAcquire.dstStageMask =
+                    VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT |
+                    VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+                ownershipAcquire.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT |
+                                                 VK_ACCESS_2_UNIFORM_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT |
+                                                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                                                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+                m_PendingOwnershipAcquires.push_back(ownershipAcquire);
+            }
+        }
+
+        CommandBufferEnd(commandBuffer);
+
+        // NOTE: No wait on the graphics queue, RenderBuffer reuses freed ranges only after frames that read them
+        //       are finished, so copies never overwrite data in use
+        uint64_t signalValue = ++m_TransferTimelineValue;
+        m_ActiveUploadBatch->TimelineValue = signalValue;
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {
+            .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+            .signalSemaphoreValueCount = 1,
+            .pSignalSemaphoreValues = &signalValue,
+        };
+
+        VkSubmitInfo submitInfo = {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .pNext = &timelineSubmitInfo,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &m_TransferTimelineSemaphore,
+        };
+
+        VK_CHECK(vkQueueSubmit(m_VkDeviceWrapper.GetTransferQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+
+        m_ActiveUploadBatch = nullptr;
+    }
+
+    void VulkanRendererBackend::RecordOwnershipAcquires(VkCommandBuffer _CommandBuffer)
+    {
+        VkDependencyInfo dependencyInfo = {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .bufferMemoryBarrierCount = static_cast<uint32_t>(m_PendingOwnershipAcquires.size()),
+            .pBufferMemoryBarriers = m_PendingOwnershipAcquires.data(),
+        };
+        vkCmdPipelineBarrier2(_CommandBuffer, &dependencyInfo);
+
+        m_PendingOwnershipAcquires.clear();
+    }
+
+    void VulkanRendererBackend::QueueFrameCopyBuffer(VkBuffer _SrcBuffer, VkBuffer _DstBuffer,
+                                                     const VkBufferCopy& _CopyRegion,
+                                                     VkPipelineStageFlags2 _DstStageMask, VkAccessFlags2 _DstAccessMask)
+    {
+        // NOTE: Regions of one vkCmdCopyBuffer must not overlap, so an overlapping copy waits for the earlier one
+        uint32_t generation = 0;
+        for (const VulkanFrameCopy& frameCopy : m_PendingFrameCopies)
+        {
+            if (frameCopy.DstBuffer == _DstBuffer &&
+                frameCopy.Region.dstOffset < _CopyRegion.dstOffset + _CopyRegion.size &&
+                _CopyRegion.dstOffset < frameCopy.Region.dstOffset + frameCopy.Region.size)
+            {
+                generation = std::max(generation, frameCopy.Generation + 1);
+            }
+        }
+
+        m_PendingFrameCopies.push_back(VulkanFrameCopy {
+            .SrcBuffer = _SrcBuffer,
+            .DstBuffer = _DstBuffer,
+            .Region = _CopyRegion,
+            .Generation = generation,
+        });
+        m_PendingFrameCopyDstStageMask |= _DstStageMask;
+        m_PendingFrameCopyDstAccessMask |= _DstAccessMask;
+    }
+
+    void VulkanRendererBackend::DiscardFrameCopies(VkBuffer _DstBuffer)
+    {
+        std::erase_if(m_PendingFrameCopies,
+                      [_DstBuffer](const VulkanFrameCopy& _FrameCopy) { return _FrameCopy.DstBuffer == _DstBuffer; });
+    }
+
+    void VulkanRendererBackend::RecordFrameCopies(VkCommandBuffer _CommandBuffer)
+    {
+        // NOTE: Earlier frames may still read the destinations (write after read needs only an execution dependency)
+        VkMemoryBarrier2 barrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = m_PendingFrameCopyDstStageMask,
+            .srcAccessMask = VK_ACCESS_2_NONE,
+            .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .dstAccessMask = VK_ACCESS_2_NONE,
+        };
+        VkDependencyInfo dependencyInfo = {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &barrier,
+        };
+        vkCmdPipelineBarrier2(_CommandBuffer, &dependencyInfo);
+
+        std::sort(m_PendingFrameCopies.begin(), m_PendingFrameCopies.end(),
+                  [](const VulkanFrameCopy& _Lhs, const VulkanFrameCopy& _Rhs) {
+                      return std::tie(_Lhs.Generation, _Lhs.DstBuffer, _Lhs.SrcBuffer, _Lhs.Region.dstOffset) <
+                             std::tie(_Rhs.Generation, _Rhs.DstBuffer, _Rhs.SrcBuffer, _Rhs.Region.dstOffset);
+                  });
+
+        for (size_t first = 0; first < m_PendingFrameCopies.size();)
+        {
+            const VulkanFrameCopy& firstCopy = m_PendingFrameCopies[first];
+            if (firstCopy.Generation > 0 && m_PendingFrameCopies[first - 1].Generation != firstCopy.Generation)
+            {
+                barrier = {
+                    .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                    .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                    .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                    .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                };
+                vkCmdPipelineBarrier2(_CommandBuffer, &dependencyInfo);
+            }
+
+            m_FrameCopyRegions.clear();
+            size_t last = first;
+            for (; last < m_PendingFrameCopies.size(); ++last)
+            {
+                const VulkanFrameCopy& frameCopy = m_PendingFrameCopies[last];
+                if (frameCopy.Generation != firstCopy.Generation || frameCopy.DstBuffer != firstCopy.DstBuffer ||
+                    frameCopy.SrcBuffer != firstCopy.SrcBuffer)
+                {
+                    break;
+                }
+                m_FrameCopyRegions.push_back(frameCopy.Region);
+            }
+
+            vkCmdCopyBuffer(_CommandBuffer, firstCopy.SrcBuffer, firstCopy.DstBuffer,
+                            static_cast<uint32_t>(m_FrameCopyRegions.size()), m_FrameCopyRegions.data());
+            first = last;
+        }
+
+        barrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .dstStageMask = m_PendingFrameCopyDstStageMask,
+            .dstAccessMask = m_PendingFrameCopyDstAccessMask,
+        };
+        vkCmdPipelineBarrier2(_CommandBuffer, &dependencyInfo);
+
+        m_PendingFrameCopies.clear();
+        m_PendingFrameCopyDstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        m_PendingFrameCopyDstAccessMask = VK_ACCESS_2_NONE;
+    }
+
     Ref<Texture> VulkanRendererBackend::CreateTexture(std::string_view _Name, const TextureProps& _Props)
     {
         Ref<VulkanTexture> texture = CreateRef<VulkanTexture>();
@@ -1022,6 +1615,284 @@ namespace Vega
         return renderBuffer;
     }
 
+    std::future<std::vector<uint8_t>> VulkanRendererBackend::ReadbackRenderBuffer(Ref<RenderBuffer> _RenderBuffer,
+                                                                                  size_t _Offset, size_t _Size)
+    {
+        VEGA_CORE_ASSERT(_Offset + _Size <= _RenderBuffer->GetSize(), "Readback range is out of buffer bounds!");
+        VEGA_CORE_ASSERT(!m_IsRendering, "Readbacks must be recorded outside of rendering!");
+
+        Ref<VulkanRenderBuffer> renderBuffer = std::static_pointer_cast<VulkanRenderBuffer>(_RenderBuffer);
+        VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
+        Ref<VulkanRenderBuffer> readBuffer = AcquireReadbackBuffer(_Size);
+
+        // NOTE: Waits only for the stages that can write the source inside the frame (copies and storage writes)
+        VkMemoryBarrier2 srcBarrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = renderBuffer->GetWriteStageMask(),
+            .srcAccessMask = renderBuffer->GetWriteAccessMask(),
+            .dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+        };
+        VkDependencyInfo srcDependencyInfo = {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &srcBarrier,
+        };
+        vkCmdPipelineBarrier2(commandBuffer, &srcDependencyInfo);
+
+        VkBufferCopy copyRegion = {
+            .srcOffset = _Offset,
+            .dstOffset = 0,
+            .size = _Size,
+        };
+        vkCmdCopyBuffer(commandBuffer, renderBuffer->GetVkBuffer(), readBuffer->GetVkBuffer(), 1, &copyRegion);
+
+        return AddPendingReadback(readBuffer, _Size);
+    }
+
+    std::future<std::vector<uint8_t>> VulkanRendererBackend::ReadbackTexture(Ref<Texture> _Texture)
+    {
+        VEGA_CORE_ASSERT(!m_IsRendering, "Readbacks must be recorded outside of rendering!");
+
+        Ref<VulkanTexture> texture = std::static_pointer_cast<VulkanTexture>(_Texture);
+
+        // NOTE: Channel count does not describe the texel size (e.g. D24S8 depth is copied as 32 bits per texel)
+        VkImageAspectFlagBits aspect = VulkanFormatReadbackAspect(texture->GetVkFormat());
+        uint32_t texelSize = VulkanFormatTexelSize(texture->GetVkFormat(), aspect);
+        if (texelSize == 0)
+        {
+            VEGA_CORE_ERROR("Readback of texture format {} is not supported", static_cast<int>(texture->GetVkFormat()));
+            return {};
+        }
+        size_t size = static_cast<size_t>(texture->GetWidth()) * texture->GetHeight() * texelSize;
+
+        VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
+        Ref<VulkanRenderBuffer> readBuffer = AcquireReadbackBuffer(size);
+
+        VkImageLayout previousLayout = texture->GetCurrentLayout();
+        texture->TransitionImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, commandBuffer);
+
+        VkBufferImageCopy copyRegion = {
+            .bufferOffset = 0,
+            .bufferRowLength = 0,
+            .bufferImageHeight = 0,
+            .imageSubresource = {
+                .aspectMask = static_cast<VkImageAspectFlags>(aspect),
+                .mipLevel = 0,
+                .baseArrayLayer = 0,
+                .layerCount = 1,
+            },
+            .imageOffset = { 0, 0, 0 },
+            .imageExtent = { texture->GetWidth(), texture->GetHeight(), 1 },
+        };
+        vkCmdCopyImageToBuffer(commandBuffer, texture->GetTextureVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               readBuffer->GetVkBuffer(), 1, &copyRegion);
+
+        if (previousLayout != VK_IMAGE_LAYOUT_UNDEFINED)
+        {
+            texture->TransitionImageLayout(previousLayout, commandBuffer);
+        }
+
+        return AddPendingReadback(readBuffer, size);
+    }
+
+    uint64_t VulkanRendererBackend::GetCompletedFrameNumber() const
+    {
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(m_VkDeviceWrapper.GetLogicalDevice(), m_GraphicsTimelineSemaphore,
+                                            &completedValue));
+        return completedValue;
+    }
+
+    RendererMemoryStats VulkanRendererBackend::GetMemoryStats() const
+    {
+        RendererMemoryStats stats;
+        m_VkDeviceWrapper.GetMemoryAllocator().GetStats(stats);
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget;
+        stats.IsBudgetAvailable = m_VkDeviceWrapper.QueryMemoryBudget(budget);
+        if (stats.IsBudgetAvailable)
+        {
+            for (size_t heapIndex = 0; heapIndex < stats.Heaps.size(); ++heapIndex)
+            {
+                stats.Heaps[heapIndex].Usage = budget.heapUsage[heapIndex];
+                stats.Heaps[heapIndex].Budget = budget.heapBudget[heapIndex];
+            }
+        }
+
+        return stats;
+    }
+
+    Ref<VulkanRenderBuffer> VulkanRendererBackend::AcquireReadbackBuffer(size_t _Size)
+    {
+        auto bufferIt =
+            std::find_if(m_FreeReadbackBuffers.begin(), m_FreeReadbackBuffers.end(),
+                         [_Size](const Ref<VulkanRenderBuffer>& readBuffer) { return readBuffer->GetSize() >= _Size; });
+        if (bufferIt != m_FreeReadbackBuffers.end())
+        {
+            Ref<VulkanRenderBuffer> readBuffer = *bufferIt;
+            m_FreeReadbackBuffers.erase(bufferIt);
+            return readBuffer;
+        }
+
+        // NOTE: Rounded up to a power of two so buffers are reused by readbacks of similar sizes
+        size_t bufferSize = kMinReadbackBufferSize;
+        while (bufferSize < _Size)
+        {
+            bufferSize *= 2;
+        }
+
+        return CreateRef<VulkanRenderBuffer>(RenderBufferProps {
+            .Name = std::format("readback_buffer_{}", m_ReadbackBufferCounter++),
+            .Type = RenderBufferType::kRead,
+            .ElementSize = 1,
+            .ElementCount = bufferSize,
+        });
+    }
+
+    std::future<std::vector<uint8_t>> VulkanRendererBackend::AddPendingReadback(Ref<VulkanRenderBuffer> _ReadBuffer,
+                                                                                size_t _Size)
+    {
+        VkCommandBuffer commandBuffer = GetCurrentGraphicsCommandBuffer();
+
+        VkMemoryBarrier2 hostBarrier = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT,
+            .dstAccessMask = VK_ACCESS_2_HOST_READ_BIT,
+        };
+        VkDependencyInfo hostDependencyInfo = {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .memoryBarrierCount = 1,
+            .pMemoryBarriers = &hostBarrier,
+        };
+        vkCmdPipelineBarrier2(commandBuffer, &hostDependencyInfo);
+
+        VulkanPendingReadback& pendingReadback = m_PendingReadbacks.emplace_back(VulkanPendingReadback {
+            .ReadBuffer = _ReadBuffer,
+            .Size = _Size,
+            .TimelineValue = GetCurrentFrameNumber(),
+        });
+        return pendingReadback.Promise.get_future();
+    }
+
+    void VulkanRendererBackend::ProcessCompletedReadbacks()
+    {
+        if (m_PendingReadbacks.empty())
+        {
+            return;
+        }
+
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(m_VkDeviceWrapper.GetLogicalDevice(), m_GraphicsTimelineSemaphore,
+                                            &completedValue));
+
+        for (auto readbackIt = m_PendingReadbacks.begin(); readbackIt != m_PendingReadbacks.end();)
+        {
+            if (readbackIt->TimelineValue > completedValue)
+            {
+                ++readbackIt;
+                continue;
+            }
+
+            const uint8_t* mappedData = static_cast<const uint8_t*>(readbackIt->ReadBuffer->GetMappedData());
+            readbackIt->Promise.set_value(std::vector<uint8_t>(mappedData, mappedData + readbackIt->Size));
+
+            m_FreeReadbackBuffers.push_back(readbackIt->ReadBuffer);
+            readbackIt = m_PendingReadbacks.erase(readbackIt);
+        }
+    }
+
+    void VulkanRendererBackend::RegisterReloadableShader(VulkanShader* _Shader)
+    {
+        if (std::find(m_ReloadableShaders.begin(), m_ReloadableShaders.end(), _Shader) == m_ReloadableShaders.end())
+        {
+            m_ReloadableShaders.push_back(_Shader);
+        }
+    }
+
+    void VulkanRendererBackend::UnregisterReloadableShader(VulkanShader* _Shader)
+    {
+        std::erase(m_ReloadableShaders, _Shader);
+    }
+
+    void VulkanRendererBackend::RetireShaderObjects(VulkanRetiredShaderObjects&& _Objects)
+    {
+        // NOTE: The frame being recorded may still reference the objects, so wait for it as well
+        _Objects.TimelineValue = GetCurrentFrameNumber();
+        m_RetiredShaderObjects.push_back(std::move(_Objects));
+    }
+
+    void VulkanRendererBackend::ProcessShaderReloads()
+    {
+        std::vector<std::filesystem::path> changedFiles;
+        m_ShaderFileWatcher->PollChangedFiles(changedFiles);
+
+        for (const std::filesystem::path& changedFile : changedFiles)
+        {
+            for (VulkanShader* shader : m_ReloadableShaders)
+            {
+                if (shader->IsUsingSourceFile(changedFile))
+                {
+                    shader->RequestReload();
+                }
+            }
+        }
+
+        for (VulkanShader* shader : m_ReloadableShaders)
+        {
+            shader->ProcessReload();
+        }
+
+        DestroyRetiredShaderObjects(false);
+    }
+
+    void VulkanRendererBackend::DestroyRetiredShaderObjects(bool _IsDeviceIdle)
+    {
+        if (m_RetiredShaderObjects.empty())
+        {
+            return;
+        }
+
+        VkDevice logicalDevice = m_VkDeviceWrapper.GetLogicalDevice();
+
+        uint64_t completedValue = UINT64_MAX;
+        if (!_IsDeviceIdle)
+        {
+            VK_CHECK(vkGetSemaphoreCounterValue(logicalDevice, m_GraphicsTimelineSemaphore, &completedValue));
+        }
+
+        std::erase_if(m_RetiredShaderObjects, [&](const VulkanRetiredShaderObjects& _Objects) {
+            if (_Objects.TimelineValue > completedValue)
+            {
+                return false;
+            }
+
+            for (VkPipeline pipeline : _Objects.Pipelines)
+            {
+                vkDestroyPipeline(logicalDevice, pipeline, m_VkContext.VkAllocator);
+            }
+            for (VkPipelineLayout pipelineLayout : _Objects.PipelineLayouts)
+            {
+                vkDestroyPipelineLayout(logicalDevice, pipelineLayout, m_VkContext.VkAllocator);
+            }
+            for (VkShaderModule shaderModule : _Objects.ShaderModules)
+            {
+                vkDestroyShaderModule(logicalDevice, shaderModule, m_VkContext.VkAllocator);
+            }
+            for (VkDescriptorSetLayout setLayout : _Objects.DescriptorSetLayouts)
+            {
+                vkDestroyDescriptorSetLayout(logicalDevice, setLayout, m_VkContext.VkAllocator);
+            }
+            for (VkDescriptorPool descriptorPool : _Objects.DescriptorPools)
+            {
+                vkDestroyDescriptorPool(logicalDevice, descriptorPool, m_VkContext.VkAllocator);
+            }
+            return true;
+        });
+    }
+
     Ref<VulkanTexture> VulkanRendererBackend::GetCurrentColorTexture() const
     {
         return m_VkSwapchain.GetVulkanColorTextures()[m_ImageIndex];
@@ -1,19 +1,83 @@
 #pragma once
 
 #include "Vega/Renderer/RendererBackend.hpp"
+#include "Vega/Utils/FileWatcher.hpp"
 #include "VulkanBase.hpp"
+#include "VulkanBindlessTextureHeap.hpp"
+#include "VulkanCommandStateTracker.hpp"
 #include "VulkanDeviceWrapper.hpp"
 #include "VulkanRenderBuffer.hpp"
+#include "VulkanPipelineCache.hpp"
+#include "VulkanPipelineStateCache.hpp"
+#include "VulkanShaderBuildQueue.hpp"
+#include "VulkanShaderCache.hpp"
+#include "VulkanStagingRingBuffer.hpp"
 #include "VulkanSwapchain.hpp"
+#include "VulkanUniformRingBuffer.hpp"
 
+#include <future>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <vulkan/vulkan_core.h>
 
 namespace Vega
 {
 
+    class VulkanShader;
+
+    struct VulkanUploadBatch
+    {
+        VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+
+        // NOTE: Transfer timeline value signaled when the batch is done, the command buffer is free after it
+        uint64_t TimelineValue = 0;
+
+        std::vector<VkBufferMemoryBarrier2> OwnershipReleases;
+    };
+
+    struct VulkanFrameCopy
+    {
+        VkBuffer SrcBuffer;
+        VkBuffer DstBuffer;
+        VkBufferCopy Region;
+
+        // NOTE: Copies overlapping an earlier queued destination range go to a later generation to keep their order
+        uint32_t Generation;
+    };
+
+    struct VulkanPendingReadback
+    {
+        Ref<VulkanRenderBuffer> ReadBuffer;
+        size_t Size;
+
+        // NOTE: Graphics timeline value signaled by the frame that records the copy
+        uint64_t TimelineValue;
+
+        std::promise<std::vector<uint8_t>> Promise;
+    };
+
+    // NOTE: Objects replaced by a shader reload, destroyed once no submitted frame can use them
+    struct VulkanRetiredShaderObjects
+    {
+        std::vector<VkPipeline> Pipelines;
+        std::vector<VkPipelineLayout> PipelineLayouts;
+        std::vector<VkShaderModule> ShaderModules;
+        std::vector<VkDescriptorSetLayout> DescriptorSetLayouts;
+        std::vector<VkDescriptorPool> DescriptorPools;
+
+        // NOTE: Graphics timeline value signaled by the last frame that may use the objects
+        uint64_t TimelineValue = 0;
+    };
+
     class VulkanRendererBackend : public RendererBackend
     {
+    public:
+        static constexpr size_t kStagingRingBufferSize = 64 * 1024 * 1024;
+        static constexpr size_t kMaxUploadBatchesInFlight = 4;
+        static constexpr size_t kUniformRingBufferFrameSize = 4 * 1024 * 1024;
+        static constexpr size_t kMinReadbackBufferSize = 64 * 1024;
+
     public:
         VulkanRendererBackend();
         virtual ~VulkanRendererBackend() = default;
@@ -70,10 +134,53 @@ namespace Vega
         inline const VulkanSwapchain& GetVkSwapchain() const { return m_VkSwapchain; }
 
         VkCommandBuffer GetCurrentGraphicsCommandBuffer() const;
-        Ref<VulkanRenderBuffer> GetCurrentStagingBuffer() const;
+
+        /**
+         * @brief Allocates host visible staging memory for a copy.
+         *
+         * The memory stays reserved until the frame (_IncludeInFrameWorkload) or the active upload batch that reads it
+         * is completed on the GPU. Uploads that do not fit the staging ring get a temporary buffer instead.
+         *
+         * @return VulkanStagingAllocation Persistently mapped staging range of _Size bytes.
+         */
+        VulkanStagingAllocation AllocateStagingMemory(size_t _Size, bool _IncludeInFrameWorkload);
+
+        bool ReserveStagingRange(size_t _Size, RenderBufferStagingRange& _OutStagingRange) override;
+        void ReleaseStagingRange(const RenderBufferStagingRange& _StagingRange, bool _IncludeInFrameWorkload) override;
+        void DiscardStagingRange(const RenderBufferStagingRange& _StagingRange) override;
+        VulkanStagingAllocation GetStagingReservation(const RenderBufferStagingRange& _StagingRange);
+
+        inline VulkanUniformRingBuffer& GetUniformRingBuffer() { return m_UniformRingBuffer; }
+        inline VulkanShaderCache& GetShaderCache() { return m_ShaderCache; }
+        inline VulkanShaderBuildQueue& GetShaderBuildQueue() { return m_ShaderBuildQueue; }
+        inline VkPipelineCache GetVkPipelineCache() const { return m_PipelineCache.GetVkPipelineCache(); }
+        inline VulkanPipelineStateCache& GetPipelineStateCache() { return m_PipelineStateCache; }
+        inline VulkanBindlessTextureHeap& GetBindlessTextureHeap() { return m_BindlessTextureHeap; }
+
+        // NOTE: State recorded into the current graphics command buffer, used to skip redundant commands
+        inline VulkanCommandStateTracker& GetCurrentCommandState() { return m_GraphicsCommandStates[m_CurrentFrame]; }
+        inline FileWatcher& GetShaderFileWatcher() { return *m_ShaderFileWatcher; }
+
+        // NOTE: Registered shaders are reloaded when one of their source files changes
+        void RegisterReloadableShader(VulkanShader* _Shader);
+        void UnregisterReloadableShader(VulkanShader* _Shader);
+
+        /**
+         * @brief Defers destruction of shader objects until the frames in flight are finished with them.
+         *
+         * Never waits for the device, the objects are destroyed at a later frame boundary.
+         */
+        void RetireShaderObjects(VulkanRetiredShaderObjects&& _Objects);
+
+        // NOTE: Shader bound in the recorded frame, its uniforms are flushed before every draw
+        inline void SetBoundShader(VulkanShader* _Shader) { m_BoundShader = _Shader; }
+        inline VulkanShader* GetBoundShader() const { return m_BoundShader; }
 
         uint32_t GetCurrentImageIndex() const { return m_ImageIndex; }
         uint32_t GetCurrentFrameIndex() const { return m_CurrentFrame; }
+        // NOTE: Unique number of the frame being recorded, equals the graphics timeline value it signals on submit
+        uint64_t GetCurrentFrameNumber() const override { return m_GraphicsTimelineValue + 1; }
+        uint64_t GetCompletedFrameNumber() const override;
 
         // TODO: add color and depth/stencil attachments in other way ?
         void BeginRendering(const glm::ivec2& _ViewportOffset, const glm::uvec2& _ViewportSize,
@@ -81,6 +188,9 @@ namespace Vega
 
         void TestFoo() override;
 
+        void DrawIndexed(uint32_t _IndexCount, uint32_t _FirstIndex, int32_t _VertexOffset) override;
+        void DrawIndexedIndirect(Ref<RenderBuffer> _CommandBuffer, size_t _Offset, uint32_t _DrawCount) override;
+
         void EndRendering() override;
 
         void VulkanBeginRendering(const glm::ivec2& _ViewportOffset, const glm::uvec2& _ViewportSize,
@@ -104,6 +214,33 @@ namespace Vega
         void DestroyAndEndSingleUseCommandBuffer(VkCommandBuffer _CommandBuffer, VkQueue _Queue,
                                                  VkCommandPool _CommandPool);
 
+        void BeginUploadBatch() override;
+        void EndUploadBatch() override;
+
+        inline bool IsUploadBatchActive() const { return m_ActiveUploadBatch != nullptr; }
+
+        /**
+         * @brief Records a buffer copy into the active upload batch.
+         *
+         * Upload batches are executed on the transfer queue without blocking the CPU. The next frame submitted
+         * after the batch waits for it on the GPU, queue family ownership of the copied range is transferred to
+         * the graphics queue family when the transfer queue family is separate.
+         */
+        void UploadBatchCopyBuffer(VkBuffer _SrcBuffer, VkBuffer _DstBuffer, const VkBufferCopy& _CopyRegion);
+
+        /**
+         * @brief Queues a buffer copy into the current frame.
+         *
+         * Queued copies are recorded on submit into the frame prologue command buffer, one vkCmdCopyBuffer per
+         * source/destination pair with all of its regions, followed by a single barrier to _DstStageMask and
+         * _DstAccessMask of all queued copies. The written data is visible to the whole frame, if a range is written
+         * several times in one frame the last write wins.
+         */
+        void QueueFrameCopyBuffer(VkBuffer _SrcBuffer, VkBuffer _DstBuffer, const VkBufferCopy& _CopyRegion,
+                                  VkPipelineStageFlags2 _DstStageMask, VkAccessFlags2 _DstAccessMask);
+        // NOTE: Drops queued copies into a buffer that is going to be destroyed
+        void DiscardFrameCopies(VkBuffer _DstBuffer);
+
         Ref<Texture> CreateTexture(std::string_view _Name, const TextureProps& _Props) override;
         Ref<Texture> CreateTexture(std::string_view _Name, TextureProps _Props, uint8_t* _Data) override;
 
@@ -111,6 +248,13 @@ namespace Vega
 
         Ref<RenderBuffer> CreateRenderBuffer(const RenderBufferProps& _Props) override;
 
+        std::future<std::vector<uint8_t>> ReadbackRenderBuffer(Ref<RenderBuffer> _RenderBuffer, size_t _Offset,
+                                                               size_t _Size) override;
+        std::future<std::vector<uint8_t>> ReadbackTexture(Ref<Texture> _Texture) override;
+
+        RendererMemoryStats GetMemoryStats() const override;
+        RendererCommandStats GetCommandStats() const override { return m_LastFrameCommandStats; }
+
         /**
          * @brief Retrieves the singleton instance of the VulkanRendererBackend.
          *
@@ -143,6 +287,21 @@ namespace Vega
         void CommandBufferEnd(VkCommandBuffer _VkCommandBuffer);
         void CommandBufferUpdateSubmited(VkCommandBuffer _VkCommandBuffer);
 
+        void UploadBatchAcquire();
+        void UploadBatchSubmit();
+        void RecordOwnershipAcquires(VkCommandBuffer _CommandBuffer);
+        void RecordFrameCopies(VkCommandBuffer _CommandBuffer);
+
+        void ResolveStagingReservation(const RenderBufferStagingRange& _StagingRange, const VulkanStagingFence& _Fence);
+
+        // NOTE: kRead buffers are pooled, destroying a render buffer waits for the device
+        Ref<VulkanRenderBuffer> AcquireReadbackBuffer(size_t _Size);
+        std::future<std::vector<uint8_t>> AddPendingReadback(Ref<VulkanRenderBuffer> _ReadBuffer, size_t _Size);
+        void ProcessCompletedReadbacks();
+
+        void ProcessShaderReloads();
+        void DestroyRetiredShaderObjects(bool _IsDeviceIdle);
+
     private:
         static void VerifyRequiredExtensions(const std::vector<const char*>& _RequiredExtensions);
 
@@ -161,22 +320,66 @@ namespace Vega
 
         VulkanSwapchain m_VkSwapchain;
         std::vector<VkCommandBuffer> m_GraphicsCommandBuffer;
+        std::vector<VulkanCommandStateTracker> m_GraphicsCommandStates;
+        RendererCommandStats m_LastFrameCommandStats;
 
         std::vector<VkSemaphore> m_ImageAvailableSemaphores;
         std::vector<VkSemaphore> m_QueueCompleteSemaphores;
         std::vector<VkFence> m_InFlightFences;
 
-        std::vector<Ref<VulkanRenderBuffer>> m_StagingBuffers;
+        VulkanStagingRingBuffer m_StagingRingBuffer;
+        // NOTE: Staging ranges reserved through ReserveStagingRange, keyed by the id of their pending fence
+        std::unordered_map<uint64_t, VulkanStagingAllocation> m_StagingReservations;
+        std::mutex m_StagingReservationsMutex;
+        VulkanUniformRingBuffer m_UniformRingBuffer;
+        VulkanShaderCache m_ShaderCache;
+        VulkanShaderBuildQueue m_ShaderBuildQueue;
+        VulkanPipelineCache m_PipelineCache;
+        VulkanPipelineStateCache m_PipelineStateCache;
+        VulkanBindlessTextureHeap m_BindlessTextureHeap;
+
+        VulkanShader* m_BoundShader = nullptr;
 
         std::vector<Ref<VulkanTexture>> m_DepthBufferTextures;
 
         bool m_IsNeedRecreateSwapchain = false;
+        // NOTE: Transfer commands (readbacks) are invalid inside a dynamic rendering scope
+        bool m_IsRendering = false;
 
         uint32_t m_CurrentFrame = 0;
         uint32_t m_ImageIndex = 0;
 
         VkDescriptorPool m_ImGuiDescriptorPool = nullptr;
 
+        std::vector<Scope<VulkanUploadBatch>> m_UploadBatches;
+        VulkanUploadBatch* m_ActiveUploadBatch = nullptr;
+        uint32_t m_UploadBatchDepth = 0;
+
+        // NOTE: Transfer timeline is signaled by upload batches, graphics timeline by frame submits
+        VkSemaphore m_TransferTimelineSemaphore = VK_NULL_HANDLE;
+        uint64_t m_TransferTimelineValue = 0;
+        VkSemaphore m_GraphicsTimelineSemaphore = VK_NULL_HANDLE;
+        uint64_t m_GraphicsTimelineValue = 0;
+
+        // NOTE: Acquire halves of ownership transfers released by submitted batches, recorded by the next frame
+        std::vector<VkBufferMemoryBarrier2> m_PendingOwnershipAcquires;
+
+        std::vector<VulkanFrameCopy> m_PendingFrameCopies;
+        VkPipelineStageFlags2 m_PendingFrameCopyDstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 m_PendingFrameCopyDstAccessMask = VK_ACCESS_2_NONE;
+        std::vector<VkBufferCopy> m_FrameCopyRegions;
+
+        // NOTE: Ownership acquires and queued frame copies, submitted right before the frame command buffer
+        std::vector<VkCommandBuffer> m_FramePrologueCommandBuffers;
+
+        std::vector<VulkanPendingReadback> m_PendingReadbacks;
+        std::vector<Ref<VulkanRenderBuffer>> m_FreeReadbackBuffers;
+        size_t m_ReadbackBufferCounter = 0;
+
+        Scope<FileWatcher> m_ShaderFileWatcher;
+        std::vector<VulkanShader*> m_ReloadableShaders;
+        std::vector<VulkanRetiredShaderObjects> m_RetiredShaderObjects;
+
         static inline VulkanRendererBackend* m_Instance = nullptr;
     };
 
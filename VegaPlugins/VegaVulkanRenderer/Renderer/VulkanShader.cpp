@@ -8,14 +8,20 @@
 #include "Vega/Renderer/Shader.hpp"
 #include "Vega/Utils/Log.hpp"
 #include "VulkanBase.hpp"
+#include "VulkanRenderBuffer.hpp"
 #include "VulkanRendererBackend.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <format>
 #include <fstream>
+#include <iterator>
 #include <limits>
+#include <unordered_set>
 
 #include <glm/glm.hpp>
 #include <shaderc/shaderc.h>
@@ -23,10 +29,26 @@
 #include <utility>
 #include <vulkan/vulkan_core.h>
 
+#ifndef VEGA_SHADER_COMPILER_VERSION
+    #define VEGA_SHADER_COMPILER_VERSION "unknown"
+#endif
+
 namespace Vega
 {
 
-    static std::vector<char> ReadFile(const std::string& _Filename);
+    static bool TryReadFile(const std::filesystem::path& _Path, std::vector<char>& _OutData);
+
+    static std::filesystem::path ResolveShaderIncludePath(const std::filesystem::path& _RequestingPath,
+                                                          std::string_view _RequestedPath);
+    static void CollectShaderIncludes(const std::filesystem::path& _Path, const std::vector<char>& _Source,
+                                      std::unordered_set<std::string>& _Visited,
+                                      std::vector<std::filesystem::path>& _OutIncludes);
+    static uint64_t ComputeShaderCacheKey(const std::string& _Path, const std::vector<char>& _Source,
+                                          shaderc_shader_kind _ShaderKind, const std::vector<ShaderDefine>& _Defines,
+                                          std::vector<std::filesystem::path>& _OutIncludes);
+    static bool CompileShaderSpirv(shaderc_compiler_t _Compiler, const std::string& _Path,
+                                   const std::vector<char>& _Source, shaderc_shader_kind _ShaderKind,
+                                   const std::vector<ShaderDefine>& _Defines, std::vector<uint32_t>& _OutSpirv);
 
     static VkFormat ShaderAttributeTypeToVkFormat(ShaderAttributeType _Type);
 
@@ -36,15 +58,13 @@ namespace Vega
         m_ShaderConfig = _ShaderConfig;
         m_ShaderStageConfigs = _ShaderStageConfigs;
 
-        PrepareShaderData();
+        VEGA_CORE_ASSERT(m_ShaderConfig.Keywords.size() <= kMaxShaderKeywords, "Too many shader keywords!");
     }
 
-    void VulkanShader::Initialize()
+    std::shared_future<bool> VulkanShader::Initialize()
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
-        VulkanDeviceWrapper deviceWrapper = rendererBackend->GetVkDeviceWrapper();
-        VkDevice logicalDevice = deviceWrapper.GetLogicalDevice();
-        const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
 
         bool isNeedWireframe = (m_ShaderConfig.Flags & ShaderFlagBits::kWireframe) != 0;
         if (deviceWrapper.GetPhysicalDeviceFeatures().fillModeNonSolid)
@@ -53,69 +73,6 @@ namespace Vega
             isNeedWireframe = false;
         }
 
-        uint32_t offset = 0;
-        for (ShaderAttributeType attributeType : m_ShaderConfig.Attributes)
-        {
-            m_AttributeDescriptions.emplace_back(VkVertexInputAttributeDescription {
-                .location = static_cast<uint32_t>(m_AttributeDescriptions.size()),
-                .binding = 0,
-                .format = ShaderAttributeTypeToVkFormat(attributeType),
-                .offset = offset,
-            });
-            offset += ShaderDataTypeSize(attributeType);
-        }
-
-        if (m_MaxDescriptorSetCount > 0)
-        {
-            VkDescriptorPoolCreateInfo poolInfo = {
-                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-                .pNext = nullptr,
-                .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
-                .maxSets = m_MaxDescriptorSetCount,
-                .poolSizeCount = static_cast<uint32_t>(m_PoolSizes.size()),
-                .pPoolSizes = m_PoolSizes.data(),
-            };
-
-#if defined(VK_USE_PLATFORM_MACOS_MVK)
-            // NOTE: increase the per-stage descriptor samplers limit on macOS
-            // (maxPerStageDescriptorUpdateAfterBindSamplers > maxPerStageDescriptorSamplers)
-            poolInfo.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
-#endif
-
-            VkResult createPoolResult =
-                vkCreateDescriptorPool(logicalDevice, &poolInfo, vkAllocator, &m_DescriptorPool);
-            if (!VulkanResultIsSuccess(createPoolResult))
-            {
-                VEGA_CORE_CRITICAL("Failed to create descriptor pool: {}", VulkanResultString(createPoolResult, true));
-                VEGA_CORE_ASSERT(false, "Failed to create descriptor pool!");
-            }
-
-            VK_SET_DEBUG_OBJECT_NAME(rendererBackend->GetVkContext().PfnSetDebugUtilsObjectNameEXT, logicalDevice,
-                                     VK_OBJECT_TYPE_DESCRIPTOR_POOL, m_DescriptorPool,
-                                     std::format("descriptor_pool_{}", m_ShaderConfig.Name).c_str());
-
-            for (size_t i = 0; i < m_DescriptorSets.size(); ++i)
-            {
-                VkDescriptorSetLayoutCreateInfo layoutInfo = {
-                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-                    .pNext = nullptr,
-                    .flags = 0,
-                    .bindingCount = static_cast<uint32_t>(m_DescriptorSets[i].Bindings.size()),
-                    .pBindings = m_DescriptorSets[i].Bindings.data(),
-                };
-
-                VkResult createLayoutResult =
-                    vkCreateDescriptorSetLayout(logicalDevice, &layoutInfo, vkAllocator, &m_DescriptorSetLayouts[i]);
-
-                if (!VulkanResultIsSuccess(createLayoutResult))
-                {
-                    VEGA_CORE_CRITICAL("Failed to create descriptor set layout: {}",
-                                       VulkanResultString(createLayoutResult, true));
-                    VEGA_CORE_ASSERT(false, "Failed to create descriptor set layout!");
-                }
-            }
-        }
-
         if (m_ShaderConfig.TopologyTypes & PrimitiveTopologyTypeBits::kPointList)
         {
             VulkanPipeline pipeline = {
@@ -166,13 +123,6 @@ namespace Vega
             }
         }
 
-        if (!CreateModulesAndPipelines())
-        {
-            VEGA_CORE_ERROR("Failed initial load on shader {}. See logs for details.", m_ShaderConfig.Name);
-            VEGA_CORE_ASSERT(false, "Failed initial load on shader");
-            return;
-        }
-
         m_BoundPipelineIndex = 0;
         bool pipelineFound = false;
 
@@ -184,26 +134,42 @@ namespace Vega
             break;
         }
 
+        // NOTE: Stages and pipelines are built on the shader build queue, the shader is usable once they are applied
+        m_IsReady = false;
+        m_BuildResult = CreateModulesAndPipelines();
+        rendererBackend->RegisterReloadableShader(this);
+
         if (!pipelineFound)
         {
             VEGA_CORE_ERROR("No available topology classes are available, so a pipeline cannot be bound.");
             VEGA_CORE_ASSERT(false, "No available topology classes are available, so a pipeline cannot be bound.");
-            return;
+            return m_BuildResult;
         }
 
         m_RequiredUboAlignment = deviceWrapper.GetMinUniformBufferOffsetAligment();
 
-        // TODO: Continue here : implement ubo
-
-        m_PerDrawInfo.UnoStride = 128;
+        return m_BuildResult;
     }
 
     void VulkanShader::Shutdown()
     {
+        for (auto& [mask, variant] : m_Variants)
+        {
+            variant->Shutdown();
+        }
+        m_Variants.clear();
+
+        // NOTE: Queued jobs reference this shader, the build has to be finished before anything is destroyed
+        ApplyPendingBuild(true);
+
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
         VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
         const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
 
+        rendererBackend->UnregisterReloadableShader(this);
+        UpdateSourceFiles({});
+        m_IsReloadQueued = false;
+
         for (size_t i = 0; i < m_DescriptorSets.size(); ++i)
         {
             vkDestroyDescriptorSetLayout(logicalDevice, m_DescriptorSetLayouts[i], vkAllocator);
@@ -211,30 +177,44 @@ namespace Vega
         m_DescriptorSets.clear();
         m_DescriptorSetLayouts.clear();
 
+        // NOTE: Storage buffer descriptor sets are freed together with the pool
+        m_StorageBufferBindings.clear();
+        m_StorageBufferFrameStates.clear();
+        m_StorageBufferDescriptorSet = VK_NULL_HANDLE;
+
         // TODO: clear gloabal descriptor sets ?
 
         if (m_DescriptorPool)
         {
             vkDestroyDescriptorPool(logicalDevice, m_DescriptorPool, vkAllocator);
+            m_DescriptorPool = VK_NULL_HANDLE;
         }
 
-        // TODO: clear FrequencyInfo and FrequencyState
+        if (rendererBackend->GetBoundShader() == this)
+        {
+            rendererBackend->SetBoundShader(nullptr);
+        }
 
-        // TODO: clear Uniform buffer
+        // NOTE: Uniform blocks live in the renderer wide uniform ring buffer, their sets are freed with the pool
+        m_PerFrameInfo = {};
+        m_PerGroupInfo = {};
+        m_PerDrawInfo = {};
+        m_UniformHandles.clear();
 
         vkDeviceWaitIdle(logicalDevice);
 
-        for (VulkanPipeline& pipeline : m_Pipelines)
-        {
-            DestroyGraphicsPipeline(pipeline);
-        }
-        for (VulkanPipeline& pipeline : m_WireframesPipelines)
-        {
-            DestroyGraphicsPipeline(pipeline);
-        }
+        ReleasePipelines(m_Pipelines);
+        ReleasePipelines(m_WireframesPipelines);
         m_Pipelines.clear();
         m_WireframesPipelines.clear();
 
+        if (m_PipelineLayout)
+        {
+            vkDestroyPipelineLayout(logicalDevice, m_PipelineLayout, vkAllocator);
+            m_PipelineLayout = VK_NULL_HANDLE;
+        }
+        m_AppliedBuild.reset();
+
         for (VulkanShaderStage& stage : m_ShaderStages)
         {
             vkDestroyShaderModule(logicalDevice, stage.Handle, vkAllocator);
@@ -246,23 +226,61 @@ namespace Vega
     bool VulkanShader::Bind()
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
-        VulkanDeviceWrapper deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
         VkCommandBuffer commandBuffer = rendererBackend->GetCurrentGraphicsCommandBuffer();
 
-        std::vector<VulkanPipeline>& pipelineArray =
-            m_ShaderConfig.Flags & ShaderFlagBits::kWireframe ? m_WireframesPipelines : m_Pipelines;
+        // NOTE: Nothing is drawn with the shader until its first build is applied
+        if (!IsReady())
+        {
+            return false;
+        }
+
+        bool isWireframe = m_ShaderConfig.Flags & ShaderFlagBits::kWireframe;
+        std::vector<VulkanPipeline>& pipelineArray = isWireframe ? m_WireframesPipelines : m_Pipelines;
+
+        // NOTE: The build only creates the initial pipeline, other topology classes and fill modes on first use
+        VulkanPipeline& pipeline = pipelineArray[m_BoundPipelineIndex];
+        if (!pipeline.Handle && !AcquirePipeline(m_AppliedBuild->PipelineConfigs[isWireframe ? 1 : 0], pipeline))
+        {
+            VEGA_CORE_ERROR("Failed to create graphics pipeline for shader: {}.", m_ShaderConfig.Name);
+            return false;
+        }
 
-        BindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineArray[m_BoundPipelineIndex]);
+        BindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 
-        // TODO: save bounded shader for optimizations
+        // NOTE: Uniform blocks are bound on the first draw, another shader may have disturbed their sets. Sets of a
+        //       shader that is bound again stay valid, all of its pipelines share one layout
+        bool isAlreadyBound = rendererBackend->GetBoundShader() == this;
+        if (!isAlreadyBound)
+        {
+            rendererBackend->SetBoundShader(this);
+            m_PerFrameInfo.IsNeedBind = true;
+            m_PerGroupInfo.IsNeedBind = true;
+        }
 
-        if (deviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
+        if (!m_StorageBufferBindings.empty())
         {
-            vkCmdSetPrimitiveTopology(commandBuffer, m_CurentTopology);
+            BindStorageBuffers(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineArray[m_BoundPipelineIndex]);
         }
-        else if (deviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kDynamicStateBit)
+
+        // NOTE: The heap set never changes, new textures are written into it while it stays bound
+        if (m_IsUsingBindlessTextures && !isAlreadyBound)
         {
-            rendererBackend->GetVkContext().VkCmdSetPrimitiveTopologyEXT(commandBuffer, m_CurentTopology);
+            VkDescriptorSet bindlessTextureSet = rendererBackend->GetBindlessTextureHeap().GetDescriptorSet();
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.Layout,
+                                    kBindlessTextureSetIndex, 1, &bindlessTextureSet, 0, nullptr);
+        }
+
+        if (rendererBackend->GetCurrentCommandState().SetPrimitiveTopology(m_CurentTopology))
+        {
+            if (deviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kNativeDynamicStateBit)
+            {
+                vkCmdSetPrimitiveTopology(commandBuffer, m_CurentTopology);
+            }
+            else if (deviceWrapper.GetSupportFlags() & VulkanDeviceSupportFlagBits::kDynamicStateBit)
+            {
+                rendererBackend->GetVkContext().VkCmdSetPrimitiveTopologyEXT(commandBuffer, m_CurentTopology);
+            }
         }
 
         return true;
@@ -271,202 +289,664 @@ namespace Vega
     void VulkanShader::SetUniformBufferData(std::string_view _Name, const void* _Data, size_t _Size,
                                             ShaderUpdateFrequency _Frequency)
     {
-        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
-        VkCommandBuffer commandBuffer = rendererBackend->GetCurrentGraphicsCommandBuffer();
+        // NOTE: Uniform offsets are reflected by the build, nothing can be set before the first one is applied
+        if (!m_IsReady)
+        {
+            return;
+        }
 
-        std::vector<VulkanPipeline>& pipelineArray =
-            m_ShaderConfig.Flags & ShaderFlagBits::kWireframe ? m_WireframesPipelines : m_Pipelines;
+        VulkanShaderFrequencyInfo* frequencyInfo = GetFrequencyInfo(_Frequency);
+        if (!frequencyInfo)
+        {
+            return;
+        }
 
-        if (_Frequency == ShaderUpdateFrequency::kPerDraw)
+        auto fieldIt = std::find_if(frequencyInfo->Fields.begin(), frequencyInfo->Fields.end(),
+                                    [_Name](const VulkanReflectedField& field) { return field.Name == _Name; });
+        if (fieldIt == frequencyInfo->Fields.end())
+        {
+            VEGA_CORE_ERROR("Shader {} has no uniform {}", m_ShaderConfig.Name, _Name);
+            return;
+        }
+        VEGA_CORE_ASSERT(_Size <= fieldIt->Size, "Uniform data is bigger than the uniform!");
+
+        WriteUniform(_Frequency, fieldIt->Offset, _Data, std::min<size_t>(_Size, fieldIt->Size));
+    }
+
+    ShaderUniformHandle VulkanShader::GetUniformHandle(std::string_view _Name)
+    {
+        auto handleIt =
+            std::find_if(m_UniformHandles.begin(), m_UniformHandles.end(),
+                         [_Name](const VulkanUniformHandleInfo& _HandleInfo) { return _HandleInfo.Name == _Name; });
+        if (handleIt != m_UniformHandles.end())
+        {
+            return static_cast<ShaderUniformHandle>(std::distance(m_UniformHandles.begin(), handleIt));
+        }
+
+        // NOTE: Handles requested before the first build is applied are resolved by ApplyPendingBuild
+        VulkanUniformHandleInfo& handleInfo = m_UniformHandles.emplace_back(VulkanUniformHandleInfo {
+            .Name = std::string(_Name),
+        });
+        if (m_IsReady && !ResolveUniformHandle(handleInfo))
         {
-            std::memcpy(m_LocalPushConstantsBlock, _Data, _Size);
-            vkCmdPushConstants(commandBuffer, pipelineArray[m_BoundPipelineIndex].Layout,
-                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, 128,
-                               m_LocalPushConstantsBlock);
+            VEGA_CORE_ERROR("Shader {} has no uniform {}", m_ShaderConfig.Name, _Name);
         }
 
-        VulkanShaderFrequencyInfo* frequencyInfo = nullptr;
+        return static_cast<ShaderUniformHandle>(m_UniformHandles.size() - 1);
+    }
+
+    void VulkanShader::SetUniform(ShaderUniformHandle _Handle, const void* _Data, size_t _Size)
+    {
+        if (_Handle >= m_UniformHandles.size())
+        {
+            VEGA_CORE_ASSERT(false, "Invalid uniform handle!");
+            return;
+        }
+
+        const VulkanUniformHandleInfo& handleInfo = m_UniformHandles[_Handle];
+        if (!m_IsReady || handleInfo.Size == 0)
+        {
+            return;
+        }
+        VEGA_CORE_ASSERT(_Size <= handleInfo.Size, "Uniform data is bigger than the uniform!");
+
+        WriteUniform(handleInfo.Frequency, handleInfo.Offset, _Data, std::min<size_t>(_Size, handleInfo.Size));
+    }
+
+    ShaderVariantMask VulkanShader::GetVariantMask(std::initializer_list<std::string_view> _Keywords) const
+    {
+        ShaderVariantMask mask = 0;
+        for (std::string_view keyword : _Keywords)
+        {
+            auto keywordIt =
+                std::find_if(m_ShaderConfig.Keywords.begin(), m_ShaderConfig.Keywords.end(),
+                             [keyword](const ShaderKeyword& _Keyword) { return _Keyword.Name == keyword; });
+            if (keywordIt == m_ShaderConfig.Keywords.end())
+            {
+                VEGA_CORE_ERROR("Shader {} has no keyword {}", m_ShaderConfig.Name, keyword);
+                continue;
+            }
+            mask |= ShaderVariantMask(1) << std::distance(m_ShaderConfig.Keywords.begin(), keywordIt);
+        }
+        return mask;
+    }
+
+    Shader* VulkanShader::GetVariant(ShaderVariantMask _Mask)
+    {
+        if (_Mask == m_VariantMask)
+        {
+            return this;
+        }
+        VEGA_CORE_ASSERT(m_VariantMask == 0, "Variants must be requested from the base shader!");
+
+        auto variantIt = m_Variants.find(_Mask);
+        if (variantIt != m_Variants.end())
+        {
+            return variantIt->second.get();
+        }
+
+        // NOTE: Define keywords change the source of the stages, specialization constant ones are set by the build
+        ShaderConfig variantConfig = m_ShaderConfig;
+        std::string keywordNames;
+        for (size_t i = 0; i < m_ShaderConfig.Keywords.size(); ++i)
+        {
+            if ((_Mask & (ShaderVariantMask(1) << i)) == 0)
+            {
+                continue;
+            }
+
+            const ShaderKeyword& keyword = m_ShaderConfig.Keywords[i];
+            keywordNames += keywordNames.empty() ? keyword.Name : "|" + keyword.Name;
+            if (!keyword.IsSpecializationConstant)
+            {
+                variantConfig.Defines.emplace_back(ShaderDefine { .Name = keyword.Name, .Value = "1" });
+            }
+        }
+        variantConfig.Name = std::format("{}[{}]", m_ShaderConfig.Name, keywordNames);
+
+        VEGA_CORE_TRACE("Building shader variant {}", variantConfig.Name);
+
+        Ref<VulkanShader> variant = CreateRef<VulkanShader>();
+        variant->m_ShaderConfig = std::move(variantConfig);
+        variant->m_ShaderStageConfigs = m_ShaderStageConfigs;
+        variant->m_VariantMask = _Mask;
+        variant->Initialize();
+
+        m_Variants.emplace(_Mask, variant);
+        return variant.get();
+    }
+
+    bool VulkanShader::ResolveUniformHandle(VulkanUniformHandleInfo& _InOutInfo)
+    {
+        for (ShaderUpdateFrequency frequency :
+             { ShaderUpdateFrequency::kPerFrame, ShaderUpdateFrequency::kPerGroup, ShaderUpdateFrequency::kPerDraw })
+        {
+            const VulkanShaderFrequencyInfo* frequencyInfo = GetFrequencyInfo(frequency);
+            auto fieldIt = std::find_if(
+                frequencyInfo->Fields.begin(), frequencyInfo->Fields.end(),
+                [&_InOutInfo](const VulkanReflectedField& field) { return field.Name == _InOutInfo.Name; });
+            if (fieldIt != frequencyInfo->Fields.end())
+            {
+                _InOutInfo.Frequency = frequency;
+                _InOutInfo.Offset = fieldIt->Offset;
+                _InOutInfo.Size = fieldIt->Size;
+                return true;
+            }
+        }
+
+        _InOutInfo.Size = 0;
+        return false;
+    }
+
+    VulkanShaderFrequencyInfo* VulkanShader::GetFrequencyInfo(ShaderUpdateFrequency _Frequency)
+    {
         switch (_Frequency)
         {
-            case ShaderUpdateFrequency::kPerFrame: frequencyInfo = &m_PerFrameInfo; break;
-            case ShaderUpdateFrequency::kPerGroup: frequencyInfo = &m_PerGroupInfo; break;
-            case ShaderUpdateFrequency::kPerDraw: frequencyInfo = &m_PerDrawInfo; break;
-            default: VEGA_CORE_ASSERT(false, "Unknown ShaderUpdateFrequency!"); return;
+            case ShaderUpdateFrequency::kPerFrame: return &m_PerFrameInfo;
+            case ShaderUpdateFrequency::kPerGroup: return &m_PerGroupInfo;
+            case ShaderUpdateFrequency::kPerDraw: return &m_PerDrawInfo;
         }
 
-        if (!frequencyInfo)
+        VEGA_CORE_ASSERT(false, "Unknown ShaderUpdateFrequency!");
+        return nullptr;
+    }
+
+    void VulkanShader::WriteUniform(ShaderUpdateFrequency _Frequency, uint32_t _Offset, const void* _Data,
+                                    size_t _Size)
+    {
+        if (_Frequency == ShaderUpdateFrequency::kPerDraw)
         {
-            VEGA_CORE_ASSERT(false, "Frequency info is not initialized!");
+            VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+            const std::vector<VulkanPipeline>& pipelineArray =
+                m_ShaderConfig.Flags & ShaderFlagBits::kWireframe ? m_WireframesPipelines : m_Pipelines;
+
+            uint8_t* fieldData = m_LocalPushConstantsBlock + _Offset;
+            std::memcpy(fieldData, _Data, _Size);
+            vkCmdPushConstants(rendererBackend->GetCurrentGraphicsCommandBuffer(),
+                               pipelineArray[m_BoundPipelineIndex].Layout, m_PerDrawInfo.StageFlags, _Offset,
+                               static_cast<uint32_t>(_Size), fieldData);
             return;
         }
+
+        // NOTE: Uploaded to the uniform ring buffer on the next draw
+        VulkanShaderFrequencyInfo* frequencyInfo = GetFrequencyInfo(_Frequency);
+        std::memcpy(frequencyInfo->Data.data() + _Offset, _Data, _Size);
+        frequencyInfo->IsDirty = true;
     }
 
-    void VulkanShader::PrepareShaderData()
+    void VulkanShader::SetStorageBuffer(std::string_view _Name, const Ref<RenderBuffer>& _RenderBuffer,
+                                        size_t _Offset, size_t _Size)
     {
-        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
-        uint32_t imageCount = static_cast<uint32_t>(rendererBackend->GetVkSwapchain().GetImagesCount());
-
-        // m_LocalPushConstantsBlock.fill(0);
-
-        bool isHasPerFrame = !m_ShaderConfig.UniformsPerFrame.empty();
-        bool isHasPerGroup = !m_ShaderConfig.UniformsPerGroup.empty();
-        bool isHasPerDraw = !m_ShaderConfig.UniformsPerDraw.empty();
-
-        // TODO: Get SamplerCount for each frequency type
-        uint32_t maxSamplerCount = 0;
-        // TODO: Get ImageCount for each frequency type
-        uint32_t maxImageCount = 0;
-        // TODO: Get UboCount for each frequency type
-        uint32_t perDrawUboCount = 0;
-        uint32_t maxUboCount = perDrawUboCount;    // TODO: perFrameUboCount + perGroupUboCount +;
-
-        uint32_t perFrameDescriptorSetCount = (isHasPerFrame ? 1 : 0) * imageCount;
-        uint32_t perGroupDescriptorSetCount = (isHasPerGroup ? 1 : 0) * imageCount * m_ShaderConfig.MaxGroups;
-        // TODO: may be this zero?
-        uint32_t perDrawDescriptorSetCount = (isHasPerDraw ? 1 : 0) * imageCount * m_ShaderConfig.MaxDrawIds;
-        m_MaxDescriptorSetCount = perFrameDescriptorSetCount + perGroupDescriptorSetCount + perDrawDescriptorSetCount;
-
-        m_PoolSizes.reserve(3);
-        if (maxUboCount > 0)
-        {
-            m_PoolSizes.emplace_back(
-                VkDescriptorPoolSize { .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .descriptorCount = maxUboCount });
-        }
-        if (maxSamplerCount > 0)
-        {
-            m_PoolSizes.emplace_back(
-                VkDescriptorPoolSize { .type = VK_DESCRIPTOR_TYPE_SAMPLER, .descriptorCount = maxSamplerCount });
-            m_PoolSizes.emplace_back(
-                VkDescriptorPoolSize { .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, .descriptorCount = maxImageCount });
-        }
-
-        // TODO: setup descriptor sets for per-frame, per-group, per-draw
-
-        // if (isHasGlobalDescriptorSet)
-        // {
-        //     m_DescriptorSets.emplace_back(VulkanDescriptorSetConfig {});
-        //     m_DescriptorSetLayouts.emplace_back(VK_NULL_HANDLE);
-        // }
-        // if (isHasInstanceDescriptorSet)
-        // {
-        //     m_DescriptorSets.emplace_back(VulkanDescriptorSetConfig {});
-        //     m_DescriptorSetLayouts.emplace_back(VK_NULL_HANDLE);
-        // }
-
-        // if (isHasGlobalDescriptorSet)
-        // {
-        //     VulkanDescriptorSetConfig& setConfig = m_DescriptorSets.front();
-        //     uint32_t uboCount = m_ShaderConfig.GlobalUnformCount ? 1 : 0;
-        //     setConfig.Bindings.reserve(uboCount + m_ShaderConfig.GlobalUniformSamplerCount);
-        //     if (uboCount > 0)
-        //     {
-        //         setConfig.Bindings.emplace_back(VkDescriptorSetLayoutBinding {
-        //             .binding = static_cast<uint32_t>(setConfig.Bindings.size()),
-        //             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-        //             .descriptorCount = 1,
-        //             .stageFlags = VK_SHADER_STAGE_ALL,
-        //         });
-        //     }
-
-        //     setConfig.SamplerBindingIndexStart = uboCount;
-
-        //     for (uint32_t i = 0; i < m_ShaderConfig.GlobalUniformSamplerCount; ++i)
-        //     {
-        //         const ShaderUniform& uniform = m_ShaderConfig.Uniforms[m_ShaderConfig.GlobalSamplerIndices[i]];
-        //         setConfig.Bindings.emplace_back(VkDescriptorSetLayoutBinding {
-        //             .binding = static_cast<uint32_t>(setConfig.Bindings.size()),
-        //             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        //             .descriptorCount = glm::max(static_cast<uint32_t>(1), uniform.ArrayLength),
-        //             .stageFlags = VK_SHADER_STAGE_ALL,
-        //         });
-        //     }
-        // }
-
-        // if (isHasInstanceDescriptorSet)
-        // {
-        //     VulkanDescriptorSetConfig& setConfig = m_DescriptorSets.back();
-        //     uint32_t uboCount = m_ShaderConfig.InstanceUniformCount ? 1 : 0;
-        //     setConfig.Bindings.reserve(uboCount + m_ShaderConfig.InstanceUniformSamplerCount);
-        //     if (uboCount > 0)
-        //     {
-        //         setConfig.Bindings.emplace_back(VkDescriptorSetLayoutBinding {
-        //             .binding = static_cast<uint32_t>(setConfig.Bindings.size()),
-        //             .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-        //             .descriptorCount = 1,
-        //             .stageFlags = VK_SHADER_STAGE_ALL,
-        //         });
-        //     }
-
-        //     setConfig.SamplerBindingIndexStart = uboCount;
-
-        //     for (uint32_t i = 0; i < m_ShaderConfig.InstanceUniformSamplerCount; ++i)
-        //     {
-        //         const ShaderUniform& uniform = m_ShaderConfig.Uniforms[m_ShaderConfig.InstanceSamplerIndices[i]];
-        //         setConfig.Bindings.emplace_back(VkDescriptorSetLayoutBinding {
-        //             .binding = static_cast<uint32_t>(setConfig.Bindings.size()),
-        //             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        //             .descriptorCount = glm::max(static_cast<uint32_t>(1), uniform.ArrayLength),
-        //             .stageFlags = VK_SHADER_STAGE_ALL,
-        //         });
-        //     }
-        // }
-
-        // m_GlobalUboDescriptorStates.Generations.resize(imageCount);
-        // m_GlobalUboDescriptorStates.Ids.resize(imageCount);
-        // m_GlobalUboDescriptorStates.FrameNumbers.resize(imageCount);
-        // for (size_t i = 0; i < imageCount; ++i)
-        // {
-        //     m_GlobalUboDescriptorStates.Generations[i] = std::numeric_limits<uint32_t>::max();
-        //     m_GlobalUboDescriptorStates.Ids[i] = std::numeric_limits<uint32_t>::max();
-        //     m_GlobalUboDescriptorStates.FrameNumbers[i] = std::numeric_limits<uint64_t>::max();
-        // }
-
-        // m_InstanceStates.resize(m_ShaderConfig.MaxInstances);
-        // for (size_t i = 0; i < m_ShaderConfig.MaxInstances; ++i)
-        // {
-        //     m_InstanceStates[i].Id = std::numeric_limits<uint32_t>::max();
-        // }
+        auto bindingIt =
+            std::find_if(m_StorageBufferBindings.begin(), m_StorageBufferBindings.end(),
+                         [_Name](const VulkanStorageBufferBinding& binding) { return binding.Name == _Name; });
+        if (bindingIt == m_StorageBufferBindings.end())
+        {
+            if (m_IsReady)
+            {
+                VEGA_CORE_ERROR("Shader {} has no storage buffer {}", m_ShaderConfig.Name, _Name);
+                return;
+            }
+
+            // NOTE: Storage buffers are reflected by the build, bindings set before it is applied are matched by name
+            m_StorageBufferBindings.emplace_back(VulkanStorageBufferBinding {
+                .Name = std::string(_Name),
+                .Binding = 0,
+                .BufferInfo = {},
+            });
+            bindingIt = std::prev(m_StorageBufferBindings.end());
+        }
+
+        VEGA_CORE_ASSERT(_RenderBuffer->GetType() == RenderBufferType::kStorage ||
+                             _RenderBuffer->GetType() == RenderBufferType::kStorageHostVisible,
+                         "Only storage RenderBuffers can be bound as storage buffers!");
+        VkDeviceSize offsetAlignment =
+            VulkanRendererBackend::GetVkRendererBackend()->GetVkDeviceWrapper().GetMinStorageBufferOffsetAlignment();
+        VEGA_CORE_ASSERT(_Offset % offsetAlignment == 0,
+                         "Storage buffer offset must be aligned to minStorageBufferOffsetAlignment!");
+
+        VkDescriptorBufferInfo bufferInfo = {
+            .buffer = std::static_pointer_cast<VulkanRenderBuffer>(_RenderBuffer)->GetVkBuffer(),
+            .offset = _Offset,
+            .range = _Size > 0 ? _Size : VK_WHOLE_SIZE,
+        };
+
+        if (bindingIt->BufferInfo.buffer != bufferInfo.buffer || bindingIt->BufferInfo.offset != bufferInfo.offset ||
+            bindingIt->BufferInfo.range != bufferInfo.range)
+        {
+            bindingIt->BufferInfo = bufferInfo;
+            m_IsStorageBufferSetDirty = true;
+        }
     }
 
-    // TODO: Implement for all frequencies (now only per-draw)
-    VulkanDescriptorSetConfig VulkanShader::SetupDescriptorSetByFrequency() { return VulkanDescriptorSetConfig {}; }
+    bool VulkanShader::CreateBuildLayouts(VulkanShaderBuild& _Build)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+        VkDevice logicalDevice = deviceWrapper.GetLogicalDevice();
+        const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
+
+        for (const VulkanShaderReflection& stageReflection : _Build.StageReflections)
+        {
+            if (!_Build.Reflection.Merge(stageReflection))
+            {
+                return false;
+            }
+        }
+        const VulkanShaderReflection& reflection = _Build.Reflection;
+
+        // NOTE: Set layouts are indexed by the set number, sets the shader skips get empty layouts
+        bool isUsingBindlessTextures = false;
+        for (const VulkanReflectedBinding& binding : reflection.GetBindings())
+        {
+            // NOTE: The layout of the bindless set is defined by the heap, the declared array size does not matter
+            if (binding.Set == kBindlessTextureSetIndex)
+            {
+                if (binding.Binding != VulkanBindlessTextureHeap::kBinding ||
+                    binding.DescriptorType != VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+                {
+                    VEGA_CORE_ERROR("Shader {}: set {} only holds the bindless sampler array at binding {}",
+                                    m_ShaderConfig.Name, kBindlessTextureSetIndex, VulkanBindlessTextureHeap::kBinding);
+                    return false;
+                }
+                if (!rendererBackend->GetBindlessTextureHeap().IsCreated())
+                {
+                    VEGA_CORE_ERROR("Shader {} uses bindless textures, but the device does not support them",
+                                    m_ShaderConfig.Name);
+                    return false;
+                }
+                _Build.DescriptorSets.resize(std::max<size_t>(_Build.DescriptorSets.size(), binding.Set + 1));
+                isUsingBindlessTextures = true;
+                continue;
+            }
+
+            bool isUniformSet = binding.Set == kPerFrameSetIndex || binding.Set == kPerGroupSetIndex;
+            bool isUniformBlock = isUniformSet && binding.DescriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            bool isStorageBuffer =
+                binding.Set == kStorageBufferSetIndex && binding.DescriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            if ((!isUniformBlock && !isStorageBuffer) || binding.DescriptorCount != 1)
+            {
+                VEGA_CORE_ERROR("Shader {}: {} at set {} binding {} is not supported. Uniform blocks go to sets {} and "
+                                "{}, storage buffers to set {}",
+                                m_ShaderConfig.Name, binding.Name, binding.Set, binding.Binding, kPerFrameSetIndex,
+                                kPerGroupSetIndex, kStorageBufferSetIndex);
+                return false;
+            }
+
+            if (isUniformBlock && binding.BlockSize > deviceWrapper.GetMaxUniformBufferRange())
+            {
+                VEGA_CORE_ERROR("Shader {}: uniform block {} exceeds maxUniformBufferRange", m_ShaderConfig.Name,
+                                binding.Name);
+                return false;
+            }
+
+            if (_Build.DescriptorSets.size() <= binding.Set)
+            {
+                _Build.DescriptorSets.resize(binding.Set + 1);
+            }
+            VulkanDescriptorSetConfig& setConfig = _Build.DescriptorSets[binding.Set];
+            if (isUniformBlock && !setConfig.Bindings.empty())
+            {
+                VEGA_CORE_ERROR("Shader {}: set {} must contain a single uniform block", m_ShaderConfig.Name,
+                                binding.Set);
+                return false;
+            }
+
+            // NOTE: Uniform blocks live in the uniform ring buffer and are bound with dynamic offsets
+            setConfig.Bindings.emplace_back(VkDescriptorSetLayoutBinding {
+                .binding = binding.Binding,
+                .descriptorType = isUniformBlock ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : binding.DescriptorType,
+                .descriptorCount = binding.DescriptorCount,
+                .stageFlags = binding.StageFlags,
+            });
+        }
+
+        for (size_t i = 0; i < _Build.DescriptorSets.size(); ++i)
+        {
+            const VulkanDescriptorSetConfig& setConfig = _Build.DescriptorSets[i];
+            VkDescriptorSetLayoutCreateInfo layoutInfo = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .bindingCount = static_cast<uint32_t>(setConfig.Bindings.size()),
+                .pBindings = setConfig.Bindings.data(),
+            };
+
+            // NOTE: An identically defined layout is compatible with the heap set, so the shader owns a copy
+            VkDescriptorSetLayout setLayout;
+            VkResult createLayoutResult =
+                isUsingBindlessTextures && i == kBindlessTextureSetIndex
+                    ? rendererBackend->GetBindlessTextureHeap().CreateDescriptorSetLayout(setLayout)
+                    : vkCreateDescriptorSetLayout(logicalDevice, &layoutInfo, vkAllocator, &setLayout);
+            if (!VulkanResultIsSuccess(createLayoutResult))
+            {
+                VEGA_CORE_CRITICAL("Failed to create descriptor set layout: {}",
+                                   VulkanResultString(createLayoutResult, true));
+                return false;
+            }
+            _Build.DescriptorSetLayouts.push_back(setLayout);
+        }
+
+        const VulkanReflectedPushConstants& pushConstants = reflection.GetPushConstants();
+        if (pushConstants.Size > sizeof(m_LocalPushConstantsBlock) ||
+            pushConstants.Size > deviceWrapper.GetPhysicalDeviceProperties().limits.maxPushConstantsSize)
+        {
+            VEGA_CORE_ERROR("Shader {}: push constant block {} is {} bytes, at most {} are supported",
+                            m_ShaderConfig.Name, pushConstants.Name, pushConstants.Size,
+                            sizeof(m_LocalPushConstantsBlock));
+            return false;
+        }
+
+        std::vector<VkPushConstantRange> pushConstantRanges;
+        if (pushConstants.Size > 0)
+        {
+            pushConstantRanges.emplace_back(VkPushConstantRange {
+                .stageFlags = pushConstants.StageFlags,
+                .offset = 0,
+                .size = pushConstants.Size,
+            });
+        }
+
+        // NOTE: Vertex inputs are tightly packed in location order, configured attributes only replace the formats
+        //       for buffers that store them differently from the shader
+        const std::vector<VulkanReflectedVertexInput>& vertexInputs = reflection.GetVertexInputs();
+        if (!m_ShaderConfig.Attributes.empty() && m_ShaderConfig.Attributes.size() != vertexInputs.size())
+        {
+            VEGA_CORE_ERROR("Shader {} has {} vertex inputs, but {} attributes are configured", m_ShaderConfig.Name,
+                            vertexInputs.size(), m_ShaderConfig.Attributes.size());
+            return false;
+        }
+
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+        uint32_t stride = 0;
+        for (size_t i = 0; i < vertexInputs.size(); ++i)
+        {
+            bool isConfigured = !m_ShaderConfig.Attributes.empty();
+            attributeDescriptions.emplace_back(VkVertexInputAttributeDescription {
+                .location = vertexInputs[i].Location,
+                .binding = 0,
+                .format = isConfigured ? ShaderAttributeTypeToVkFormat(m_ShaderConfig.Attributes[i])
+                                       : vertexInputs[i].Format,
+                .offset = stride,
+            });
+            stride += isConfigured ? ShaderDataTypeSize(m_ShaderConfig.Attributes[i]) : vertexInputs[i].Size;
+        }
+
+        // NOTE: All pipelines of the shader share one layout
+        VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+            .setLayoutCount = static_cast<uint32_t>(_Build.DescriptorSetLayouts.size()),
+            .pSetLayouts = _Build.DescriptorSetLayouts.data(),
+            .pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size()),
+            .pPushConstantRanges = pushConstantRanges.data(),
+        };
+
+        VkResult createPipelineLayoutResult =
+            vkCreatePipelineLayout(logicalDevice, &pipelineLayoutCreateInfo, vkAllocator, &_Build.PipelineLayout);
+        if (!VulkanResultIsSuccess(createPipelineLayoutResult))
+        {
+            VEGA_CORE_CRITICAL("Failed to create pipeline layout: {}",
+                               VulkanResultString(createPipelineLayoutResult, true));
+            _Build.PipelineLayout = VK_NULL_HANDLE;
+            return false;
+        }
+        VK_SET_DEBUG_OBJECT_NAME(rendererBackend->GetVkContext().PfnSetDebugUtilsObjectNameEXT, logicalDevice,
+                                 VK_OBJECT_TYPE_PIPELINE_LAYOUT, _Build.PipelineLayout,
+                                 std::format("pipeline_layout_shader_{}", m_ShaderConfig.Name).c_str());
 
-    bool VulkanShader::CreateModulesAndPipelines()
+        for (VulkanPiplineConfig& pipelineConfig : _Build.PipelineConfigs)
+        {
+            pipelineConfig.Stride = stride;
+            pipelineConfig.Attributes = attributeDescriptions;
+            pipelineConfig.Layout = _Build.PipelineLayout;
+            pipelineConfig.PushConstantRanges = pushConstantRanges;
+        }
+        for (VulkanPipeline& pipeline : _Build.Pipelines)
+        {
+            pipeline.Layout = _Build.PipelineLayout;
+        }
+
+        return true;
+    }
+
+    void VulkanShader::ApplyBuildLayouts(VulkanShaderBuild& _Build)
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
         VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
         const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
+        const VulkanShaderReflection& reflection = _Build.Reflection;
 
-        bool hasError = false;
+        // NOTE: The previous set layouts and pool are retired by ApplyPendingBuild
+        m_DescriptorSets = std::move(_Build.DescriptorSets);
+        m_DescriptorSetLayouts = std::move(_Build.DescriptorSetLayouts);
+        m_DescriptorPool = VK_NULL_HANDLE;
 
-        bool isNeedWireframe = (m_ShaderConfig.Flags & ShaderFlagBits::kWireframe) != 0;
+        SetupUniformBlock(kPerFrameSetIndex, reflection, m_PerFrameInfo);
+        SetupUniformBlock(kPerGroupSetIndex, reflection, m_PerGroupInfo);
 
-        std::vector<VulkanPipeline> newPipelines;
-        std::vector<VulkanPipeline> newWireframePipelines;
+        m_IsUsingBindlessTextures = std::any_of(
+            reflection.GetBindings().begin(), reflection.GetBindings().end(),
+            [](const VulkanReflectedBinding& _Binding) { return _Binding.Set == kBindlessTextureSetIndex; });
 
-        std::vector<VulkanShaderStage> newStages;
-        newStages.reserve(m_ShaderStageConfigs.size());
+        const VulkanReflectedPushConstants& pushConstants = reflection.GetPushConstants();
+        m_PerDrawInfo.Fields = pushConstants.Fields;
+        m_PerDrawInfo.UnoStride = pushConstants.Size;
+        m_PerDrawInfo.StageFlags = pushConstants.StageFlags;
 
-        for (size_t i = 0; i < m_ShaderStageConfigs.size(); ++i)
+        // NOTE: Buffers set before a reload (or before the first build) stay bound if the shader still declares them
+        std::vector<VulkanStorageBufferBinding> storageBufferBindings;
+        for (const VulkanReflectedBinding& binding : reflection.GetBindings())
         {
-            std::optional<VulkanShaderStage> vkStage = CreateShaderModule(m_ShaderStageConfigs[i]);
-            if (vkStage.has_value())
+            if (binding.Set != kStorageBufferSetIndex)
             {
-                newStages.push_back(vkStage.value());
                 continue;
             }
 
-            VEGA_CORE_ERROR("Failed to create shader module for stage: {}",
-                            ShaderStageTypeToString(m_ShaderStageConfigs[i].Type));
-            hasError = true;
-            break;
+            auto previousIt = std::find_if(
+                m_StorageBufferBindings.begin(), m_StorageBufferBindings.end(),
+                [&binding](const VulkanStorageBufferBinding& _Previous) { return _Previous.Name == binding.Name; });
+            storageBufferBindings.emplace_back(VulkanStorageBufferBinding {
+                .Name = binding.Name,
+                .Binding = binding.Binding,
+                .BufferInfo = previousIt != m_StorageBufferBindings.end() ? previousIt->BufferInfo
+                                                                          : VkDescriptorBufferInfo {},
+            });
+        }
+        m_StorageBufferBindings = std::move(storageBufferBindings);
+
+        uint32_t framesInFlight = rendererBackend->GetVkSwapchain().GetMaxFramesInFlight();
+        m_StorageBufferFrameStates.assign(m_StorageBufferBindings.empty() ? 0 : framesInFlight, {});
+        m_StorageBufferDescriptorSet = VK_NULL_HANDLE;
+        m_IsStorageBufferSetDirty = true;
+
+        // NOTE: Per-frame and per-group uniforms live in the uniform ring buffer and need a single dynamic
+        //       descriptor set each, storage buffer bindings may change once per group
+        uint32_t uniformDescriptorSetCount = (m_PerFrameInfo.UnoStride > 0 ? 1 : 0) +
+                                             (m_PerGroupInfo.UnoStride > 0 ? 1 : 0);
+        uint32_t storageBufferCount = static_cast<uint32_t>(m_StorageBufferBindings.size());
+        uint32_t storageBufferDescriptorSetCount =
+            (storageBufferCount > 0 ? 1 : 0) * framesInFlight * m_ShaderConfig.MaxGroups;
+        uint32_t maxDescriptorSetCount = uniformDescriptorSetCount + storageBufferDescriptorSetCount;
+        if (maxDescriptorSetCount == 0)
+        {
+            return;
         }
 
-        if (hasError)
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        if (storageBufferCount > 0)
         {
-            // TODO: Implement proper error handling ?
-            return false;
+            poolSizes.emplace_back(VkDescriptorPoolSize {
+                .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .descriptorCount = storageBufferCount * storageBufferDescriptorSetCount,
+            });
+        }
+        if (uniformDescriptorSetCount > 0)
+        {
+            poolSizes.emplace_back(VkDescriptorPoolSize {
+                .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                .descriptorCount = uniformDescriptorSetCount,
+            });
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+            .maxSets = maxDescriptorSetCount,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data(),
+        };
+
+#if defined(VK_USE_PLATFORM_MACOS_MVK)
+        // NOTE: increase the per-stage descriptor samplers limit on macOS
+        // (maxPerStageDescriptorUpdateAfterBindSamplers > maxPerStageDescriptorSamplers)
+        poolInfo.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+#endif
+
+        VkResult createPoolResult = vkCreateDescriptorPool(logicalDevice, &poolInfo, vkAllocator, &m_DescriptorPool);
+        if (!VulkanResultIsSuccess(createPoolResult))
+        {
+            VEGA_CORE_CRITICAL("Failed to create descriptor pool: {}", VulkanResultString(createPoolResult, true));
+            VEGA_CORE_ASSERT(false, "Failed to create descriptor pool!");
+            return;
+        }
+
+        VK_SET_DEBUG_OBJECT_NAME(rendererBackend->GetVkContext().PfnSetDebugUtilsObjectNameEXT, logicalDevice,
+                                 VK_OBJECT_TYPE_DESCRIPTOR_POOL, m_DescriptorPool,
+                                 std::format("descriptor_pool_{}", m_ShaderConfig.Name).c_str());
+
+        if (m_PerFrameInfo.UnoStride > 0)
+        {
+            AllocateUniformDescriptorSet(m_PerFrameInfo);
+        }
+        if (m_PerGroupInfo.UnoStride > 0)
+        {
+            AllocateUniformDescriptorSet(m_PerGroupInfo);
+        }
+    }
+
+    void VulkanShader::SetupUniformBlock(uint32_t _SetIndex, const VulkanShaderReflection& _Reflection,
+                                         VulkanShaderFrequencyInfo& _InOutInfo)
+    {
+        VulkanShaderFrequencyInfo info = { .SetIndex = _SetIndex };
+
+        auto bindingIt =
+            std::find_if(_Reflection.GetBindings().begin(), _Reflection.GetBindings().end(),
+                         [_SetIndex](const VulkanReflectedBinding& _Binding) { return _Binding.Set == _SetIndex; });
+        if (bindingIt != _Reflection.GetBindings().end())
+        {
+            info.Binding = bindingIt->Binding;
+            info.Fields = bindingIt->Fields;
+            info.UnoStride = (bindingIt->BlockSize + 15) / 16 * 16;
+            info.Data.assign(info.UnoStride, 0);
+
+            // NOTE: Values set before a reload are kept for fields with the same name and size
+            for (const VulkanReflectedField& field : info.Fields)
+            {
+                auto previousIt = std::find_if(
+                    _InOutInfo.Fields.begin(), _InOutInfo.Fields.end(),
+                    [&field](const VulkanReflectedField& _Previous) { return _Previous.Name == field.Name; });
+                if (previousIt != _InOutInfo.Fields.end() && previousIt->Size == field.Size)
+                {
+                    std::memcpy(info.Data.data() + field.Offset, _InOutInfo.Data.data() + previousIt->Offset,
+                                field.Size);
+                }
+            }
+        }
+
+        _InOutInfo = std::move(info);
+    }
+
+    void VulkanShader::AllocateUniformDescriptorSet(VulkanShaderFrequencyInfo& _Info)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
+
+        VkDescriptorSetAllocateInfo allocateInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+            .descriptorPool = m_DescriptorPool,
+            .descriptorSetCount = 1,
+            .pSetLayouts = &m_DescriptorSetLayouts[_Info.SetIndex],
+        };
+        VK_CHECK(vkAllocateDescriptorSets(logicalDevice, &allocateInfo, &_Info.DescriptorSet));
+
+        // NOTE: The ring buffer never changes, so the set is written once and only the dynamic offset moves
+        VkDescriptorBufferInfo bufferInfo = {
+            .buffer = rendererBackend->GetUniformRingBuffer().GetVkBuffer(),
+            .offset = 0,
+            .range = _Info.UnoStride,
+        };
+        VkWriteDescriptorSet descriptorWrite = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = _Info.DescriptorSet,
+            .dstBinding = _Info.Binding,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+            .pBufferInfo = &bufferInfo,
+        };
+        vkUpdateDescriptorSets(logicalDevice, 1, &descriptorWrite, 0, nullptr);
+    }
+
+    void VulkanShader::FlushUniforms(VkCommandBuffer _CommandBuffer)
+    {
+        const std::vector<VulkanPipeline>& pipelineArray =
+            m_ShaderConfig.Flags & ShaderFlagBits::kWireframe ? m_WireframesPipelines : m_Pipelines;
+        const VulkanPipeline& pipeline = pipelineArray[m_BoundPipelineIndex];
+
+        if (m_PerFrameInfo.DescriptorSet)
+        {
+            FlushUniformBlock(_CommandBuffer, pipeline, m_PerFrameInfo);
+        }
+        if (m_PerGroupInfo.DescriptorSet)
+        {
+            FlushUniformBlock(_CommandBuffer, pipeline, m_PerGroupInfo);
         }
+    }
+
+    void VulkanShader::FlushUniformBlock(VkCommandBuffer _CommandBuffer, const VulkanPipeline& _Pipeline,
+                                         VulkanShaderFrequencyInfo& _Info)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        uint64_t frameNumber = rendererBackend->GetCurrentFrameNumber();
+
+        // NOTE: Unchanged blocks are uploaded once per frame, their ring segment of older frames is being reused
+        if (_Info.IsDirty || _Info.FrameNumber != frameNumber)
+        {
+            VulkanUniformAllocation allocation;
+            if (!rendererBackend->GetUniformRingBuffer().Allocate(_Info.UnoStride, allocation))
+            {
+                VEGA_CORE_ASSERT(false, "Uniform ring buffer is out of memory!");
+                return;
+            }
+            std::memcpy(allocation.MappedData, _Info.Data.data(), _Info.UnoStride);
+
+            _Info.DynamicOffset = allocation.Offset;
+            _Info.FrameNumber = frameNumber;
+            _Info.IsDirty = false;
+            _Info.IsNeedBind = true;
+        }
+
+        if (_Info.IsNeedBind)
+        {
+            vkCmdBindDescriptorSets(_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _Pipeline.Layout, _Info.SetIndex,
+                                    1, &_Info.DescriptorSet, 1, &_Info.DynamicOffset);
+            _Info.IsNeedBind = false;
+        }
+    }
+
+    std::shared_future<bool> VulkanShader::CreateModulesAndPipelines()
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+
+        Ref<VulkanShaderBuild> build = CreateRef<VulkanShaderBuild>();
+        build->StartTime = std::chrono::steady_clock::now();
+        build->Stages.resize(m_ShaderStageConfigs.size());
+        build->StageSourceFiles.resize(m_ShaderStageConfigs.size());
+        build->StageReflections.resize(m_ShaderStageConfigs.size());
+        build->SolidPipelineCount = m_Pipelines.size();
+        bool isInitialWireframe = (m_ShaderConfig.Flags & ShaderFlagBits::kWireframe) && !m_WireframesPipelines.empty();
+        build->InitialPipelineIndex = (isInitialWireframe ? m_Pipelines.size() : 0) + m_BoundPipelineIndex;
 
         Ref<Window> window = Application::Get().GetWindow();
 
@@ -486,23 +966,9 @@ namespace Vega
             .extent = { .width = window->GetWidth(), .height = window->GetHeight() },
         };
 
-        std::vector<VkPipelineShaderStageCreateInfo> stagesCreateInfo;
-        stagesCreateInfo.reserve(newStages.size());
-        std::transform(newStages.begin(), newStages.end(), std::back_inserter(stagesCreateInfo),
-                       [](const VulkanShaderStage& stage) { return stage.ShaderStageCreateInfo; });
-
-        for (size_t i = 0; i < m_Pipelines.size(); ++i)
+        // NOTE: Everything owned by the renderer is read here on the main thread, the jobs only see the configs
+        if (!m_Pipelines.empty())
         {
-            newPipelines.emplace_back(VulkanPipeline {
-                .SupportedTopologyTypes = m_Pipelines[i].SupportedTopologyTypes,
-            });
-            if (isNeedWireframe)
-            {
-                newWireframePipelines.emplace_back(VulkanPipeline {
-                    .SupportedTopologyTypes = m_WireframesPipelines[i].SupportedTopologyTypes,
-                });
-            }
-
             bool isColorFlagSet = (m_ShaderConfig.Flags & ShaderFlagBits::kColorRead) ||
                                   (m_ShaderConfig.Flags & ShaderFlagBits::kColorWrite);
 
@@ -515,82 +981,371 @@ namespace Vega
 
             VkFormat depthFormat = rendererBackend->GetVkDeviceWrapper().GetDepthFormat();
 
-            // TODO: Remove hardcoded value
-            const uint32_t localUboStride = 128;
-
-            VulkanPiplineConfig pipelineConfig = {
+            // NOTE: Vertex layout, pipeline layout and push constant ranges are filled from the reflection by the
+            //       build, the topology comes from the pipeline slot
+            build->PipelineConfigs.emplace_back(VulkanPiplineConfig {
                 .Name = m_ShaderConfig.Name,
-                .Stride = m_ShaderConfig.GetAttibutesStride(),
-                .Attributes = m_AttributeDescriptions,
-                .DescriptorSetLayouts = m_DescriptorSetLayouts,
-                .Stages = stagesCreateInfo,
                 .Viewport = viewport,
                 .Scissor = scissor,
                 .CullMode = m_ShaderConfig.CullMode,
                 .Flags = m_ShaderConfig.Flags & ~ShaderFlagBits::kWireframe,
-                .PushConstantRanges = { Range { .Offset = 0, .Size = localUboStride } },
                 .TopologyTypes = m_ShaderConfig.TopologyTypes,
                 .ColorAttachmentFormats =
                     isColorFlagSet ? std::vector<VkFormat> { colorFormat } : std::vector<VkFormat> {},
                 .DepthAttachmentFormat = isDepthOrStencilFlagSet ? depthFormat : VK_FORMAT_UNDEFINED,
                 .StencilAttachmentFormat = isDepthOrStencilFlagSet ? depthFormat : VK_FORMAT_UNDEFINED,
+            });
+
+            // NOTE: Wireframe slots exist only if the device supports them
+            if (!m_WireframesPipelines.empty())
+            {
+                VulkanPiplineConfig pipelineConfig = build->PipelineConfigs.front();
+                pipelineConfig.Flags |= ShaderFlagBits::kWireframe;
+                build->PipelineConfigs.push_back(std::move(pipelineConfig));
+            }
+        }
+
+        for (const std::vector<VulkanPipeline>* pipelines : { &m_Pipelines, &m_WireframesPipelines })
+        {
+            for (const VulkanPipeline& pipeline : *pipelines)
+            {
+                build->Pipelines.emplace_back(VulkanPipeline {
+                    .TopologyTypeBase = pipeline.TopologyTypeBase,
+                    .Handle = VK_NULL_HANDLE,
+                    .Layout = VK_NULL_HANDLE,
+                    .SupportedTopologyTypes = pipeline.SupportedTopologyTypes,
+                });
+            }
+        }
+
+        std::shared_future<bool> result = build->Result.get_future().share();
+        m_PendingBuild = build;
+
+        if (m_ShaderStageConfigs.empty())
+        {
+            EnqueuePipelineJobs(build);
+            return result;
+        }
+
+        VulkanShaderBuildQueue& buildQueue = rendererBackend->GetShaderBuildQueue();
+        build->RemainingJobs = static_cast<uint32_t>(m_ShaderStageConfigs.size());
+        for (size_t i = 0; i < m_ShaderStageConfigs.size(); ++i)
+        {
+            buildQueue.Enqueue([this, build, i](shaderc_compiler* _Compiler) {
+                std::optional<VulkanShaderStage> vkStage =
+                    CreateShaderModule(_Compiler, m_ShaderStageConfigs[i], build->StageSourceFiles[i],
+                                       build->StageReflections[i]);
+                if (vkStage.has_value())
+                {
+                    build->Stages[i] = vkStage.value();
+                }
+                else
+                {
+                    VEGA_CORE_ERROR("Failed to create shader module for stage: {}",
+                                    ShaderStageTypeToString(m_ShaderStageConfigs[i].Type));
+                    build->HasError = true;
+                }
+
+                // NOTE: Pipelines need every stage, the last finished stage job starts them
+                if (build->RemainingJobs.fetch_sub(1) == 1)
+                {
+                    EnqueuePipelineJobs(build);
+                }
+            });
+        }
+
+        return result;
+    }
+
+    bool VulkanShader::SetupBuildSpecialization(VulkanShaderBuild& _Build,
+                                                std::vector<VkPipelineShaderStageCreateInfo>& _InOutStages)
+    {
+        const std::vector<ShaderKeyword>& keywords = m_ShaderConfig.Keywords;
+
+        // NOTE: Every keyword is specialized, so the GLSL default value does not select the variant
+        _Build.SpecializationData.resize(keywords.size());
+        for (size_t i = 0; i < keywords.size(); ++i)
+        {
+            _Build.SpecializationData[i] = (m_VariantMask & (ShaderVariantMask(1) << i)) ? VK_TRUE : VK_FALSE;
+        }
+
+        _Build.SpecializationMapEntries.resize(_InOutStages.size());
+        _Build.SpecializationInfos.resize(_InOutStages.size());
+        for (size_t stageIndex = 0; stageIndex < _InOutStages.size(); ++stageIndex)
+        {
+            const std::vector<VulkanReflectedSpecializationConstant>& constants =
+                _Build.StageReflections[stageIndex].GetSpecializationConstants();
+            std::vector<VkSpecializationMapEntry>& mapEntries = _Build.SpecializationMapEntries[stageIndex];
+
+            for (size_t keywordIndex = 0; keywordIndex < keywords.size(); ++keywordIndex)
+            {
+                const ShaderKeyword& keyword = keywords[keywordIndex];
+                if (!keyword.IsSpecializationConstant)
+                {
+                    continue;
+                }
+
+                auto constantIt = std::find_if(constants.begin(), constants.end(),
+                                               [&keyword](const VulkanReflectedSpecializationConstant& _Constant) {
+                                                   return _Constant.Name == keyword.Name;
+                                               });
+                if (constantIt == constants.end())
+                {
+                    continue;
+                }
+                if (!constantIt->IsBool)
+                {
+                    VEGA_CORE_ERROR("Shader {}: specialization constant of keyword {} must be a bool",
+                                    m_ShaderConfig.Name, keyword.Name);
+                    return false;
+                }
+
+                mapEntries.emplace_back(VkSpecializationMapEntry {
+                    .constantID = constantIt->ConstantId,
+                    .offset = static_cast<uint32_t>(keywordIndex * sizeof(VkBool32)),
+                    .size = sizeof(VkBool32),
+                });
+            }
+
+            if (mapEntries.empty())
+            {
+                continue;
+            }
+
+            _Build.SpecializationInfos[stageIndex] = VkSpecializationInfo {
+                .mapEntryCount = static_cast<uint32_t>(mapEntries.size()),
+                .pMapEntries = mapEntries.data(),
+                .dataSize = _Build.SpecializationData.size() * sizeof(VkBool32),
+                .pData = _Build.SpecializationData.data(),
             };
+            _InOutStages[stageIndex].pSpecializationInfo = &_Build.SpecializationInfos[stageIndex];
+        }
+
+        return true;
+    }
+
+    void VulkanShader::EnqueuePipelineJobs(const Ref<VulkanShaderBuild>& _Build)
+    {
+        // NOTE: Layouts need the reflection of every stage, so they are created once all stages are compiled
+        if (!_Build->HasError && !CreateBuildLayouts(*_Build))
+        {
+            _Build->HasError = true;
+        }
+
+        if (_Build->HasError || _Build->Pipelines.empty())
+        {
+            FinishBuild(*_Build);
+            return;
+        }
+
+        std::vector<VkPipelineShaderStageCreateInfo> stagesCreateInfo;
+        stagesCreateInfo.reserve(_Build->Stages.size());
+        std::transform(_Build->Stages.begin(), _Build->Stages.end(), std::back_inserter(stagesCreateInfo),
+                       [](const VulkanShaderStage& stage) { return stage.ShaderStageCreateInfo; });
+
+        if (!SetupBuildSpecialization(*_Build, stagesCreateInfo))
+        {
+            _Build->HasError = true;
+            FinishBuild(*_Build);
+            return;
+        }
+
+        std::vector<uint64_t> stageHashes;
+        stageHashes.reserve(_Build->Stages.size());
+        std::transform(_Build->Stages.begin(), _Build->Stages.end(), std::back_inserter(stageHashes),
+                       [](const VulkanShaderStage& stage) { return stage.SpirvHash; });
+
+        for (VulkanPiplineConfig& pipelineConfig : _Build->PipelineConfigs)
+        {
+            pipelineConfig.Stages = stagesCreateInfo;
+            pipelineConfig.StageHashes = stageHashes;
+        }
+
+        // NOTE: Only the pipeline Bind() starts with is created up front, it is shared if another shader has it
+        VulkanShaderBuildQueue& buildQueue = VulkanRendererBackend::GetVkRendererBackend()->GetShaderBuildQueue();
+        buildQueue.Enqueue([this, _Build](shaderc_compiler* _Compiler) {
+            size_t pipelineIndex = _Build->InitialPipelineIndex;
+            const VulkanPiplineConfig& pipelineConfig =
+                _Build->PipelineConfigs[pipelineIndex < _Build->SolidPipelineCount ? 0 : 1];
+            if (!AcquirePipeline(pipelineConfig, _Build->Pipelines[pipelineIndex]))
+            {
+                VEGA_CORE_ERROR("Failed to load graphics pipeline for shader: {}.", m_ShaderConfig.Name);
+                _Build->HasError = true;
+            }
+
+            FinishBuild(*_Build);
+        });
+    }
+
+    void VulkanShader::FinishBuild(VulkanShaderBuild& _Build)
+    {
+        if (_Build.HasError)
+        {
+            VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+            VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
+            const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
+
+            // NOTE: The initial pipeline is the last step of the build, so a failed build never holds one
+            for (VulkanShaderStage& stage : _Build.Stages)
+            {
+                if (stage.Handle)
+                {
+                    vkDestroyShaderModule(logicalDevice, stage.Handle, vkAllocator);
+                }
+            }
+            for (VkDescriptorSetLayout setLayout : _Build.DescriptorSetLayouts)
+            {
+                vkDestroyDescriptorSetLayout(logicalDevice, setLayout, vkAllocator);
+            }
+            if (_Build.PipelineLayout)
+            {
+                vkDestroyPipelineLayout(logicalDevice, _Build.PipelineLayout, vkAllocator);
+            }
+        }
+
+        _Build.Result.set_value(!_Build.HasError);
+    }
+
+    bool VulkanShader::ApplyPendingBuild(bool _IsWaitRequired)
+    {
+        if (!m_PendingBuild)
+        {
+            return m_IsReady;
+        }
+
+        if (!_IsWaitRequired && m_BuildResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return m_IsReady;
+        }
 
-            bool pipelineResult = CreateGraphicsPipeline(pipelineConfig, newPipelines[i]);
+        Ref<VulkanShaderBuild> build = std::move(m_PendingBuild);
 
-            if (pipelineResult && isNeedWireframe)
+        // NOTE: Updated even for failed builds, so fixing the error in any of the files triggers a reload
+        UpdateSourceFiles(build->StageSourceFiles);
+
+        if (!m_BuildResult.get())
+        {
+            if (!m_IsReady)
             {
-                pipelineConfig.Flags |= ShaderFlagBits::kWireframe;
-                pipelineResult = CreateGraphicsPipeline(pipelineConfig, newWireframePipelines[i]);
+                VEGA_CORE_ERROR("Failed initial load on shader {}. See logs for details.", m_ShaderConfig.Name);
+                VEGA_CORE_ASSERT(false, "Failed initial load on shader");
             }
-
-            if (!pipelineResult)
+            else
             {
-                VEGA_CORE_ERROR("Failed to load graphics pipeline for shader: {}.", m_ShaderConfig.Name);
-                hasError = true;
-                break;
+                VEGA_CORE_ERROR("Failed to reload shader {}, the previous version is kept.", m_ShaderConfig.Name);
             }
+            return m_IsReady;
         }
 
-        if (hasError)
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+
+        // NOTE: Frames in flight may still use the replaced objects, the backend destroys them once they are completed
+        if (m_IsReady)
         {
-            for (VulkanPipeline& pipeline : newPipelines)
+            // NOTE: Pipelines are retired by the pipeline state cache once no shader uses them
+            ReleasePipelines(m_Pipelines);
+            ReleasePipelines(m_WireframesPipelines);
+
+            VulkanRetiredShaderObjects retiredObjects;
+            retiredObjects.PipelineLayouts.push_back(m_PipelineLayout);
+            for (const VulkanShaderStage& stage : m_ShaderStages)
             {
-                DestroyGraphicsPipeline(pipeline);
+                retiredObjects.ShaderModules.push_back(stage.Handle);
             }
-            for (VulkanPipeline& pipeline : newWireframePipelines)
+            retiredObjects.DescriptorSetLayouts = std::move(m_DescriptorSetLayouts);
+            if (m_DescriptorPool)
             {
-                DestroyGraphicsPipeline(pipeline);
+                retiredObjects.DescriptorPools.push_back(m_DescriptorPool);
             }
-            for (VulkanShaderStage& stage : newStages)
+            rendererBackend->RetireShaderObjects(std::move(retiredObjects));
+        }
+
+        auto solidPipelinesEnd = build->Pipelines.begin() + build->SolidPipelineCount;
+        m_Pipelines.assign(build->Pipelines.begin(), solidPipelinesEnd);
+        m_WireframesPipelines.assign(solidPipelinesEnd, build->Pipelines.end());
+
+        m_ShaderStages = std::move(build->Stages);
+        m_PipelineLayout = build->PipelineLayout;
+
+        ApplyBuildLayouts(*build);
+        for (VulkanUniformHandleInfo& handleInfo : m_UniformHandles)
+        {
+            if (!ResolveUniformHandle(handleInfo))
             {
-                vkDestroyShaderModule(logicalDevice, stage.Handle, vkAllocator);
+                VEGA_CORE_WARN("Shader {} does not declare uniform {}, it is not set", m_ShaderConfig.Name,
+                               handleInfo.Name);
             }
+        }
 
-            return false;
+        m_AppliedBuild = build;
+        m_IsReady = true;
+
+        VEGA_CORE_TRACE("Shader {} built in {:.2f} ms", m_ShaderConfig.Name,
+                        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - build->StartTime)
+                            .count());
+
+        return true;
+    }
+
+    void VulkanShader::RequestReload()
+    {
+        // NOTE: Files may change again while a build is running, the reload starts once it is applied
+        if (m_PendingBuild)
+        {
+            m_IsReloadQueued = true;
+            return;
         }
 
-        vkDeviceWaitIdle(logicalDevice);
+        VEGA_CORE_INFO("Reloading shader {}", m_ShaderConfig.Name);
+        m_IsReloadQueued = false;
+        m_BuildResult = CreateModulesAndPipelines();
+    }
 
-        for (VulkanPipeline& pipeline : m_Pipelines)
+    void VulkanShader::ProcessReload()
+    {
+        if (m_PendingBuild)
         {
-            DestroyGraphicsPipeline(pipeline);
+            ApplyPendingBuild(false);
         }
-        m_Pipelines = std::move(newPipelines);
 
-        for (VulkanPipeline& pipeline : m_WireframesPipelines)
+        if (!m_PendingBuild && m_IsReloadQueued)
         {
-            DestroyGraphicsPipeline(pipeline);
+            RequestReload();
         }
-        m_WireframesPipelines = std::move(newWireframePipelines);
+    }
 
-        for (VulkanShaderStage& stage : m_ShaderStages)
+    bool VulkanShader::IsUsingSourceFile(const std::filesystem::path& _Path) const
+    {
+        return std::find(m_SourceFiles.begin(), m_SourceFiles.end(), _Path) != m_SourceFiles.end();
+    }
+
+    void VulkanShader::UpdateSourceFiles(const std::vector<std::vector<std::filesystem::path>>& _StageSourceFiles)
+    {
+        FileWatcher& fileWatcher = VulkanRendererBackend::GetVkRendererBackend()->GetShaderFileWatcher();
+
+        std::vector<std::filesystem::path> sourceFiles;
+        for (const std::vector<std::filesystem::path>& stageSourceFiles : _StageSourceFiles)
         {
-            vkDestroyShaderModule(logicalDevice, stage.Handle, vkAllocator);
+            for (const std::filesystem::path& sourceFile : stageSourceFiles)
+            {
+                std::filesystem::path path = FileWatcher::NormalizePath(sourceFile);
+                if (std::find(sourceFiles.begin(), sourceFiles.end(), path) == sourceFiles.end())
+                {
+                    sourceFiles.push_back(std::move(path));
+                }
+            }
         }
-        m_ShaderStages = std::move(newStages);
 
-        return true;
+        // NOTE: Added before removing, files used by both versions keep their watch
+        for (const std::filesystem::path& sourceFile : sourceFiles)
+        {
+            fileWatcher.AddFile(sourceFile);
+        }
+        for (const std::filesystem::path& sourceFile : m_SourceFiles)
+        {
+            fileWatcher.RemoveFile(sourceFile);
+        }
+        m_SourceFiles = std::move(sourceFiles);
     }
 
     VkCullModeFlags VulkanShader::GetVkCullMode(FaceCullMode _CullMode) const
@@ -647,7 +1402,92 @@ namespace Vega
         return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     }
 
-    bool VulkanShader::CreateGraphicsPipeline(const VulkanPiplineConfig& _PipelineConfig, VulkanPipeline& _OutPipeline)
+    bool VulkanShader::AcquirePipeline(const VulkanPiplineConfig& _PipelineConfig, VulkanPipeline& _InOutPipeline)
+    {
+        VulkanPipelineStateCache& pipelineStateCache =
+            VulkanRendererBackend::GetVkRendererBackend()->GetPipelineStateCache();
+
+        uint64_t stateHash = ComputePipelineStateHash(_PipelineConfig, _InOutPipeline.SupportedTopologyTypes);
+        VkPipeline pipeline = pipelineStateCache.Acquire(stateHash, [&]() {
+            VkPipeline createdPipeline = VK_NULL_HANDLE;
+            CreateGraphicsPipeline(_PipelineConfig, _InOutPipeline.SupportedTopologyTypes, createdPipeline);
+            return createdPipeline;
+        });
+        if (!pipeline)
+        {
+            return false;
+        }
+
+        _InOutPipeline.Handle = pipeline;
+        _InOutPipeline.Layout = _PipelineConfig.Layout;
+        _InOutPipeline.StateHash = stateHash;
+        return true;
+    }
+
+    void VulkanShader::ReleasePipelines(std::vector<VulkanPipeline>& _InOutPipelines)
+    {
+        VulkanPipelineStateCache& pipelineStateCache =
+            VulkanRendererBackend::GetVkRendererBackend()->GetPipelineStateCache();
+
+        for (VulkanPipeline& pipeline : _InOutPipelines)
+        {
+            if (pipeline.Handle)
+            {
+                pipelineStateCache.Release(pipeline.StateHash);
+                pipeline.Handle = VK_NULL_HANDLE;
+            }
+        }
+    }
+
+    uint64_t VulkanShader::ComputePipelineStateHash(const VulkanPiplineConfig& _PipelineConfig,
+                                                    PrimitiveTopologyTypes _TopologyTypes) const
+    {
+        // NOTE: Viewport and scissor are dynamic state. The layout object is not hashed, the same stages always
+        //       reflect an identically defined (and therefore compatible) layout
+        uint64_t hash = VulkanShaderCache::kHashSeed;
+        for (size_t i = 0; i < _PipelineConfig.Stages.size(); ++i)
+        {
+            const VkPipelineShaderStageCreateInfo& stage = _PipelineConfig.Stages[i];
+            hash = VulkanShaderCache::Hash(&_PipelineConfig.StageHashes[i], sizeof(uint64_t), hash);
+            hash = VulkanShaderCache::Hash(&stage.stage, sizeof(stage.stage), hash);
+            hash = VulkanShaderCache::Hash(std::string_view(stage.pName), hash);
+
+            const VkSpecializationInfo* specializationInfo = stage.pSpecializationInfo;
+            uint32_t mapEntryCount = specializationInfo ? specializationInfo->mapEntryCount : 0;
+            hash = VulkanShaderCache::Hash(&mapEntryCount, sizeof(mapEntryCount), hash);
+            if (specializationInfo)
+            {
+                hash = VulkanShaderCache::Hash(specializationInfo->pMapEntries,
+                                               mapEntryCount * sizeof(VkSpecializationMapEntry), hash);
+                hash = VulkanShaderCache::Hash(specializationInfo->pData, specializationInfo->dataSize, hash);
+            }
+        }
+
+        hash = VulkanShaderCache::Hash(&_PipelineConfig.Stride, sizeof(_PipelineConfig.Stride), hash);
+        hash = VulkanShaderCache::Hash(_PipelineConfig.Attributes.data(),
+                                       _PipelineConfig.Attributes.size() * sizeof(VkVertexInputAttributeDescription),
+                                       hash);
+        hash = VulkanShaderCache::Hash(_PipelineConfig.PushConstantRanges.data(),
+                                       _PipelineConfig.PushConstantRanges.size() * sizeof(VkPushConstantRange), hash);
+
+        VkPrimitiveTopology topology = GetVkPrimitiveTopology(_TopologyTypes);
+        hash = VulkanShaderCache::Hash(&topology, sizeof(topology), hash);
+        hash = VulkanShaderCache::Hash(&_PipelineConfig.CullMode, sizeof(_PipelineConfig.CullMode), hash);
+        hash = VulkanShaderCache::Hash(&_PipelineConfig.Winding, sizeof(_PipelineConfig.Winding), hash);
+        hash = VulkanShaderCache::Hash(&_PipelineConfig.Flags, sizeof(_PipelineConfig.Flags), hash);
+
+        uint32_t colorAttachmentCount = static_cast<uint32_t>(_PipelineConfig.ColorAttachmentFormats.size());
+        hash = VulkanShaderCache::Hash(&colorAttachmentCount, sizeof(colorAttachmentCount), hash);
+        hash = VulkanShaderCache::Hash(_PipelineConfig.ColorAttachmentFormats.data(),
+                                       colorAttachmentCount * sizeof(VkFormat), hash);
+        hash = VulkanShaderCache::Hash(&_PipelineConfig.DepthAttachmentFormat, sizeof(VkFormat), hash);
+        hash = VulkanShaderCache::Hash(&_PipelineConfig.StencilAttachmentFormat, sizeof(VkFormat), hash);
+
+        return hash;
+    }
+
+    bool VulkanShader::CreateGraphicsPipeline(const VulkanPiplineConfig& _PipelineConfig,
+                                              PrimitiveTopologyTypes _TopologyTypes, VkPipeline& _OutPipeline)
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
         VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
@@ -785,43 +1625,10 @@ namespace Vega
 
         VkPipelineInputAssemblyStateCreateInfo inputAssemblyCreateInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-            .topology = GetVkPrimitiveTopology(_OutPipeline.SupportedTopologyTypes),
+            .topology = GetVkPrimitiveTopology(_TopologyTypes),
             .primitiveRestartEnable = VK_FALSE,
         };
 
-        std::vector<VkPushConstantRange> pushConstantRanges;
-        if (_PipelineConfig.PushConstantRanges.size() > 32)
-        {
-            VEGA_CORE_ERROR("VulkanShader::CreateGraphicsPipeline: cannot have more than 32 push constant ranges. "
-                            "Passed count: {}",
-                            _PipelineConfig.PushConstantRanges.size());
-            return false;
-        }
-        for (const Range& range : _PipelineConfig.PushConstantRanges)
-        {
-            pushConstantRanges.emplace_back(VkPushConstantRange {
-                .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                .offset = static_cast<uint32_t>(range.Offset),
-                .size = static_cast<uint32_t>(range.Size),
-            });
-        }
-
-        VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-            .setLayoutCount = static_cast<uint32_t>(_PipelineConfig.DescriptorSetLayouts.size()),
-            .pSetLayouts = _PipelineConfig.DescriptorSetLayouts.data(),
-            .pushConstantRangeCount = static_cast<uint32_t>(_PipelineConfig.PushConstantRanges.size()),
-            .pPushConstantRanges = pushConstantRanges.data(),
-        };
-
-        VK_CHECK(vkCreatePipelineLayout(logicalDevice, &pipelineLayoutCreateInfo, vkAllocator, &_OutPipeline.Layout));
-
-#ifdef _DEBUG
-        std::string pipelineLayoutName = std::format("pipeline_layout_shader_{}", _PipelineConfig.Name);
-        VK_SET_DEBUG_OBJECT_NAME(rendererBackend->GetVkContext().PfnSetDebugUtilsObjectNameEXT, logicalDevice,
-                                 VK_OBJECT_TYPE_PIPELINE_LAYOUT, _OutPipeline.Layout, pipelineLayoutName.data());
-#endif
-
         VkPipelineRenderingCreateInfoKHR pipelineRenderingCreateInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
             .pNext = VK_NULL_HANDLE,
@@ -845,20 +1652,21 @@ namespace Vega
             .pDepthStencilState = isDepthTest || isStencilTest ? &depthStencilCreateInfo : nullptr,
             .pColorBlendState = &colorBlendStateCreateInfo,
             .pDynamicState = &dynamicStateCreateInfo,
-            .layout = _OutPipeline.Layout,
+            .layout = _PipelineConfig.Layout,
             .renderPass = VK_NULL_HANDLE,
             .subpass = 0,
             .basePipelineHandle = VK_NULL_HANDLE,
             .basePipelineIndex = -1,
         };
 
-        VkResult pipelineResult = vkCreateGraphicsPipelines(logicalDevice, VK_NULL_HANDLE, 1, &pipelineCreateInfo,
-                                                            vkAllocator, &_OutPipeline.Handle);
+        VkResult pipelineResult =
+            vkCreateGraphicsPipelines(logicalDevice, rendererBackend->GetVkPipelineCache(), 1, &pipelineCreateInfo,
+                                      vkAllocator, &_OutPipeline);
 
 #ifdef _DEBUG
         std::string pipelineName = std::format("pipeline_shader_{}", _PipelineConfig.Name);
         VK_SET_DEBUG_OBJECT_NAME(rendererBackend->GetVkContext().PfnSetDebugUtilsObjectNameEXT, logicalDevice,
-                                 VK_OBJECT_TYPE_PIPELINE, _OutPipeline.Handle, pipelineName.data());
+                                 VK_OBJECT_TYPE_PIPELINE, _OutPipeline, pipelineName.data());
 #endif
 
         if (!VulkanResultIsSuccess(pipelineResult))
@@ -871,28 +1679,9 @@ namespace Vega
         return true;
     }
 
-    bool VulkanShader::DestroyGraphicsPipeline(VulkanPipeline& _Pipeline)
-    {
-        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
-        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
-        const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
-
-        if (_Pipeline.Handle)
-        {
-            vkDestroyPipeline(logicalDevice, _Pipeline.Handle, vkAllocator);
-            _Pipeline.Handle = VK_NULL_HANDLE;
-        }
-
-        if (_Pipeline.Layout)
-        {
-            vkDestroyPipelineLayout(logicalDevice, _Pipeline.Layout, vkAllocator);
-            _Pipeline.Layout = VK_NULL_HANDLE;
-        }
-
-        return true;
-    }
-
-    std::optional<VulkanShaderStage> VulkanShader::CreateShaderModule(const ShaderStageConfig& _ShaderStageConfig)
+    std::optional<VulkanShaderStage> VulkanShader::CreateShaderModule(
+        shaderc_compiler* _Compiler, const ShaderStageConfig& _ShaderStageConfig,
+        std::vector<std::filesystem::path>& _OutSourceFiles, VulkanShaderReflection& _OutReflection)
     {
         VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
         VulkanContext context = rendererBackend->GetVkContext();
@@ -922,79 +1711,66 @@ namespace Vega
                 return std::nullopt;
         }
 
-        VEGA_CORE_TRACE("Compiling stage {} for shader: {}", ShaderStageTypeToString(_ShaderStageConfig.Type),
-                        m_ShaderConfig.Name);
-
-        std::vector<char> fileData = ReadFile(_ShaderStageConfig.Path);
+        // NOTE: The stage is watched for reloads even if it can not be read yet
+        _OutSourceFiles.emplace_back(_ShaderStageConfig.Path);
 
-        shaderc_compilation_result_t compilationResult =
-            shaderc_compile_into_spv(context.ShaderCompiler, fileData.data(), fileData.size(), shaderKind,
-                                     _ShaderStageConfig.Path.c_str(), "main", 0);
-
-        if (!compilationResult)
+        std::vector<char> fileData;
+        if (!TryReadFile(_ShaderStageConfig.Path, fileData))
         {
-            VEGA_CORE_ERROR("An unknown error occurred while trying to compile the shader. Unable to process futher.");
+            VEGA_CORE_ERROR("Failed to read stage {} of shader {}: {}",
+                            ShaderStageTypeToString(_ShaderStageConfig.Type), m_ShaderConfig.Name,
+                            _ShaderStageConfig.Path);
             return std::nullopt;
         }
 
-        shaderc_compilation_status status = shaderc_result_get_compilation_status(compilationResult);
+        // NOTE: shaderc only runs on a cache miss, the key covers everything that affects the output
+        uint64_t cacheKey = ComputeShaderCacheKey(_ShaderStageConfig.Path, fileData, shaderKind,
+                                                  m_ShaderConfig.Defines, _OutSourceFiles);
+        VulkanShaderCache& shaderCache = rendererBackend->GetShaderCache();
 
-        if (status != shaderc_compilation_status_success)
+        std::vector<uint32_t> spirv;
+        if (shaderCache.Load(cacheKey, spirv))
         {
-            VEGA_CORE_ERROR("Error compiling shader with {} errors.", shaderc_result_get_num_errors(compilationResult));
-            VEGA_CORE_ERROR("Error(s): \n \t {}", shaderc_result_get_error_message(compilationResult));
-
-            shaderc_result_release(compilationResult);
-
-            return std::nullopt;
+            VEGA_CORE_TRACE("Loaded stage {} for shader {} from cache ({:016x})",
+                            ShaderStageTypeToString(_ShaderStageConfig.Type), m_ShaderConfig.Name, cacheKey);
         }
-
-        VEGA_CORE_TRACE("Shader compiled successfully.");
-
-        size_t warningCount = shaderc_result_get_num_warnings(compilationResult);
-        if (warningCount)
+        else
         {
-            VEGA_CORE_WARN("Warning compiling shader with {} warnings.", warningCount);
-            // NOTE: Not sure this it the correct way to obtain warnings.
-            VEGA_CORE_WARN("Warning(s): \n \t {}", shaderc_result_get_error_message(compilationResult));
-        }
-
-        const char* bytes = shaderc_result_get_bytes(compilationResult);
-        size_t bytesLength = shaderc_result_get_length(compilationResult);
+            VEGA_CORE_TRACE("Compiling stage {} for shader: {}", ShaderStageTypeToString(_ShaderStageConfig.Type),
+                            m_ShaderConfig.Name);
 
-        std::ofstream outFile(std::format("{}.spv", _ShaderStageConfig.Path), std::ios::binary);
-        if (outFile.is_open())
-        {
-            outFile.write(bytes, bytesLength);
-            outFile.close();
+            if (!CompileShaderSpirv(_Compiler, _ShaderStageConfig.Path, fileData, shaderKind,
+                                    m_ShaderConfig.Defines, spirv))
+            {
+                return std::nullopt;
+            }
+            shaderCache.Store(cacheKey, spirv.data(), spirv.size());
         }
-        else
+
+        if (!_OutReflection.Reflect(spirv, stageFlag))
         {
-            VEGA_CORE_WARN("Failed to write SPIR-V binary to file: {}.spv", _ShaderStageConfig.Path);
+            VEGA_CORE_ERROR("Failed to reflect stage {} of shader {}", ShaderStageTypeToString(_ShaderStageConfig.Type),
+                            m_ShaderConfig.Name);
+            return std::nullopt;
         }
 
         VulkanShaderStage resStage {};
         resStage.CreateInfo = {
             .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-            .codeSize = bytesLength,
-            .pCode = reinterpret_cast<const uint32_t*>(bytes),
+            .codeSize = spirv.size() * sizeof(uint32_t),
+            .pCode = spirv.data(),
         };
 
         VK_CHECK(vkCreateShaderModule(rendererBackend->GetVkDeviceWrapper().GetLogicalDevice(), &resStage.CreateInfo,
                                       context.VkAllocator, &resStage.Handle));
 
-        // NOTE: may need to use this in resStage.CreateInfo
-        // std::shared_ptr<char*> code = std::make_shared<char*>(new char[bytesLength]);
-        // std::memcpy(*code, bytes, bytesLength);
-
-        shaderc_result_release(compilationResult);
-
         resStage.ShaderStageCreateInfo = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
             .stage = stageFlag,
             .module = resStage.Handle,
             .pName = "main",
         };
+        resStage.SpirvHash = VulkanShaderCache::Hash(spirv.data(), spirv.size() * sizeof(uint32_t));
 
         return resStage;
     }
@@ -1002,28 +1778,283 @@ namespace Vega
     void VulkanShader::BindPipeline(VkCommandBuffer _CommandBuffer, VkPipelineBindPoint _BindPoint,
                                     const VulkanPipeline& _Pipeline)
     {
+        // NOTE: Consecutive draws of the same shader keep its pipeline bound
+        if (_BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS &&
+            !VulkanRendererBackend::GetVkRendererBackend()->GetCurrentCommandState().BindGraphicsPipeline(
+                _Pipeline.Handle))
+        {
+            return;
+        }
         vkCmdBindPipeline(_CommandBuffer, _BindPoint, _Pipeline.Handle);
     }
 
-    std::vector<char> ReadFile(const std::string& _Filename)
+    void VulkanShader::BindStorageBuffers(VkCommandBuffer _CommandBuffer, VkPipelineBindPoint _BindPoint,
+                                          const VulkanPipeline& _Pipeline)
     {
-        std::ifstream file(_Filename, std::ios::ate | std::ios::binary);
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        VkDevice logicalDevice = rendererBackend->GetVkDeviceWrapper().GetLogicalDevice();
 
-        if (!file.is_open())
+        // NOTE: Sets of the current frame in flight are no longer used by the GPU once the frame is being recorded
+        VulkanStorageBufferFrameState& frameState =
+            m_StorageBufferFrameStates[rendererBackend->GetCurrentFrameIndex() % m_StorageBufferFrameStates.size()];
+        if (frameState.FrameNumber != rendererBackend->GetCurrentFrameNumber())
+        {
+            frameState.FrameNumber = rendererBackend->GetCurrentFrameNumber();
+            frameState.UsedDescriptorSetCount = 0;
+            m_IsStorageBufferSetDirty = true;
+        }
+
+        if (m_IsStorageBufferSetDirty)
         {
-            VEGA_CORE_CRITICAL("Failed to open file: {}", _Filename);
-            VEGA_CORE_ASSERT(false, "Failed to open file!");
+            if (frameState.UsedDescriptorSetCount == frameState.DescriptorSets.size())
+            {
+                VkDescriptorSetAllocateInfo allocateInfo = {
+                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                    .descriptorPool = m_DescriptorPool,
+                    .descriptorSetCount = 1,
+                    .pSetLayouts = &m_DescriptorSetLayouts[kStorageBufferSetIndex],
+                };
+
+                VkDescriptorSet descriptorSet;
+                VkResult allocateResult = vkAllocateDescriptorSets(logicalDevice, &allocateInfo, &descriptorSet);
+                if (!VulkanResultIsSuccess(allocateResult))
+                {
+                    VEGA_CORE_ERROR("Failed to allocate storage buffer descriptor set for shader {}: {}",
+                                    m_ShaderConfig.Name, VulkanResultString(allocateResult, true));
+                    VEGA_CORE_ASSERT(false, "Failed to allocate storage buffer descriptor set!");
+                    return;
+                }
+                frameState.DescriptorSets.push_back(descriptorSet);
+            }
+
+            m_StorageBufferDescriptorSet = frameState.DescriptorSets[frameState.UsedDescriptorSetCount++];
+
+            std::vector<VkWriteDescriptorSet> descriptorWrites;
+            descriptorWrites.reserve(m_StorageBufferBindings.size());
+            for (size_t i = 0; i < m_StorageBufferBindings.size(); ++i)
+            {
+                const VulkanStorageBufferBinding& binding = m_StorageBufferBindings[i];
+                VEGA_CORE_ASSERT(binding.BufferInfo.buffer != VK_NULL_HANDLE,
+                                 "Storage buffer is not set before binding the shader!");
+
+                descriptorWrites.emplace_back(VkWriteDescriptorSet {
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                    .dstSet = m_StorageBufferDescriptorSet,
+                    .dstBinding = binding.Binding,
+                    .dstArrayElement = 0,
+                    .descriptorCount = 1,
+                    .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                    .pBufferInfo = &binding.BufferInfo,
+                });
+            }
+            vkUpdateDescriptorSets(logicalDevice, static_cast<uint32_t>(descriptorWrites.size()),
+                                   descriptorWrites.data(), 0, nullptr);
+
+            m_IsStorageBufferSetDirty = false;
         }
 
-        size_t fileSize = (size_t)file.tellg();
-        std::vector<char> buffer(fileSize);
+        vkCmdBindDescriptorSets(_CommandBuffer, _BindPoint, _Pipeline.Layout, kStorageBufferSetIndex, 1,
+                                &m_StorageBufferDescriptorSet, 0, nullptr);
+    }
+
+    bool TryReadFile(const std::filesystem::path& _Path, std::vector<char>& _OutData)
+    {
+        std::ifstream file(_Path, std::ios::ate | std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
 
+        _OutData.resize(static_cast<size_t>(file.tellg()));
         file.seekg(0);
-        file.read(buffer.data(), fileSize);
+        return static_cast<bool>(file.read(_OutData.data(), _OutData.size()));
+    }
+
+    std::filesystem::path ResolveShaderIncludePath(const std::filesystem::path& _RequestingPath,
+                                                   std::string_view _RequestedPath)
+    {
+        // NOTE: Both "file" and <file> includes are relative to the including file
+        return (_RequestingPath.parent_path() / _RequestedPath).lexically_normal();
+    }
+
+    void CollectShaderIncludes(const std::filesystem::path& _Path, const std::vector<char>& _Source,
+                               std::unordered_set<std::string>& _Visited,
+                               std::vector<std::filesystem::path>& _OutIncludes)
+    {
+        // NOTE: Conservative scan, includes inside comments or disabled #if blocks are collected as well, which can
+        //       only cause extra cache misses
+        std::string_view source(_Source.data(), _Source.size());
+        size_t lineBegin = 0;
+        while (lineBegin < source.size())
+        {
+            size_t lineEnd = source.find('\n', lineBegin);
+            if (lineEnd == std::string_view::npos)
+            {
+                lineEnd = source.size();
+            }
+            std::string_view line = source.substr(lineBegin, lineEnd - lineBegin);
+            lineBegin = lineEnd + 1;
+
+            size_t position = line.find_first_not_of(" \t");
+            if (position == std::string_view::npos || line[position] != '#')
+            {
+                continue;
+            }
+            position = line.find_first_not_of(" \t", position + 1);
+            if (position == std::string_view::npos || line.substr(position, 7) != "include")
+            {
+                continue;
+            }
+            position = line.find_first_of("\"<", position + 7);
+            if (position == std::string_view::npos)
+            {
+                continue;
+            }
+            size_t nameEnd = line.find(line[position] == '"' ? '"' : '>', position + 1);
+            if (nameEnd == std::string_view::npos)
+            {
+                continue;
+            }
+
+            std::filesystem::path includePath =
+                ResolveShaderIncludePath(_Path, line.substr(position + 1, nameEnd - position - 1));
+            if (!_Visited.insert(includePath.string()).second)
+            {
+                continue;
+            }
+
+            std::vector<char> includeSource;
+            if (TryReadFile(includePath, includeSource))
+            {
+                _OutIncludes.push_back(includePath);
+                CollectShaderIncludes(includePath, includeSource, _Visited, _OutIncludes);
+            }
+        }
+    }
+
+    uint64_t ComputeShaderCacheKey(const std::string& _Path, const std::vector<char>& _Source,
+                                   shaderc_shader_kind _ShaderKind, const std::vector<ShaderDefine>& _Defines,
+                                   std::vector<std::filesystem::path>& _OutIncludes)
+    {
+        unsigned int spirvVersion = 0;
+        unsigned int spirvRevision = 0;
+        shaderc_get_spv_version(&spirvVersion, &spirvRevision);
+
+        // NOTE: Compiler options are the defaults plus defines and include callbacks, so the compiler version (set
+        //       by CMake), target SPIR-V version, stage and entry point are enough to describe them
+        uint64_t key = VulkanShaderCache::Hash(std::format("{} spirv {}.{} kind {} entry main",
+                                                           VEGA_SHADER_COMPILER_VERSION, spirvVersion, spirvRevision,
+                                                           static_cast<int>(_ShaderKind)));
+        for (const ShaderDefine& define : _Defines)
+        {
+            key = VulkanShaderCache::Hash(define.Name, key);
+            key = VulkanShaderCache::Hash(define.Value, key);
+        }
+        key = VulkanShaderCache::Hash(_Source.data(), _Source.size(), key);
+
+        std::unordered_set<std::string> visited = { std::filesystem::path(_Path).lexically_normal().string() };
+        CollectShaderIncludes(_Path, _Source, visited, _OutIncludes);
+        for (const std::filesystem::path& includePath : _OutIncludes)
+        {
+            std::vector<char> includeSource;
+            TryReadFile(includePath, includeSource);
+            key = VulkanShaderCache::Hash(includePath.generic_string(), key);
+            key = VulkanShaderCache::Hash(includeSource.data(), includeSource.size(), key);
+        }
+
+        return key;
+    }
+
+    struct ShaderIncludeResult
+    {
+        shaderc_include_result Result;
+        std::string SourceName;
+        std::vector<char> Content;
+    };
+
+    static shaderc_include_result* ShaderIncludeResolve(void* _UserData, const char* _RequestedSource, int _Type,
+                                                        const char* _RequestingSource, size_t _IncludeDepth)
+    {
+        ShaderIncludeResult* includeResult = new ShaderIncludeResult();
+
+        std::filesystem::path includePath = ResolveShaderIncludePath(_RequestingSource, _RequestedSource);
+        if (TryReadFile(includePath, includeResult->Content))
+        {
+            includeResult->SourceName = includePath.generic_string();
+        }
+        else
+        {
+            // NOTE: Empty source name reports an error, the content is the error message
+            std::string message = std::format("Failed to open include file: {}", includePath.generic_string());
+            includeResult->Content.assign(message.begin(), message.end());
+        }
+
+        includeResult->Result = shaderc_include_result {
+            .source_name = includeResult->SourceName.c_str(),
+            .source_name_length = includeResult->SourceName.size(),
+            .content = includeResult->Content.data(),
+            .content_length = includeResult->Content.size(),
+            .user_data = includeResult,
+        };
+        return &includeResult->Result;
+    }
+
+    static void ShaderIncludeRelease(void* _UserData, shaderc_include_result* _IncludeResult)
+    {
+        delete static_cast<ShaderIncludeResult*>(_IncludeResult->user_data);
+    }
+
+    bool CompileShaderSpirv(shaderc_compiler_t _Compiler, const std::string& _Path, const std::vector<char>& _Source,
+                            shaderc_shader_kind _ShaderKind, const std::vector<ShaderDefine>& _Defines,
+                            std::vector<uint32_t>& _OutSpirv)
+    {
+        shaderc_compile_options_t options = shaderc_compile_options_initialize();
+        for (const ShaderDefine& define : _Defines)
+        {
+            shaderc_compile_options_add_macro_definition(options, define.Name.data(), define.Name.size(),
+                                                         define.Value.data(), define.Value.size());
+        }
+        shaderc_compile_options_set_include_callbacks(options, ShaderIncludeResolve, ShaderIncludeRelease, nullptr);
+
+        shaderc_compilation_result_t compilationResult = shaderc_compile_into_spv(
+            _Compiler, _Source.data(), _Source.size(), _ShaderKind, _Path.c_str(), "main", options);
+        shaderc_compile_options_release(options);
 
-        file.close();
+        if (!compilationResult)
+        {
+            VEGA_CORE_ERROR("An unknown error occurred while trying to compile the shader. Unable to process futher.");
+            return false;
+        }
+
+        shaderc_compilation_status status = shaderc_result_get_compilation_status(compilationResult);
+
+        if (status != shaderc_compilation_status_success)
+        {
+            VEGA_CORE_ERROR("Error compiling shader with {} errors.", shaderc_result_get_num_errors(compilationResult));
+            VEGA_CORE_ERROR("Error(s): \n \t {}", shaderc_result_get_error_message(compilationResult));
+
+            shaderc_result_release(compilationResult);
+
+            return false;
+        }
+
+        VEGA_CORE_TRACE("Shader compiled successfully.");
+
+        size_t warningCount = shaderc_result_get_num_warnings(compilationResult);
+        if (warningCount)
+        {
+            VEGA_CORE_WARN("Warning compiling shader with {} warnings.", warningCount);
+            // NOTE: Not sure this it the correct way to obtain warnings.
+            VEGA_CORE_WARN("Warning(s): \n \t {}", shaderc_result_get_error_message(compilationResult));
+        }
+
+        size_t bytesLength = shaderc_result_get_length(compilationResult);
+        _OutSpirv.resize(bytesLength / sizeof(uint32_t));
+        std::memcpy(_OutSpirv.data(), shaderc_result_get_bytes(compilationResult), bytesLength);
+
+        shaderc_result_release(compilationResult);
 
-        return buffer;
+        return true;
     }
 
     VkFormat ShaderAttributeTypeToVkFormat(ShaderAttributeType _Type)
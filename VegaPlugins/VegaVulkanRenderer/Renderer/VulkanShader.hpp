@@ -1,9 +1,17 @@
 #pragma once
 
 #include "Vega/Renderer/Shader.hpp"
+#include "Vega/Utils/FileWatcher.hpp"
+#include "VulkanBase.hpp"
+#include "VulkanBindlessTextureHeap.hpp"
+#include "VulkanShaderReflection.hpp"
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include <vulkan/vulkan.h>
@@ -38,10 +46,25 @@ namespace Vega
         std::vector<VulkanUniformSamplerState> SamplerUniforms;
     };
 
+    struct VulkanStorageBufferBinding
+    {
+        std::string Name;
+        uint32_t Binding;
+        VkDescriptorBufferInfo BufferInfo;
+    };
+
+    struct VulkanStorageBufferFrameState
+    {
+        // NOTE: A new set is taken every time the bindings change inside the frame, a set bound in the recorded
+        //       command buffer is never updated
+        std::vector<VkDescriptorSet> DescriptorSets;
+        size_t UsedDescriptorSetCount = 0;
+        uint64_t FrameNumber = 0;
+    };
+
     struct VulkanDescriptorSetConfig
     {
         std::vector<VkDescriptorSetLayoutBinding> Bindings;
-        uint32_t SamplerBindingIndexStart;
     };
 
     enum class VulkanPrimitiveTopologyTypeBase : uint32_t
@@ -57,12 +80,8 @@ namespace Vega
         VkPipeline Handle;
         VkPipelineLayout Layout;
         PrimitiveTopologyTypes SupportedTopologyTypes;
-    };
-
-    struct Range
-    {
-        size_t Offset;
-        size_t Size;
+        // NOTE: Key of Handle in the renderer wide pipeline state cache, Handle is VK_NULL_HANDLE until first use
+        uint64_t StateHash = 0;
     };
 
     struct VulkanPiplineConfig
@@ -70,13 +89,15 @@ namespace Vega
         std::string Name;
         uint32_t Stride;
         std::vector<VkVertexInputAttributeDescription> Attributes;
-        std::vector<VkDescriptorSetLayout> DescriptorSetLayouts;
+        VkPipelineLayout Layout;
         std::vector<VkPipelineShaderStageCreateInfo> Stages;
+        // NOTE: SPIR-V content hashes of Stages, pipelines are shared between shaders with the same code
+        std::vector<uint64_t> StageHashes;
         VkViewport Viewport;
         VkRect2D Scissor;
         FaceCullMode CullMode;
         ShaderFlags Flags;
-        std::vector<Range> PushConstantRanges;
+        std::vector<VkPushConstantRange> PushConstantRanges;
         PrimitiveTopologyTypes TopologyTypes;
         RendererWinding Winding;
 
@@ -90,11 +111,73 @@ namespace Vega
         VkShaderModuleCreateInfo CreateInfo;
         VkShaderModule Handle;
         VkPipelineShaderStageCreateInfo ShaderStageCreateInfo;
+        uint64_t SpirvHash;
     };
 
     struct VulkanShaderFrequencyInfo
     {
-        uint32_t UnoStride;
+        // NOTE: 0 for frequencies the shader has no uniforms for
+        uint32_t UnoStride = 0;
+
+        // NOTE: Layout of the uniform block (push constant block for per-draw) reflected from the stages
+        std::vector<VulkanReflectedField> Fields;
+
+        // NOTE: CPU copy of the block, uploaded to the uniform ring buffer before the next draw after a change
+        std::vector<uint8_t> Data;
+        bool IsDirty = true;
+        bool IsNeedBind = true;
+
+        uint32_t SetIndex = 0;
+        uint32_t Binding = 0;
+        // NOTE: Stages of the push constant range, per-draw only
+        VkShaderStageFlags StageFlags = 0;
+        VkDescriptorSet DescriptorSet = VK_NULL_HANDLE;
+        uint32_t DynamicOffset = 0;
+        // NOTE: Frame the DynamicOffset was allocated in, ring segments of older frames are reused
+        uint64_t FrameNumber = 0;
+    };
+
+    struct VulkanUniformHandleInfo
+    {
+        std::string Name;
+        ShaderUpdateFrequency Frequency = ShaderUpdateFrequency::kPerDraw;
+        uint32_t Offset = 0;
+        // NOTE: 0 while the applied build does not declare the uniform
+        uint32_t Size = 0;
+    };
+
+    // NOTE: Shared by the jobs of one asynchronous build, applied to the shader on the main thread once finished
+    struct VulkanShaderBuild
+    {
+        std::vector<VulkanShaderStage> Stages;
+        // NOTE: Stage source and its includes, watched for reloads
+        std::vector<std::vector<std::filesystem::path>> StageSourceFiles;
+        std::vector<VulkanShaderReflection> StageReflections;
+
+        // NOTE: Keyword values of the variant (VkBool32 per keyword), referenced by the stage specialization infos
+        std::vector<VkBool32> SpecializationData;
+        std::vector<std::vector<VkSpecializationMapEntry>> SpecializationMapEntries;
+        std::vector<VkSpecializationInfo> SpecializationInfos;
+
+        // NOTE: Created from the merged reflection once every stage is compiled, owned by the shader once applied
+        VulkanShaderReflection Reflection;
+        std::vector<VulkanDescriptorSetConfig> DescriptorSets;
+        std::vector<VkDescriptorSetLayout> DescriptorSetLayouts;
+
+        // NOTE: Solid pipeline slots come before the wireframe ones. PipelineConfigs holds the solid config and, if
+        //       there are wireframe slots, the wireframe one
+        std::vector<VulkanPiplineConfig> PipelineConfigs;
+        std::vector<VulkanPipeline> Pipelines;
+        size_t SolidPipelineCount = 0;
+        // NOTE: The pipeline Bind() starts with is created by the build, the other slots on their first use
+        size_t InitialPipelineIndex = 0;
+        VkPipelineLayout PipelineLayout = VK_NULL_HANDLE;
+
+        std::atomic<uint32_t> RemainingJobs = 0;
+        std::atomic<bool> HasError = false;
+        std::promise<bool> Result;
+
+        std::chrono::steady_clock::time_point StartTime;
     };
 
     /**
@@ -102,41 +185,125 @@ namespace Vega
      *
      * This class represents a shader in the Vulkan rendering backend.
      * It inherits from the Shader class and provides Vulkan-specific functionality.
+     *
+     * Descriptor set layouts, push constant ranges, vertex inputs and uniform offsets are reflected from the compiled
+     * stages. The uniform block of set 0 is updated per frame, the one of set 1 per group and the push constant
+     * block per draw, storage buffers are declared in set 2. Set 3 is the renderer wide bindless texture array
+     * (binding 0, an unsized sampler2D array), draws pick their textures with indices passed in push constants.
+     *
+     * Variants are separate VulkanShader objects owned by the base shader. Variants that differ only in
+     * specialization constant keywords compile to the same SPIR-V, so they are served by the shader cache and only
+     * their pipelines are created.
      */
     class VulkanShader : public Shader
     {
     public:
+        static constexpr uint32_t kPerFrameSetIndex = 0;
+        static constexpr uint32_t kPerGroupSetIndex = 1;
+        static constexpr uint32_t kStorageBufferSetIndex = 2;
+        static constexpr uint32_t kBindlessTextureSetIndex = VulkanBindlessTextureHeap::kDescriptorSetIndex;
+
         void Create(const ShaderConfig& _ShaderConfig,
                     const std::initializer_list<ShaderStageConfig>& _ShaderStageConfigs) override;
 
-        void Initialize() override;
+        std::shared_future<bool> Initialize() override;
         void Shutdown() override;
 
+        // NOTE: Only the first build is applied here, reloads are applied at the frame boundary
+        bool IsReady() override { return m_IsReady || ApplyPendingBuild(false); }
+
         bool Bind() override;
 
         void SetUniformBufferData(std::string_view _Name, const void* _Data, size_t _Size,
                                   ShaderUpdateFrequency _Frequency) override;
 
-    protected:
-        void PrepareShaderData();
+        ShaderUniformHandle GetUniformHandle(std::string_view _Name) override;
+        void SetUniform(ShaderUniformHandle _Handle, const void* _Data, size_t _Size) override;
+
+        ShaderVariantMask GetVariantMask(std::initializer_list<std::string_view> _Keywords) const override;
+        Shader* GetVariant(ShaderVariantMask _Mask) override;
+
+        void SetStorageBuffer(std::string_view _Name, const Ref<RenderBuffer>& _RenderBuffer, size_t _Offset = 0,
+                              size_t _Size = 0) override;
+
+        /**
+         * @brief Uploads changed per-frame and per-group uniform blocks and binds them with their dynamic offsets.
+         *
+         * Called by the renderer backend before every draw recorded with this shader bound.
+         */
+        void FlushUniforms(VkCommandBuffer _CommandBuffer);
 
-        // TODO: Implement for all frequencies (now only per-draw)
-        VulkanDescriptorSetConfig SetupDescriptorSetByFrequency();
+        // NOTE: Rebuilds stages and pipelines in the background, the current ones stay in use until it is finished
+        void RequestReload();
 
-        bool CreateModulesAndPipelines();
+        /**
+         * @brief Applies a finished reload and starts a queued one.
+         *
+         * Called by the renderer backend at the frame boundary, before the frame is recorded.
+         */
+        void ProcessReload();
+
+        // NOTE: _Path must be normalized with FileWatcher::NormalizePath
+        bool IsUsingSourceFile(const std::filesystem::path& _Path) const;
+
+    protected:
+        // NOTE: Runs on the shader build queue, creates set layouts and fills the layout part of the pipeline configs
+        bool CreateBuildLayouts(VulkanShaderBuild& _Build);
+        // NOTE: Runs on the main thread when the build is applied, recreates the descriptor pool and uniform blocks
+        void ApplyBuildLayouts(VulkanShaderBuild& _Build);
+
+        void SetupUniformBlock(uint32_t _SetIndex, const VulkanShaderReflection& _Reflection,
+                               VulkanShaderFrequencyInfo& _InOutInfo);
+        // NOTE: Looks the uniform up in the blocks of the applied build, returns false if none declares it
+        bool ResolveUniformHandle(VulkanUniformHandleInfo& _InOutInfo);
+        VulkanShaderFrequencyInfo* GetFrequencyInfo(ShaderUpdateFrequency _Frequency);
+        // NOTE: Per-draw uniforms are pushed right away, the others are uploaded before the next draw
+        void WriteUniform(ShaderUpdateFrequency _Frequency, uint32_t _Offset, const void* _Data, size_t _Size);
+        void AllocateUniformDescriptorSet(VulkanShaderFrequencyInfo& _Info);
+        void FlushUniformBlock(VkCommandBuffer _CommandBuffer, const VulkanPipeline& _Pipeline,
+                               VulkanShaderFrequencyInfo& _Info);
+
+        // NOTE: Sets the specialization constants of the keywords of the variant on the pipeline stages
+        bool SetupBuildSpecialization(VulkanShaderBuild& _Build,
+                                      std::vector<VkPipelineShaderStageCreateInfo>& _InOutStages);
+
+        // NOTE: Dispatches stage compilation and pipeline creation to the shader build queue
+        std::shared_future<bool> CreateModulesAndPipelines();
+        void EnqueuePipelineJobs(const Ref<VulkanShaderBuild>& _Build);
+        void FinishBuild(VulkanShaderBuild& _Build);
+
+        /**
+         * @brief Replaces stages and pipelines with the finished pending build.
+         *
+         * @param _IsWaitRequired Blocks until the pending build is finished.
+         * @return bool True if the shader has usable pipelines.
+         */
+        bool ApplyPendingBuild(bool _IsWaitRequired);
+        void UpdateSourceFiles(const std::vector<std::vector<std::filesystem::path>>& _StageSourceFiles);
 
         VkCullModeFlags GetVkCullMode(FaceCullMode _CullMode) const;
         VkFrontFace GetVkFrontFace(RendererWinding _Winding) const;
         VkPrimitiveTopology GetVkPrimitiveTopology(PrimitiveTopologyTypes _TopologyTypes) const;
 
-        bool CreateGraphicsPipeline(const VulkanPiplineConfig& _PipelineConfig, VulkanPipeline& _OutPipeline);
-        bool DestroyGraphicsPipeline(VulkanPipeline& _Pipeline);
+        // NOTE: Takes the pipeline of the slot from the pipeline state cache, creating it if nobody uses the state yet
+        bool AcquirePipeline(const VulkanPiplineConfig& _PipelineConfig, VulkanPipeline& _InOutPipeline);
+        void ReleasePipelines(std::vector<VulkanPipeline>& _InOutPipelines);
+        uint64_t ComputePipelineStateHash(const VulkanPiplineConfig& _PipelineConfig,
+                                          PrimitiveTopologyTypes _TopologyTypes) const;
+        bool CreateGraphicsPipeline(const VulkanPiplineConfig& _PipelineConfig, PrimitiveTopologyTypes _TopologyTypes,
+                                    VkPipeline& _OutPipeline);
 
-        std::optional<VulkanShaderStage> CreateShaderModule(const ShaderStageConfig& _ShaderStageConfig);
+        std::optional<VulkanShaderStage> CreateShaderModule(shaderc_compiler* _Compiler,
+                                                            const ShaderStageConfig& _ShaderStageConfig,
+                                                            std::vector<std::filesystem::path>& _OutSourceFiles,
+                                                            VulkanShaderReflection& _OutReflection);
 
         void BindPipeline(VkCommandBuffer _CommandBuffer, VkPipelineBindPoint _BindPoint,
                           const VulkanPipeline& _Pipeline);
 
+        void BindStorageBuffers(VkCommandBuffer _CommandBuffer, VkPipelineBindPoint _BindPoint,
+                                const VulkanPipeline& _Pipeline);
+
     protected:
         ShaderConfig m_ShaderConfig;
         std::vector<ShaderStageConfig> m_ShaderStageConfigs;
@@ -147,17 +314,30 @@ namespace Vega
         std::vector<VulkanDescriptorSetConfig> m_DescriptorSets;
         std::vector<VkDescriptorSetLayout> m_DescriptorSetLayouts;
 
-        uint32_t m_MaxDescriptorSetCount;
-
-        std::vector<VkDescriptorPoolSize> m_PoolSizes;
+        VkDescriptorPool m_DescriptorPool = VK_NULL_HANDLE;
 
-        std::vector<VkVertexInputAttributeDescription> m_AttributeDescriptions;
+        std::vector<VulkanStorageBufferBinding> m_StorageBufferBindings;
+        // NOTE: Indexed by the frame in flight
+        std::vector<VulkanStorageBufferFrameState> m_StorageBufferFrameStates;
+        VkDescriptorSet m_StorageBufferDescriptorSet = VK_NULL_HANDLE;
+        bool m_IsStorageBufferSetDirty = true;
 
-        VkDescriptorPool m_DescriptorPool;
+        bool m_IsUsingBindlessTextures = false;
 
         std::vector<VulkanPipeline> m_Pipelines;
         std::vector<VulkanPipeline> m_WireframesPipelines;
 
+        VkPipelineLayout m_PipelineLayout = VK_NULL_HANDLE;
+        // NOTE: Keeps the pipeline configs and their specialization data for the pipelines created on first use
+        Ref<VulkanShaderBuild> m_AppliedBuild;
+
+        Ref<VulkanShaderBuild> m_PendingBuild;
+        std::shared_future<bool> m_BuildResult;
+        bool m_IsReady = false;
+        bool m_IsReloadQueued = false;
+
+        std::vector<std::filesystem::path> m_SourceFiles;
+
         size_t m_BoundPipelineIndex;
         VkPrimitiveTopology m_CurentTopology;
 
@@ -166,6 +346,13 @@ namespace Vega
         VulkanShaderFrequencyInfo m_PerFrameInfo;
         VulkanShaderFrequencyInfo m_PerGroupInfo;
         VulkanShaderFrequencyInfo m_PerDrawInfo;
+
+        // NOTE: Indexed by ShaderUniformHandle
+        std::vector<VulkanUniformHandleInfo> m_UniformHandles;
+
+        // NOTE: 0 for the base shader, which owns the variants built so far
+        ShaderVariantMask m_VariantMask = 0;
+        std::unordered_map<ShaderVariantMask, Ref<VulkanShader>> m_Variants;
     };
 
 }    // namespace Vega
@@ -0,0 +1,99 @@
+#include "VulkanShaderBuildQueue.hpp"
+
+#include "Vega/Utils/Log.hpp"
+#include "Vega/Utils/Thread.hpp"
+
+#include <shaderc/shaderc.h>
+
+namespace Vega
+{
+
+    void VulkanShaderBuildQueue::Create(uint32_t _WorkerCount)
+    {
+        uint32_t workerCount = _WorkerCount;
+        if (workerCount == 0)
+        {
+            workerCount = GetDefaultWorkerThreadCount();
+        }
+
+        m_IsStopping = false;
+        m_Workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+        {
+            m_Workers.emplace_back(&VulkanShaderBuildQueue::WorkerLoop, this);
+        }
+
+        VEGA_CORE_TRACE("Shader build queue created with {} workers", workerCount);
+    }
+
+    void VulkanShaderBuildQueue::Destroy()
+    {
+        WaitIdle();
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_IsStopping = true;
+        }
+        m_WorkAvailable.notify_all();
+
+        for (std::thread& worker : m_Workers)
+        {
+            worker.join();
+        }
+        m_Workers.clear();
+    }
+
+    void VulkanShaderBuildQueue::Enqueue(Job _Job)
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_PendingJobs.push_back(std::move(_Job));
+        }
+        m_WorkAvailable.notify_one();
+    }
+
+    void VulkanShaderBuildQueue::WaitIdle()
+    {
+        std::unique_lock lock(m_Mutex);
+        m_WorkDone.wait(lock, [this]() { return m_PendingJobs.empty() && m_JobsInProgress == 0; });
+    }
+
+    bool VulkanShaderBuildQueue::IsIdle()
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_PendingJobs.empty() && m_JobsInProgress == 0;
+    }
+
+    void VulkanShaderBuildQueue::WorkerLoop()
+    {
+        shaderc_compiler_t compiler = shaderc_compiler_initialize();
+
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(m_Mutex);
+                m_WorkAvailable.wait(lock, [this]() { return m_IsStopping || !m_PendingJobs.empty(); });
+                if (m_IsStopping && m_PendingJobs.empty())
+                {
+                    break;
+                }
+
+                job = std::move(m_PendingJobs.front());
+                m_PendingJobs.pop_front();
+                ++m_JobsInProgress;
+            }
+
+            job(compiler);
+
+            {
+                std::lock_guard lock(m_Mutex);
+                --m_JobsInProgress;
+            }
+            m_WorkDone.notify_all();
+        }
+
+        shaderc_compiler_release(compiler);
+    }
+
+}    // namespace Vega
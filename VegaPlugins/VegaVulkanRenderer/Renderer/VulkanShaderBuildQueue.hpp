@@ -0,0 +1,55 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Vega
+{
+
+    /**
+     * @brief VulkanShaderBuildQueue class
+     *
+     * Worker threads for shader stage compilation and pipeline creation. Every worker owns its shaderc compiler, so
+     * jobs never share compiler state. Jobs may enqueue follow-up jobs (pipelines once all stages of a shader are
+     * compiled), they must only touch thread safe Vulkan entry points (object creation, the pipeline cache).
+     */
+    class VulkanShaderBuildQueue
+    {
+    public:
+        using Job = std::function<void(shaderc_compiler* _Compiler)>;
+
+        // NOTE: 0 - one worker per hardware thread except the main one
+        void Create(uint32_t _WorkerCount = 0);
+        // NOTE: Finishes every queued job before the workers are joined
+        void Destroy();
+
+        void Enqueue(Job _Job);
+
+        void WaitIdle();
+        bool IsIdle();
+
+        inline size_t GetWorkerCount() const { return m_Workers.size(); }
+
+    protected:
+        void WorkerLoop();
+
+    protected:
+        std::vector<std::thread> m_Workers;
+
+        std::mutex m_Mutex;
+        std::condition_variable m_WorkAvailable;
+        std::condition_variable m_WorkDone;
+
+        std::deque<Job> m_PendingJobs;
+        size_t m_JobsInProgress = 0;
+
+        bool m_IsStopping = false;
+    };
+
+}    // namespace Vega
@@ -0,0 +1,136 @@
+#include "VulkanShaderCache.hpp"
+
+#include "Vega/Utils/Log.hpp"
+
+#include <format>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+namespace Vega
+{
+
+    // NOTE: Bump when the entry layout or the way keys are built changes
+    static constexpr uint32_t kShaderCacheVersion = 2;
+    static constexpr uint32_t kShaderCacheMagic = 0x48435356;    // "VSCH"
+    static constexpr uint32_t kSpirvMagic = 0x07230203;
+
+    struct VulkanShaderCacheEntryHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint64_t Key;
+        uint64_t WordCount;
+    };
+
+    void VulkanShaderCache::Init(const std::filesystem::path& _Directory)
+    {
+        m_Directory = _Directory;
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(m_Directory, errorCode);
+        m_IsEnabled = !errorCode;
+        if (!m_IsEnabled)
+        {
+            VEGA_CORE_WARN("Shader cache is disabled, failed to create {}: {}", m_Directory.string(),
+                           errorCode.message());
+        }
+    }
+
+    uint64_t VulkanShaderCache::Hash(const void* _Data, size_t _Size, uint64_t _Hash)
+    {
+        constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(_Data);
+        for (size_t i = 0; i < _Size; ++i)
+        {
+            _Hash ^= bytes[i];
+            _Hash *= kFnvPrime;
+        }
+        return _Hash;
+    }
+
+    uint64_t VulkanShaderCache::Hash(std::string_view _String, uint64_t _Hash)
+    {
+        // NOTE: Hash the length too, so adjacent strings can not shift into each other
+        uint64_t size = _String.size();
+        _Hash = Hash(&size, sizeof(size), _Hash);
+        return Hash(_String.data(), _String.size(), _Hash);
+    }
+
+    bool VulkanShaderCache::Load(uint64_t _Key, std::vector<uint32_t>& _OutSpirv) const
+    {
+        if (!m_IsEnabled)
+        {
+            return false;
+        }
+
+        std::ifstream file(GetEntryPath(_Key), std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        VulkanShaderCacheEntryHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.Magic != kShaderCacheMagic ||
+            header.Version != kShaderCacheVersion || header.Key != _Key || header.WordCount == 0)
+        {
+            return false;
+        }
+
+        _OutSpirv.resize(header.WordCount);
+        if (!file.read(reinterpret_cast<char*>(_OutSpirv.data()), header.WordCount * sizeof(uint32_t)) ||
+            _OutSpirv[0] != kSpirvMagic)
+        {
+            VEGA_CORE_WARN("Shader cache entry {:016x} is corrupted, ignoring it", _Key);
+            _OutSpirv.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    void VulkanShaderCache::Store(uint64_t _Key, const uint32_t* _Spirv, size_t _WordCount) const
+    {
+        if (!m_IsEnabled)
+        {
+            return;
+        }
+
+        std::filesystem::path entryPath = GetEntryPath(_Key);
+        // NOTE: Per thread temporary file, the same entry may be stored by several threads at once
+        std::filesystem::path temporaryPath = entryPath;
+        temporaryPath += std::format(".{}.tmp", std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            VulkanShaderCacheEntryHeader header = {
+                .Magic = kShaderCacheMagic,
+                .Version = kShaderCacheVersion,
+                .Key = _Key,
+                .WordCount = _WordCount,
+            };
+            if (!file.is_open() || !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+                !file.write(reinterpret_cast<const char*>(_Spirv), _WordCount * sizeof(uint32_t)))
+            {
+                VEGA_CORE_WARN("Failed to write shader cache entry: {}", temporaryPath.string());
+                return;
+            }
+        }
+
+        std::error_code errorCode;
+        std::filesystem::rename(temporaryPath, entryPath, errorCode);
+        if (errorCode)
+        {
+            VEGA_CORE_WARN("Failed to write shader cache entry {}: {}", entryPath.string(), errorCode.message());
+            std::filesystem::remove(temporaryPath, errorCode);
+        }
+    }
+
+    std::filesystem::path VulkanShaderCache::GetEntryPath(uint64_t _Key) const
+    {
+        return m_Directory / std::format("{:016x}.spv", _Key);
+    }
+
+}    // namespace Vega
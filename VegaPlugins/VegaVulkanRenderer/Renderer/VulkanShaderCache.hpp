@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace Vega
+{
+
+    /**
+     * @brief VulkanShaderCache class
+     *
+     * On-disk cache of compiled SPIR-V. Entries are addressed by a 64-bit key that the shader builds from everything
+     * that affects compilation (source, included files, defines and compiler options), so an entry never has to be
+     * invalidated: any change produces a new key. Entries are written to a temporary file and renamed, so a
+     * partially written entry is never read.
+     */
+    class VulkanShaderCache
+    {
+    public:
+        static constexpr std::string_view kDefaultDirectory = "Assets/Shaders/Cache";
+        static constexpr uint64_t kHashSeed = 0xcbf29ce484222325ULL;
+
+        void Init(const std::filesystem::path& _Directory);
+
+        // NOTE: FNV-1a, chain calls by passing the previous result as _Hash
+        static uint64_t Hash(const void* _Data, size_t _Size, uint64_t _Hash = kHashSeed);
+        static uint64_t Hash(std::string_view _String, uint64_t _Hash = kHashSeed);
+
+        bool Load(uint64_t _Key, std::vector<uint32_t>& _OutSpirv) const;
+        void Store(uint64_t _Key, const uint32_t* _Spirv, size_t _WordCount) const;
+
+        inline bool IsEnabled() const { return m_IsEnabled; }
+
+    protected:
+        std::filesystem::path GetEntryPath(uint64_t _Key) const;
+
+    protected:
+        std::filesystem::path m_Directory;
+        bool m_IsEnabled = false;
+    };
+
+}    // namespace Vega
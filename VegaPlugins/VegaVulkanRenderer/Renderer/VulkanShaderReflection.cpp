@@ -0,0 +1,646 @@
+#include "VulkanShaderReflection.hpp"
+
+#include "Vega/Utils/Log.hpp"
+
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <string_view>
+
+namespace Vega
+{
+
+    static constexpr uint32_t kSpirvMagic = 0x07230203;
+    static constexpr size_t kSpirvHeaderWordCount = 5;
+
+    static constexpr uint32_t kSpirvOpName = 5;
+    static constexpr uint32_t kSpirvOpMemberName = 6;
+    static constexpr uint32_t kSpirvOpTypeBool = 20;
+    static constexpr uint32_t kSpirvOpTypeInt = 21;
+    static constexpr uint32_t kSpirvOpTypeFloat = 22;
+    static constexpr uint32_t kSpirvOpTypeVector = 23;
+    static constexpr uint32_t kSpirvOpTypeMatrix = 24;
+    static constexpr uint32_t kSpirvOpTypeImage = 25;
+    static constexpr uint32_t kSpirvOpTypeSampler = 26;
+    static constexpr uint32_t kSpirvOpTypeSampledImage = 27;
+    static constexpr uint32_t kSpirvOpTypeArray = 28;
+    static constexpr uint32_t kSpirvOpTypeRuntimeArray = 29;
+    static constexpr uint32_t kSpirvOpTypeStruct = 30;
+    static constexpr uint32_t kSpirvOpTypePointer = 32;
+    static constexpr uint32_t kSpirvOpConstant = 43;
+    static constexpr uint32_t kSpirvOpSpecConstantTrue = 48;
+    static constexpr uint32_t kSpirvOpSpecConstantFalse = 49;
+    static constexpr uint32_t kSpirvOpSpecConstant = 50;
+    static constexpr uint32_t kSpirvOpVariable = 59;
+    static constexpr uint32_t kSpirvOpDecorate = 71;
+    static constexpr uint32_t kSpirvOpMemberDecorate = 72;
+
+    static constexpr uint32_t kSpirvDecorationSpecId = 1;
+    static constexpr uint32_t kSpirvDecorationBufferBlock = 3;
+    static constexpr uint32_t kSpirvDecorationRowMajor = 4;
+    static constexpr uint32_t kSpirvDecorationArrayStride = 6;
+    static constexpr uint32_t kSpirvDecorationMatrixStride = 7;
+    static constexpr uint32_t kSpirvDecorationBuiltIn = 11;
+    static constexpr uint32_t kSpirvDecorationLocation = 30;
+    static constexpr uint32_t kSpirvDecorationBinding = 33;
+    static constexpr uint32_t kSpirvDecorationDescriptorSet = 34;
+    static constexpr uint32_t kSpirvDecorationOffset = 35;
+
+    static constexpr uint32_t kSpirvStorageClassUniformConstant = 0;
+    static constexpr uint32_t kSpirvStorageClassInput = 1;
+    static constexpr uint32_t kSpirvStorageClassUniform = 2;
+    static constexpr uint32_t kSpirvStorageClassPushConstant = 9;
+    static constexpr uint32_t kSpirvStorageClassStorageBuffer = 12;
+
+    static constexpr uint32_t kSpirvDimBuffer = 5;
+    static constexpr uint32_t kSpirvDimSubpassData = 6;
+    static constexpr uint32_t kSpirvImageSampledStorage = 2;
+
+    static constexpr uint32_t kSpirvNoValue = std::numeric_limits<uint32_t>::max();
+
+    struct SpirvMember
+    {
+        std::string Name;
+        uint32_t Offset = 0;
+        uint32_t MatrixStride = 0;
+        bool IsRowMajor = false;
+    };
+
+    struct SpirvId
+    {
+        uint32_t Opcode = 0;
+        // NOTE: Operands after the result id. OpVariable keeps its result type and storage class, constants keep
+        //       their result type and the first value word
+        std::vector<uint32_t> Operands;
+        std::string Name;
+        std::vector<SpirvMember> Members;
+
+        uint32_t Set = 0;
+        uint32_t Binding = 0;
+        uint32_t Location = kSpirvNoValue;
+        uint32_t ArrayStride = 0;
+        uint32_t SpecId = kSpirvNoValue;
+        bool IsBufferBlock = false;
+        bool IsBuiltIn = false;
+    };
+
+    static std::string ReadSpirvString(const uint32_t* _Words, size_t _WordCount);
+    static SpirvMember& GetSpirvMember(SpirvId& _Id, uint32_t _MemberIndex);
+
+    static uint32_t GetSpirvArrayLength(const std::vector<SpirvId>& _Ids, uint32_t _LengthId);
+    static uint32_t GetSpirvTypeSize(const std::vector<SpirvId>& _Ids, uint32_t _TypeId, const SpirvMember* _Member);
+    static void CollectSpirvFields(const std::vector<SpirvId>& _Ids, uint32_t _StructId, const std::string& _Prefix,
+                                   uint32_t _BaseOffset, std::vector<VulkanReflectedField>& _OutFields);
+    static bool GetSpirvDescriptorType(const std::vector<SpirvId>& _Ids, uint32_t _StorageClass, uint32_t _TypeId,
+                                       VkDescriptorType& _OutDescriptorType);
+    static VkFormat GetSpirvVertexInputFormat(const std::vector<SpirvId>& _Ids, uint32_t _TypeId);
+
+    bool VulkanShaderReflection::Reflect(const std::vector<uint32_t>& _Spirv, VkShaderStageFlagBits _Stage)
+    {
+        if (_Spirv.size() < kSpirvHeaderWordCount || _Spirv[0] != kSpirvMagic)
+        {
+            VEGA_CORE_ERROR("Failed to reflect shader stage: invalid SPIR-V header");
+            return false;
+        }
+
+        uint32_t idBound = _Spirv[3];
+        std::vector<SpirvId> ids(idBound);
+        std::vector<uint32_t> variableIds;
+
+        for (size_t wordIndex = kSpirvHeaderWordCount; wordIndex < _Spirv.size();)
+        {
+            uint32_t wordCount = _Spirv[wordIndex] >> 16;
+            uint32_t opcode = _Spirv[wordIndex] & 0xffff;
+            if (wordCount == 0 || wordIndex + wordCount > _Spirv.size())
+            {
+                VEGA_CORE_ERROR("Failed to reflect shader stage: truncated SPIR-V instruction at word {}", wordIndex);
+                return false;
+            }
+
+            const uint32_t* words = _Spirv.data() + wordIndex;
+            wordIndex += wordCount;
+
+            // NOTE: Constants and variables have the result type first, everything else starts with the result id
+            bool isResultTypeFirst = opcode == kSpirvOpConstant || opcode == kSpirvOpSpecConstantTrue ||
+                                     opcode == kSpirvOpSpecConstantFalse || opcode == kSpirvOpSpecConstant ||
+                                     opcode == kSpirvOpVariable;
+            uint32_t idWordIndex = isResultTypeFirst ? 2 : 1;
+            if (wordCount <= idWordIndex || words[idWordIndex] >= idBound)
+            {
+                continue;
+            }
+            SpirvId& id = ids[words[idWordIndex]];
+
+            switch (opcode)
+            {
+                case kSpirvOpName: id.Name = ReadSpirvString(words + 2, wordCount - 2); break;
+                case kSpirvOpMemberName:
+                    if (wordCount > 3)
+                    {
+                        GetSpirvMember(id, words[2]).Name = ReadSpirvString(words + 3, wordCount - 3);
+                    }
+                    break;
+                case kSpirvOpDecorate:
+                {
+                    uint32_t value = wordCount > 3 ? words[3] : 0;
+                    switch (wordCount > 2 ? words[2] : kSpirvNoValue)
+                    {
+                        case kSpirvDecorationSpecId: id.SpecId = value; break;
+                        case kSpirvDecorationBufferBlock: id.IsBufferBlock = true; break;
+                        case kSpirvDecorationArrayStride: id.ArrayStride = value; break;
+                        case kSpirvDecorationBuiltIn: id.IsBuiltIn = true; break;
+                        case kSpirvDecorationLocation: id.Location = value; break;
+                        case kSpirvDecorationBinding: id.Binding = value; break;
+                        case kSpirvDecorationDescriptorSet: id.Set = value; break;
+                    }
+                    break;
+                }
+                case kSpirvOpMemberDecorate:
+                {
+                    if (wordCount < 4)
+                    {
+                        break;
+                    }
+                    SpirvMember& member = GetSpirvMember(id, words[2]);
+                    uint32_t value = wordCount > 4 ? words[4] : 0;
+                    switch (words[3])
+                    {
+                        case kSpirvDecorationOffset: member.Offset = value; break;
+                        case kSpirvDecorationMatrixStride: member.MatrixStride = value; break;
+                        case kSpirvDecorationRowMajor: member.IsRowMajor = true; break;
+                    }
+                    break;
+                }
+                case kSpirvOpTypeBool:
+                case kSpirvOpTypeInt:
+                case kSpirvOpTypeFloat:
+                case kSpirvOpTypeVector:
+                case kSpirvOpTypeMatrix:
+                case kSpirvOpTypeImage:
+                case kSpirvOpTypeSampler:
+                case kSpirvOpTypeSampledImage:
+                case kSpirvOpTypeArray:
+                case kSpirvOpTypeRuntimeArray:
+                case kSpirvOpTypeStruct:
+                case kSpirvOpTypePointer:
+                    id.Opcode = opcode;
+                    id.Operands.assign(words + 2, words + wordCount);
+                    if (opcode == kSpirvOpTypeStruct && id.Members.size() < id.Operands.size())
+                    {
+                        id.Members.resize(id.Operands.size());
+                    }
+                    break;
+                case kSpirvOpConstant:
+                case kSpirvOpSpecConstant:
+                    id.Opcode = opcode;
+                    id.Operands = { words[1], wordCount > 3 ? words[3] : 0 };
+                    break;
+                case kSpirvOpSpecConstantTrue:
+                case kSpirvOpSpecConstantFalse:
+                    id.Opcode = opcode;
+                    id.Operands = { words[1], opcode == kSpirvOpSpecConstantTrue ? 1u : 0u };
+                    break;
+                case kSpirvOpVariable:
+                    if (wordCount > 3)
+                    {
+                        id.Opcode = opcode;
+                        id.Operands = { words[1], words[3] };
+                        variableIds.push_back(words[2]);
+                    }
+                    break;
+            }
+        }
+
+        for (uint32_t variableId : variableIds)
+        {
+            const SpirvId& variable = ids[variableId];
+            uint32_t storageClass = variable.Operands[1];
+
+            // NOTE: Pointer operands are the storage class and the pointee type
+            const SpirvId& pointerType = ids[variable.Operands[0]];
+            if (pointerType.Opcode != kSpirvOpTypePointer || pointerType.Operands.size() < 2)
+            {
+                continue;
+            }
+            uint32_t typeId = pointerType.Operands[1];
+
+            switch (storageClass)
+            {
+                case kSpirvStorageClassUniformConstant:
+                case kSpirvStorageClassUniform:
+                case kSpirvStorageClassStorageBuffer:
+                {
+                    // NOTE: Only the outermost dimension can be runtime sized, its count is reported as 0
+                    uint32_t descriptorCount = 1;
+                    if (ids[typeId].Opcode == kSpirvOpTypeRuntimeArray)
+                    {
+                        descriptorCount = 0;
+                        typeId = ids[typeId].Operands[0];
+                    }
+                    while (ids[typeId].Opcode == kSpirvOpTypeArray)
+                    {
+                        descriptorCount *= GetSpirvArrayLength(ids, ids[typeId].Operands[1]);
+                        typeId = ids[typeId].Operands[0];
+                    }
+
+                    VkDescriptorType descriptorType;
+                    if (!GetSpirvDescriptorType(ids, storageClass, typeId, descriptorType))
+                    {
+                        VEGA_CORE_ERROR("Failed to reflect {} at set {} binding {}: unsupported descriptor type",
+                                        variable.Name, variable.Set, variable.Binding);
+                        return false;
+                    }
+
+                    VulkanReflectedBinding binding = {
+                        .Name = variable.Name,
+                        .Set = variable.Set,
+                        .Binding = variable.Binding,
+                        .DescriptorType = descriptorType,
+                        .DescriptorCount = descriptorCount,
+                        .StageFlags = static_cast<VkShaderStageFlags>(_Stage),
+                    };
+
+                    if (binding.DescriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+                        binding.DescriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                    {
+                        binding.Name = ids[typeId].Name;
+                        binding.BlockSize = GetSpirvTypeSize(ids, typeId, nullptr);
+                        CollectSpirvFields(ids, typeId, binding.Name, 0, binding.Fields);
+                    }
+
+                    m_Bindings.push_back(std::move(binding));
+                    break;
+                }
+                case kSpirvStorageClassPushConstant:
+                {
+                    m_PushConstants.Name = ids[typeId].Name;
+                    m_PushConstants.Size = GetSpirvTypeSize(ids, typeId, nullptr);
+                    m_PushConstants.StageFlags = _Stage;
+                    m_PushConstants.Fields.clear();
+                    CollectSpirvFields(ids, typeId, m_PushConstants.Name, 0, m_PushConstants.Fields);
+                    break;
+                }
+                case kSpirvStorageClassInput:
+                {
+                    if (_Stage != VK_SHADER_STAGE_VERTEX_BIT || variable.IsBuiltIn ||
+                        variable.Location == kSpirvNoValue)
+                    {
+                        break;
+                    }
+
+                    uint32_t columnTypeId = typeId;
+                    uint32_t columnCount = 1;
+                    if (ids[typeId].Opcode == kSpirvOpTypeMatrix)
+                    {
+                        columnTypeId = ids[typeId].Operands[0];
+                        columnCount = ids[typeId].Operands[1];
+                    }
+
+                    VkFormat format = GetSpirvVertexInputFormat(ids, columnTypeId);
+                    if (format == VK_FORMAT_UNDEFINED)
+                    {
+                        VEGA_CORE_ERROR("Failed to reflect vertex input {}: unsupported type", variable.Name);
+                        return false;
+                    }
+
+                    for (uint32_t column = 0; column < columnCount; ++column)
+                    {
+                        m_VertexInputs.emplace_back(VulkanReflectedVertexInput {
+                            .Name = columnCount > 1 ? std::format("{}[{}]", variable.Name, column) : variable.Name,
+                            .Location = variable.Location + column,
+                            .Format = format,
+                            .Size = GetSpirvTypeSize(ids, columnTypeId, nullptr),
+                        });
+                    }
+                    break;
+                }
+            }
+        }
+
+        // NOTE: Only constants with a SpecId can be specialized, the others are spec constant operations
+        for (const SpirvId& id : ids)
+        {
+            bool isSpecConstant = id.Opcode == kSpirvOpSpecConstantTrue || id.Opcode == kSpirvOpSpecConstantFalse ||
+                                  id.Opcode == kSpirvOpSpecConstant;
+            if (!isSpecConstant || id.SpecId == kSpirvNoValue)
+            {
+                continue;
+            }
+
+            m_SpecializationConstants.emplace_back(VulkanReflectedSpecializationConstant {
+                .Name = id.Name,
+                .ConstantId = id.SpecId,
+                .Size = GetSpirvTypeSize(ids, id.Operands[0], nullptr),
+                .IsBool = id.Opcode != kSpirvOpSpecConstant,
+            });
+        }
+
+        std::sort(m_Bindings.begin(), m_Bindings.end(),
+                  [](const VulkanReflectedBinding& _Lhs, const VulkanReflectedBinding& _Rhs) {
+                      return _Lhs.Set != _Rhs.Set ? _Lhs.Set < _Rhs.Set : _Lhs.Binding < _Rhs.Binding;
+                  });
+        std::sort(m_SpecializationConstants.begin(), m_SpecializationConstants.end(),
+                  [](const VulkanReflectedSpecializationConstant& _Lhs,
+                     const VulkanReflectedSpecializationConstant& _Rhs) { return _Lhs.ConstantId < _Rhs.ConstantId; });
+        std::sort(m_VertexInputs.begin(), m_VertexInputs.end(),
+                  [](const VulkanReflectedVertexInput& _Lhs, const VulkanReflectedVertexInput& _Rhs) {
+                      return _Lhs.Location < _Rhs.Location;
+                  });
+
+        return true;
+    }
+
+    bool VulkanShaderReflection::Merge(const VulkanShaderReflection& _Other)
+    {
+        for (const VulkanReflectedBinding& otherBinding : _Other.m_Bindings)
+        {
+            auto bindingIt = std::find_if(m_Bindings.begin(), m_Bindings.end(),
+                                          [&otherBinding](const VulkanReflectedBinding& _Binding) {
+                                              return _Binding.Set == otherBinding.Set &&
+                                                     _Binding.Binding == otherBinding.Binding;
+                                          });
+            if (bindingIt == m_Bindings.end())
+            {
+                m_Bindings.push_back(otherBinding);
+                continue;
+            }
+
+            if (bindingIt->DescriptorType != otherBinding.DescriptorType ||
+                bindingIt->DescriptorCount != otherBinding.DescriptorCount)
+            {
+                VEGA_CORE_ERROR("Shader stages declare different descriptors at set {} binding {} ({} and {})",
+                                otherBinding.Set, otherBinding.Binding, bindingIt->Name, otherBinding.Name);
+                return false;
+            }
+
+            bindingIt->StageFlags |= otherBinding.StageFlags;
+
+            // NOTE: Stages may declare only the leading members of the same block
+            if (otherBinding.BlockSize > bindingIt->BlockSize)
+            {
+                bindingIt->BlockSize = otherBinding.BlockSize;
+                bindingIt->Fields = otherBinding.Fields;
+            }
+        }
+
+        std::sort(m_Bindings.begin(), m_Bindings.end(),
+                  [](const VulkanReflectedBinding& _Lhs, const VulkanReflectedBinding& _Rhs) {
+                      return _Lhs.Set != _Rhs.Set ? _Lhs.Set < _Rhs.Set : _Lhs.Binding < _Rhs.Binding;
+                  });
+
+        if (_Other.m_PushConstants.Size > 0)
+        {
+            if (m_PushConstants.Size == 0)
+            {
+                m_PushConstants.Name = _Other.m_PushConstants.Name;
+            }
+            m_PushConstants.Size = std::max(m_PushConstants.Size, _Other.m_PushConstants.Size);
+            m_PushConstants.StageFlags |= _Other.m_PushConstants.StageFlags;
+
+            for (const VulkanReflectedField& otherField : _Other.m_PushConstants.Fields)
+            {
+                auto fieldIt = std::find_if(
+                    m_PushConstants.Fields.begin(), m_PushConstants.Fields.end(),
+                    [&otherField](const VulkanReflectedField& _Field) { return _Field.Name == otherField.Name; });
+                if (fieldIt == m_PushConstants.Fields.end())
+                {
+                    m_PushConstants.Fields.push_back(otherField);
+                }
+            }
+        }
+
+        for (const VulkanReflectedSpecializationConstant& otherConstant : _Other.m_SpecializationConstants)
+        {
+            auto constantIt =
+                std::find_if(m_SpecializationConstants.begin(), m_SpecializationConstants.end(),
+                             [&otherConstant](const VulkanReflectedSpecializationConstant& _Constant) {
+                                 return _Constant.ConstantId == otherConstant.ConstantId;
+                             });
+            if (constantIt == m_SpecializationConstants.end())
+            {
+                m_SpecializationConstants.push_back(otherConstant);
+            }
+            else if (constantIt->Size != otherConstant.Size || constantIt->IsBool != otherConstant.IsBool)
+            {
+                VEGA_CORE_ERROR("Shader stages declare different specialization constants with id {} ({} and {})",
+                                otherConstant.ConstantId, constantIt->Name, otherConstant.Name);
+                return false;
+            }
+        }
+        std::sort(m_SpecializationConstants.begin(), m_SpecializationConstants.end(),
+                  [](const VulkanReflectedSpecializationConstant& _Lhs,
+                     const VulkanReflectedSpecializationConstant& _Rhs) { return _Lhs.ConstantId < _Rhs.ConstantId; });
+
+        m_VertexInputs.insert(m_VertexInputs.end(), _Other.m_VertexInputs.begin(), _Other.m_VertexInputs.end());
+
+        return true;
+    }
+
+    std::string ReadSpirvString(const uint32_t* _Words, size_t _WordCount)
+    {
+        std::string_view chars(reinterpret_cast<const char*>(_Words), _WordCount * sizeof(uint32_t));
+        return std::string(chars.substr(0, chars.find('\0')));
+    }
+
+    SpirvMember& GetSpirvMember(SpirvId& _Id, uint32_t _MemberIndex)
+    {
+        // NOTE: Member names and decorations come before the struct type itself
+        if (_MemberIndex >= _Id.Members.size())
+        {
+            _Id.Members.resize(_MemberIndex + 1);
+        }
+        return _Id.Members[_MemberIndex];
+    }
+
+    uint32_t GetSpirvArrayLength(const std::vector<SpirvId>& _Ids, uint32_t _LengthId)
+    {
+        // NOTE: Lengths given by specialization constants use their default value
+        const SpirvId& length = _Ids[_LengthId];
+        if (length.Opcode == kSpirvOpConstant || length.Opcode == kSpirvOpSpecConstant)
+        {
+            return length.Operands[1];
+        }
+        return 1;
+    }
+
+    uint32_t GetSpirvTypeSize(const std::vector<SpirvId>& _Ids, uint32_t _TypeId, const SpirvMember* _Member)
+    {
+        const SpirvId& type = _Ids[_TypeId];
+        switch (type.Opcode)
+        {
+            case kSpirvOpTypeBool: return 4;
+            case kSpirvOpTypeInt:
+            case kSpirvOpTypeFloat: return type.Operands[0] / 8;
+            case kSpirvOpTypeVector: return GetSpirvTypeSize(_Ids, type.Operands[0], nullptr) * type.Operands[1];
+            case kSpirvOpTypeMatrix:
+            {
+                uint32_t columnCount = type.Operands[1];
+                if (_Member && _Member->MatrixStride > 0)
+                {
+                    uint32_t rowCount = _Ids[type.Operands[0]].Operands[1];
+                    return _Member->MatrixStride * (_Member->IsRowMajor ? rowCount : columnCount);
+                }
+                return GetSpirvTypeSize(_Ids, type.Operands[0], nullptr) * columnCount;
+            }
+            case kSpirvOpTypeArray:
+            {
+                uint32_t length = GetSpirvArrayLength(_Ids, type.Operands[1]);
+                if (type.ArrayStride > 0)
+                {
+                    return type.ArrayStride * length;
+                }
+                return GetSpirvTypeSize(_Ids, type.Operands[0], _Member) * length;
+            }
+            case kSpirvOpTypeStruct:
+            {
+                uint32_t size = 0;
+                for (size_t i = 0; i < type.Operands.size(); ++i)
+                {
+                    const SpirvMember& member = type.Members[i];
+                    size = std::max(size, member.Offset + GetSpirvTypeSize(_Ids, type.Operands[i], &member));
+                }
+                return size;
+            }
+        }
+
+        // NOTE: Runtime arrays have no static size
+        return 0;
+    }
+
+    void CollectSpirvFields(const std::vector<SpirvId>& _Ids, uint32_t _StructId, const std::string& _Prefix,
+                            uint32_t _BaseOffset, std::vector<VulkanReflectedField>& _OutFields)
+    {
+        const SpirvId& structType = _Ids[_StructId];
+        for (size_t i = 0; i < structType.Operands.size(); ++i)
+        {
+            const SpirvMember& member = structType.Members[i];
+            uint32_t memberTypeId = structType.Operands[i];
+            std::string name = std::format("{}.{}", _Prefix, member.Name);
+
+            // NOTE: Nested structs are flattened, arrays of structs stay a single field
+            if (_Ids[memberTypeId].Opcode == kSpirvOpTypeStruct)
+            {
+                CollectSpirvFields(_Ids, memberTypeId, name, _BaseOffset + member.Offset, _OutFields);
+                continue;
+            }
+
+            _OutFields.emplace_back(VulkanReflectedField {
+                .Name = std::move(name),
+                .Offset = _BaseOffset + member.Offset,
+                .Size = GetSpirvTypeSize(_Ids, memberTypeId, &member),
+            });
+        }
+    }
+
+    bool GetSpirvDescriptorType(const std::vector<SpirvId>& _Ids, uint32_t _StorageClass, uint32_t _TypeId,
+                                VkDescriptorType& _OutDescriptorType)
+    {
+        const SpirvId& type = _Ids[_TypeId];
+        if (_StorageClass == kSpirvStorageClassStorageBuffer)
+        {
+            _OutDescriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            return true;
+        }
+        if (_StorageClass == kSpirvStorageClassUniform)
+        {
+            // NOTE: Storage buffers of SPIR-V before 1.3 are uniform blocks decorated with BufferBlock
+            _OutDescriptorType = type.IsBufferBlock ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                                                    : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            return true;
+        }
+
+        switch (type.Opcode)
+        {
+            case kSpirvOpTypeSampler: _OutDescriptorType = VK_DESCRIPTOR_TYPE_SAMPLER; return true;
+            case kSpirvOpTypeSampledImage:
+            {
+                bool isBuffer = _Ids[type.Operands[0]].Operands[1] == kSpirvDimBuffer;
+                _OutDescriptorType =
+                    isBuffer ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                return true;
+            }
+            case kSpirvOpTypeImage:
+            {
+                // NOTE: Image operands are the sampled type, dim, depth, arrayed, multisampled, sampled and format
+                uint32_t dim = type.Operands[1];
+                bool isStorage = type.Operands[5] == kSpirvImageSampledStorage;
+                if (dim == kSpirvDimSubpassData)
+                {
+                    _OutDescriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+                }
+                else if (dim == kSpirvDimBuffer)
+                {
+                    _OutDescriptorType =
+                        isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+                }
+                else
+                {
+                    _OutDescriptorType =
+                        isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+                }
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    VkFormat GetSpirvVertexInputFormat(const std::vector<SpirvId>& _Ids, uint32_t _TypeId)
+    {
+        static constexpr VkFormat kFloat16Formats[] = { VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT,
+                                                        VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT };
+        static constexpr VkFormat kFloat32Formats[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT,
+                                                        VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+        static constexpr VkFormat kFloat64Formats[] = { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT,
+                                                        VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+        static constexpr VkFormat kInt8Formats[] = { VK_FORMAT_R8_SINT, VK_FORMAT_R8G8_SINT, VK_FORMAT_R8G8B8_SINT,
+                                                     VK_FORMAT_R8G8B8A8_SINT };
+        static constexpr VkFormat kUint8Formats[] = { VK_FORMAT_R8_UINT, VK_FORMAT_R8G8_UINT, VK_FORMAT_R8G8B8_UINT,
+                                                      VK_FORMAT_R8G8B8A8_UINT };
+        static constexpr VkFormat kInt16Formats[] = { VK_FORMAT_R16_SINT, VK_FORMAT_R16G16_SINT,
+                                                      VK_FORMAT_R16G16B16_SINT, VK_FORMAT_R16G16B16A16_SINT };
+        static constexpr VkFormat kUint16Formats[] = { VK_FORMAT_R16_UINT, VK_FORMAT_R16G16_UINT,
+                                                       VK_FORMAT_R16G16B16_UINT, VK_FORMAT_R16G16B16A16_UINT };
+        static constexpr VkFormat kInt32Formats[] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT,
+                                                      VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+        static constexpr VkFormat kUint32Formats[] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT,
+                                                       VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+
+        const SpirvId* componentType = &_Ids[_TypeId];
+        uint32_t componentCount = 1;
+        if (componentType->Opcode == kSpirvOpTypeVector)
+        {
+            componentCount = componentType->Operands[1];
+            componentType = &_Ids[componentType->Operands[0]];
+        }
+        if (componentCount < 1 || componentCount > 4)
+        {
+            return VK_FORMAT_UNDEFINED;
+        }
+
+        const VkFormat* formats = nullptr;
+        if (componentType->Opcode == kSpirvOpTypeFloat)
+        {
+            switch (componentType->Operands[0])
+            {
+                case 16: formats = kFloat16Formats; break;
+                case 32: formats = kFloat32Formats; break;
+                case 64: formats = kFloat64Formats; break;
+            }
+        }
+        else if (componentType->Opcode == kSpirvOpTypeInt)
+        {
+            // NOTE: Int operands are the width and the signedness
+            bool isSigned = componentType->Operands[1] != 0;
+            switch (componentType->Operands[0])
+            {
+                case 8: formats = isSigned ? kInt8Formats : kUint8Formats; break;
+                case 16: formats = isSigned ? kInt16Formats : kUint16Formats; break;
+                case 32: formats = isSigned ? kInt32Formats : kUint32Formats; break;
+            }
+        }
+
+        return formats ? formats[componentCount - 1] : VK_FORMAT_UNDEFINED;
+    }
+
+}    // namespace Vega
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Vega
+{
+
+    struct VulkanReflectedField
+    {
+        // NOTE: Qualified by the block name, members of nested structs are flattened (Block.member.field)
+        std::string Name;
+        uint32_t Offset;
+        uint32_t Size;
+    };
+
+    struct VulkanReflectedBinding
+    {
+        // NOTE: Block type name for uniform and storage buffers, variable name for everything else
+        std::string Name;
+        uint32_t Set;
+        uint32_t Binding;
+        VkDescriptorType DescriptorType;
+        // NOTE: 0 for runtime sized arrays
+        uint32_t DescriptorCount;
+        VkShaderStageFlags StageFlags;
+
+        // NOTE: Uniform and storage buffers only
+        uint32_t BlockSize = 0;
+        std::vector<VulkanReflectedField> Fields;
+    };
+
+    struct VulkanReflectedPushConstants
+    {
+        std::string Name;
+        // NOTE: 0 if no stage declares a push constant block
+        uint32_t Size = 0;
+        VkShaderStageFlags StageFlags = 0;
+        std::vector<VulkanReflectedField> Fields;
+    };
+
+    struct VulkanReflectedSpecializationConstant
+    {
+        std::string Name;
+        uint32_t ConstantId;
+        // NOTE: Bool constants are VkBool32 sized
+        uint32_t Size;
+        bool IsBool;
+    };
+
+    struct VulkanReflectedVertexInput
+    {
+        std::string Name;
+        uint32_t Location;
+        VkFormat Format;
+        uint32_t Size;
+    };
+
+    /**
+     * @brief VulkanShaderReflection class
+     *
+     * Reads descriptor bindings, block layouts, push constants, specialization constants and vertex inputs straight
+     * from SPIR-V. Offsets and sizes are the ones the compiler decorated the blocks with, so CPU side uniform data
+     * always matches the GLSL declarations. Only the subset of SPIR-V produced for graphics shaders by shaderc is
+     * understood.
+     */
+    class VulkanShaderReflection
+    {
+    public:
+        // NOTE: Logs the reason and returns false if the module can not be reflected
+        bool Reflect(const std::vector<uint32_t>& _Spirv, VkShaderStageFlagBits _Stage);
+
+        /**
+         * @brief Adds the interface of another stage of the same shader.
+         *
+         * Bindings declared by several stages are merged into one with combined stage flags.
+         *
+         * @return bool False if the stages declare different descriptors at the same set and binding.
+         */
+        bool Merge(const VulkanShaderReflection& _Other);
+
+        // NOTE: Sorted by set and binding
+        inline const std::vector<VulkanReflectedBinding>& GetBindings() const { return m_Bindings; }
+        inline const VulkanReflectedPushConstants& GetPushConstants() const { return m_PushConstants; }
+        // NOTE: Sorted by constant id
+        inline const std::vector<VulkanReflectedSpecializationConstant>& GetSpecializationConstants() const
+        {
+            return m_SpecializationConstants;
+        }
+        // NOTE: Sorted by location, matrix inputs take one entry per column
+        inline const std::vector<VulkanReflectedVertexInput>& GetVertexInputs() const { return m_VertexInputs; }
+
+    protected:
+        std::vector<VulkanReflectedBinding> m_Bindings;
+        VulkanReflectedPushConstants m_PushConstants;
+        std::vector<VulkanReflectedSpecializationConstant> m_SpecializationConstants;
+        std::vector<VulkanReflectedVertexInput> m_VertexInputs;
+    };
+
+}    // namespace Vega
@@ -0,0 +1,258 @@
+#include "VulkanStagingRingBuffer.hpp"
+
+#include "Utils/VulkanUtils.hpp"
+#include "Vega/Utils/Log.hpp"
+#include "VulkanRendererBackend.hpp"
+
+#include <format>
+
+namespace Vega
+{
+
+    // NOTE: Keeps every staging offset valid for buffer to image copies of any texel size up to 16 bytes
+    static constexpr VkDeviceSize kStagingAlignment = 16;
+
+    void VulkanStagingRingBuffer::Create(std::string_view _Name, VkDeviceSize _Size)
+    {
+        m_Name = _Name;
+        m_Size = _Size;
+        m_Head = 0;
+        m_Tail = 0;
+        m_Buffer = CreateStagingBuffer(m_Name, m_Size, m_Allocation);
+    }
+
+    void VulkanStagingRingBuffer::Destroy()
+    {
+        for (TemporaryBuffer& temporaryBuffer : m_TemporaryBuffers)
+        {
+            DestroyStagingBuffer(temporaryBuffer.Buffer, temporaryBuffer.Allocation);
+        }
+        m_TemporaryBuffers.clear();
+
+        m_Regions.clear();
+        DestroyStagingBuffer(m_Buffer, m_Allocation);
+        m_Buffer = VK_NULL_HANDLE;
+    }
+
+    bool VulkanStagingRingBuffer::TryAllocate(VkDeviceSize _Size, const VulkanStagingFence& _Fence,
+                                              VulkanStagingAllocation& _OutAllocation)
+    {
+        std::lock_guard lock(m_Mutex);
+        ReclaimLocked();
+
+        VkDeviceSize alignedHead = (m_Head + kStagingAlignment - 1) / kStagingAlignment * kStagingAlignment;
+        bool isWrapped = !m_Regions.empty() && m_Head <= m_Tail;
+
+        VkDeviceSize offset;
+        if (isWrapped)
+        {
+            if (alignedHead + _Size > m_Tail)
+            {
+                return false;
+            }
+            offset = alignedHead;
+        }
+        else if (alignedHead + _Size <= m_Size)
+        {
+            offset = alignedHead;
+        }
+        else if (_Size <= m_Tail)
+        {
+            // NOTE: The skipped range at the end is freed together with the last region before the wrap
+            offset = 0;
+        }
+        else
+        {
+            return false;
+        }
+
+        m_Head = offset + _Size;
+
+        // NOTE: Allocations for the same submission share one region
+        if (!m_Regions.empty() && m_Regions.back().Fence.TimelineSemaphore == _Fence.TimelineSemaphore &&
+            m_Regions.back().Fence.Value == _Fence.Value)
+        {
+            m_Regions.back().End = m_Head;
+        }
+        else
+        {
+            m_Regions.push_back(Region { .End = m_Head, .Fence = _Fence });
+        }
+
+        _OutAllocation = VulkanStagingAllocation {
+            .Buffer = m_Buffer,
+            .Offset = offset,
+            .MappedData = static_cast<uint8_t*>(m_Allocation.MappedData) + offset,
+        };
+        return true;
+    }
+
+    VulkanStagingAllocation VulkanStagingRingBuffer::AllocateTemporary(VkDeviceSize _Size,
+                                                                      const VulkanStagingFence& _Fence)
+    {
+        std::lock_guard lock(m_Mutex);
+        ReclaimLocked();
+
+        TemporaryBuffer temporaryBuffer = { .Fence = _Fence };
+        temporaryBuffer.Buffer =
+            CreateStagingBuffer(std::format("{}_temporary_{}", m_Name, m_TemporaryBufferCounter++), _Size,
+                                temporaryBuffer.Allocation);
+        m_TemporaryBuffers.push_back(temporaryBuffer);
+
+        return VulkanStagingAllocation {
+            .Buffer = temporaryBuffer.Buffer,
+            .Offset = 0,
+            .MappedData = temporaryBuffer.Allocation.MappedData,
+        };
+    }
+
+    void VulkanStagingRingBuffer::Reclaim()
+    {
+        std::lock_guard lock(m_Mutex);
+        ReclaimLocked();
+    }
+
+    VulkanStagingFence VulkanStagingRingBuffer::CreatePendingFence()
+    {
+        return VulkanStagingFence { .TimelineSemaphore = VK_NULL_HANDLE, .Value = ++m_PendingFenceCounter };
+    }
+
+    void VulkanStagingRingBuffer::ResolvePendingFence(const VulkanStagingFence& _PendingFence,
+                                                      const VulkanStagingFence& _Fence)
+    {
+        VEGA_CORE_ASSERT(_PendingFence.TimelineSemaphore == VK_NULL_HANDLE,
+                         "VulkanStagingRingBuffer::ResolvePendingFence: Fence is not pending!");
+
+        std::lock_guard lock(m_Mutex);
+        for (Region& region : m_Regions)
+        {
+            if (region.Fence.TimelineSemaphore == VK_NULL_HANDLE && region.Fence.Value == _PendingFence.Value)
+            {
+                region.Fence = _Fence;
+                return;
+            }
+        }
+        for (TemporaryBuffer& temporaryBuffer : m_TemporaryBuffers)
+        {
+            if (temporaryBuffer.Fence.TimelineSemaphore == VK_NULL_HANDLE &&
+                temporaryBuffer.Fence.Value == _PendingFence.Value)
+            {
+                temporaryBuffer.Fence = _Fence;
+                return;
+            }
+        }
+        VEGA_CORE_ASSERT(false, "VulkanStagingRingBuffer::ResolvePendingFence: Pending fence not found!");
+    }
+
+    void VulkanStagingRingBuffer::ReclaimLocked()
+    {
+        while (!m_Regions.empty() && IsFenceSignaled(m_Regions.front().Fence))
+        {
+            m_Tail = m_Regions.front().End;
+            m_Regions.pop_front();
+        }
+
+        if (m_Regions.empty())
+        {
+            m_Head = 0;
+            m_Tail = 0;
+        }
+
+        for (auto it = m_TemporaryBuffers.begin(); it != m_TemporaryBuffers.end();)
+        {
+            if (IsFenceSignaled(it->Fence))
+            {
+                DestroyStagingBuffer(it->Buffer, it->Allocation);
+                it = m_TemporaryBuffers.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    bool VulkanStagingRingBuffer::GetOldestFence(VulkanStagingFence& _OutFence) const
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_Regions.empty())
+        {
+            return false;
+        }
+        _OutFence = m_Regions.front().Fence;
+        return true;
+    }
+
+    VkDeviceSize VulkanStagingRingBuffer::GetUsedSize() const
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_Regions.empty())
+        {
+            return 0;
+        }
+        return m_Head > m_Tail ? m_Head - m_Tail : m_Size - m_Tail + m_Head;
+    }
+
+    VkBuffer VulkanStagingRingBuffer::CreateStagingBuffer(std::string_view _Name, VkDeviceSize _Size,
+                                                          VulkanMemoryAllocation& _OutAllocation)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanContext& context = rendererBackend->GetVkContext();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+        VkDevice logicalDevice = deviceWrapper.GetLogicalDevice();
+
+        VkBufferCreateInfo bufferCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = _Size,
+            .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        };
+
+        VkBuffer buffer;
+        VK_CHECK(vkCreateBuffer(logicalDevice, &bufferCreateInfo, context.VkAllocator, &buffer));
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_BUFFER, buffer,
+                                 std::string(_Name).c_str());
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetBufferMemoryRequirements(logicalDevice, buffer, &memoryRequirements);
+        uint32_t memoryTypeIndex = deviceWrapper.GetMemoryTypeIndex(
+            memoryRequirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        if (!deviceWrapper.GetMemoryAllocator().Allocate(memoryRequirements, memoryTypeIndex,
+                                                         VulkanMemoryResourceType::kLinear, true, _Name,
+                                                         RendererMemoryCategory::kInternal, _OutAllocation))
+        {
+            VEGA_CORE_ASSERT(false, "Failed to allocate memory for staging buffer");
+            return buffer;
+        }
+
+        VK_CHECK(vkBindBufferMemory(logicalDevice, buffer, _OutAllocation.Memory, _OutAllocation.Offset));
+
+        return buffer;
+    }
+
+    void VulkanStagingRingBuffer::DestroyStagingBuffer(VkBuffer _Buffer, VulkanMemoryAllocation& _Allocation)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+
+        vkDestroyBuffer(deviceWrapper.GetLogicalDevice(), _Buffer, rendererBackend->GetVkContext().VkAllocator);
+        deviceWrapper.GetMemoryAllocator().Free(_Allocation);
+    }
+
+    bool VulkanStagingRingBuffer::IsFenceSignaled(const VulkanStagingFence& _Fence) const
+    {
+        if (_Fence.TimelineSemaphore == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+
+        VkDevice logicalDevice = VulkanRendererBackend::GetVkRendererBackend()->GetVkDeviceWrapper().GetLogicalDevice();
+
+        uint64_t completedValue = 0;
+        VK_CHECK(vkGetSemaphoreCounterValue(logicalDevice, _Fence.TimelineSemaphore, &completedValue));
+        return completedValue >= _Fence.Value;
+    }
+
+}    // namespace Vega
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+#include "VulkanMemoryAllocator.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Vega
+{
+
+    struct VulkanStagingFence
+    {
+        VkSemaphore TimelineSemaphore = VK_NULL_HANDLE;
+        uint64_t Value = 0;
+    };
+
+    struct VulkanStagingAllocation
+    {
+        VkBuffer Buffer = VK_NULL_HANDLE;
+        VkDeviceSize Offset = 0;
+        void* MappedData = nullptr;
+    };
+
+    /**
+     * @brief VulkanStagingRingBuffer class
+     *
+     * Single host visible staging buffer used as a ring. Every allocation is tagged with the timeline semaphore value
+     * of the submission that reads it, regions are reclaimed in allocation order once their value is reached, so
+     * allocations may live for any number of frames. Oversized uploads go to temporary buffers with the same
+     * lifetime tracking.
+     *
+     * Allocations can be made from any thread. Allocations tagged with a pending fence are kept until the fence is
+     * resolved with the value of the submission that reads them.
+     */
+    class VulkanStagingRingBuffer
+    {
+    public:
+        void Create(std::string_view _Name, VkDeviceSize _Size);
+        void Destroy();
+
+        /**
+         * @brief Allocates _Size bytes from the ring without blocking.
+         *
+         * @return bool False if the ring has no contiguous free range of _Size bytes after reclaiming.
+         */
+        bool TryAllocate(VkDeviceSize _Size, const VulkanStagingFence& _Fence, VulkanStagingAllocation& _OutAllocation);
+        VulkanStagingAllocation AllocateTemporary(VkDeviceSize _Size, const VulkanStagingFence& _Fence);
+
+        // NOTE: Frees ring regions and temporary buffers with signaled fences
+        void Reclaim();
+
+        // NOTE: Unique fence that is never signaled until ResolvePendingFence replaces it
+        VulkanStagingFence CreatePendingFence();
+        void ResolvePendingFence(const VulkanStagingFence& _PendingFence, const VulkanStagingFence& _Fence);
+
+        // NOTE: False if the ring is empty
+        bool GetOldestFence(VulkanStagingFence& _OutFence) const;
+
+        inline VkDeviceSize GetSize() const { return m_Size; }
+        VkDeviceSize GetUsedSize() const;
+
+    protected:
+        struct Region
+        {
+            VkDeviceSize End;
+            VulkanStagingFence Fence;
+        };
+
+        struct TemporaryBuffer
+        {
+            VkBuffer Buffer;
+            VulkanMemoryAllocation Allocation;
+            VulkanStagingFence Fence;
+        };
+
+        VkBuffer CreateStagingBuffer(std::string_view _Name, VkDeviceSize _Size,
+                                     VulkanMemoryAllocation& _OutAllocation);
+        void DestroyStagingBuffer(VkBuffer _Buffer, VulkanMemoryAllocation& _Allocation);
+
+        void ReclaimLocked();
+
+        bool IsFenceSignaled(const VulkanStagingFence& _Fence) const;
+
+    protected:
+        std::string m_Name;
+
+        VkBuffer m_Buffer = VK_NULL_HANDLE;
+        VulkanMemoryAllocation m_Allocation;
+        VkDeviceSize m_Size = 0;
+
+        // NOTE: Data lives in [m_Tail, m_Head) or, after a wrap, in [m_Tail, end) and [0, m_Head)
+        VkDeviceSize m_Head = 0;
+        VkDeviceSize m_Tail = 0;
+        std::deque<Region> m_Regions;
+
+        std::vector<TemporaryBuffer> m_TemporaryBuffers;
+        size_t m_TemporaryBufferCounter = 0;
+
+        mutable std::mutex m_Mutex;
+        std::atomic<uint64_t> m_PendingFenceCounter = 0;
+    };
+
+}    // namespace Vega
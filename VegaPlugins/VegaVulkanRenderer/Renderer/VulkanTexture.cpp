@@ -7,6 +7,7 @@
 #include "VulkanRenderBuffer.hpp"
 #include "VulkanRendererBackend.hpp"
 #include "backends/imgui_impl_vulkan.h"
+#include <cstring>
 #include <format>
 #include <vulkan/vulkan_core.h>
 
@@ -103,24 +104,26 @@ namespace Vega
         uint32_t memoryTypeIndex = rendererBackend->GetVkDeviceWrapper().GetMemoryTypeIndex(
             m_MemoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-        VkMemoryAllocateInfo memoryAllocateInfo = {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .allocationSize = m_MemoryRequirements.size,
-            .memoryTypeIndex = memoryTypeIndex,
-        };
-        VkResult allocateResult =
-            vkAllocateMemory(logicalDevice, &memoryAllocateInfo, context.VkAllocator, &m_ImageMemory);
-        if (!VulkanResultIsSuccess(allocateResult))
+        // NOTE: Attachments are recreated on resize and big images would fragment the blocks, so both get
+        //       their own memory
+        constexpr VkImageUsageFlags kAttachmentUsage =
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        constexpr VkDeviceSize kDedicatedImageSize = 16ULL * 1024 * 1024;
+        bool isDedicatedPreferred =
+            (m_ImageInfo.usage & kAttachmentUsage) || m_MemoryRequirements.size >= kDedicatedImageSize;
+        VulkanMemoryResourceType resourceType = m_ImageInfo.tiling == VK_IMAGE_TILING_OPTIMAL
+                                                    ? VulkanMemoryResourceType::kOptimal
+                                                    : VulkanMemoryResourceType::kLinear;
+
+        VulkanMemoryAllocator& memoryAllocator = rendererBackend->GetVkDeviceWrapper().GetMemoryAllocator();
+        if (!memoryAllocator.Allocate(m_MemoryRequirements, memoryTypeIndex, resourceType, isDedicatedPreferred, _Name,
+                                      m_MemoryCategory, m_ImageAllocation))
         {
-            VEGA_CORE_ERROR("Failed to allocate memory for image: {}", VulkanResultString(allocateResult, true));
             VEGA_CORE_ASSERT(false, "Failed to allocate memory for image");
             return;
         }
 
-        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_DEVICE_MEMORY,
-                                 m_ImageMemory, _Name.data());
-
-        VK_CHECK(vkBindImageMemory(logicalDevice, m_Image, m_ImageMemory, 0));
+        VK_CHECK(vkBindImageMemory(logicalDevice, m_Image, m_ImageAllocation.Memory, m_ImageAllocation.Offset));
 
         m_CurrentLayout = m_ImageInfo.initialLayout;
 
@@ -161,6 +164,20 @@ namespace Vega
             m_DescriptorSet =
                 ImGui_ImplVulkan_AddTexture(m_Sampler, m_ImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
         }
+
+        // NOTE: A resized texture keeps its bindless slot, only the view in it is replaced
+        if (m_ImageInfo.usage & VK_IMAGE_USAGE_SAMPLED_BIT)
+        {
+            VulkanBindlessTextureHeap& bindlessTextureHeap = rendererBackend->GetBindlessTextureHeap();
+            if (m_BindlessIndex == kInvalidBindlessIndex)
+            {
+                m_BindlessIndex = bindlessTextureHeap.Register(m_ImageView, m_Sampler);
+            }
+            else
+            {
+                bindlessTextureHeap.Update(m_BindlessIndex, m_ImageView, m_Sampler);
+            }
+        }
     }
 
     VulkanTextureTransitionMaskResult VulkanTexture::GetTransitionMask(VkImageLayout _OldLayout,
@@ -195,6 +212,36 @@ namespace Vega
                 .DstAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
             };
         }
+        if (_OldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL &&
+            _NewLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+        {
+            return {
+                .SrcStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                .SrcAccessMask = VK_ACCESS_2_SHADER_READ_BIT,
+                .DstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .DstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+            };
+        }
+        if (_OldLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL &&
+            _NewLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
+        {
+            return {
+                .SrcStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .SrcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .DstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .DstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+            };
+        }
+        if (_OldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL &&
+            _NewLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)
+        {
+            return {
+                .SrcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                .SrcAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT,
+                .DstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .DstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+            };
+        }
         if (_OldLayout == VK_IMAGE_LAYOUT_UNDEFINED && _NewLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
         {
             return {
@@ -335,25 +382,16 @@ namespace Vega
 
         size_t bufferSize = static_cast<VkDeviceSize>(_Props.Width * _Props.Height * _Props.ChannelCount);
 
-        // TODO: Move staging buffer creation to VulkanCommandBuffer class or to renderer backend
-        // TODO: Create a staging buffer pool to avoid creating and destroying buffers every time
-
-        VulkanRenderBuffer stagingBuffer(RenderBufferProps {
-            .Name = std::format("VulkanTexture_{}_staging_buffer", _Name),
-            .Type = RenderBufferType::kStaging,
-            .ElementSize = 1,
-            .ElementCount = bufferSize,
-        });
-
-        // TODO: May need to add IncludeInFrameWorkload parameter
-        stagingBuffer.LoadRange(bufferSize, _Data, false);
+        // NOTE: The upload is waited for below, the staging range is tagged with the next frame to be reclaimed
+        VulkanStagingAllocation stagingAllocation = rendererBackend->AllocateStagingMemory(bufferSize, true);
+        std::memcpy(stagingAllocation.MappedData, _Data, bufferSize);
 
         TransitionImageLayout(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, uploadCommandBuffer);
 
         // TODO: Move copy command to renderer backend
 
         VkBufferImageCopy region = {
-                .bufferOffset = 0,
+                .bufferOffset = stagingAllocation.Offset,
                 .bufferRowLength = 0,
                 .bufferImageHeight = 0,
                 .imageSubresource = {
@@ -366,7 +404,7 @@ namespace Vega
                 .imageExtent = { .width = _Props.Width, .height = _Props.Height, .depth = 1 }
             };
 
-        vkCmdCopyBufferToImage(uploadCommandBuffer, stagingBuffer.GetVkBuffer(), m_Image,
+        vkCmdCopyBufferToImage(uploadCommandBuffer, stagingAllocation.Buffer, m_Image,
                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
         TransitionImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
@@ -375,8 +413,6 @@ namespace Vega
         rendererBackend->DestroyAndEndSingleUseCommandBuffer(
             uploadCommandBuffer, rendererBackend->GetVkDeviceWrapper().GetGraphicsQueue(),
             rendererBackend->GetVkDeviceWrapper().GetGraphicsCommandPool());
-
-        stagingBuffer.Destroy();
     }
 
     void VulkanTexture::CreateSwapchainTexture(VkImage _Image, VkSurfaceFormatKHR _ImageFormat,
@@ -415,6 +451,12 @@ namespace Vega
         // TODO: find a better way to wait for all operations to be done on the texture
         VK_CHECK(vkDeviceWaitIdle(logicalDevice));
 
+        if (m_BindlessIndex != kInvalidBindlessIndex)
+        {
+            rendererBackend->GetBindlessTextureHeap().Unregister(m_BindlessIndex);
+            m_BindlessIndex = kInvalidBindlessIndex;
+        }
+
         if (m_ImageView)
         {
             vkDestroyImageView(logicalDevice, m_ImageView, vkAllocator);
@@ -430,8 +472,7 @@ namespace Vega
             m_ImageArrayViewsInfos.clear();
         }
 
-        vkFreeMemory(logicalDevice, m_ImageMemory, vkAllocator);
-        m_ImageMemory = nullptr;
+        rendererBackend->GetVkDeviceWrapper().GetMemoryAllocator().Free(m_ImageAllocation);
 
         vkDestroyImage(logicalDevice, m_Image, vkAllocator);
         m_Image = nullptr;
@@ -461,7 +502,7 @@ namespace Vega
         const VkAllocationCallbacks* vkAllocator = rendererBackend->GetVkContext().VkAllocator;
 
         vkDestroyImage(logicalDevice, m_Image, vkAllocator);
-        vkFreeMemory(logicalDevice, m_ImageMemory, vkAllocator);
+        rendererBackend->GetVkDeviceWrapper().GetMemoryAllocator().Free(m_ImageAllocation);
 
         if (m_ImageView)
         {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vega/Renderer/Texture.hpp"
+#include "VulkanMemoryAllocator.hpp"
 
 #include <vulkan/vulkan.h>
 
@@ -31,6 +32,9 @@ namespace Vega
 
         void TransitionImageLayout(VkImageLayout _NewLayout, VkCommandBuffer _CommandBuffer);
 
+        // NOTE: Must be set before Create, textures owned by frame buffers are reported separately
+        void SetMemoryCategory(RendererMemoryCategory _Category) { m_MemoryCategory = _Category; }
+
         VkImageLayout GetCurrentLayout() const { return m_CurrentLayout; }
         void SetCurrentLayout(VkImageLayout _Layout) { m_CurrentLayout = _Layout; }
 
@@ -48,8 +52,11 @@ namespace Vega
         uint32_t GetHeight() const override { return m_Props.Height; }
         uint32_t GetMipLevels() const override { return m_Props.MipLevels; }
         uint32_t GetArraySize() const override { return m_Props.ArraySize; }
+        uint32_t GetChannelCount() const { return m_Props.ChannelCount; }
+        uint32_t GetBindlessIndex() const override { return m_BindlessIndex; }
 
         VkImage GetTextureVkImage() const { return m_Image; }
+        VkFormat GetVkFormat() const { return m_ImageViewInfo.format; }
         VkImageView GetTextureVkImageView() const { return m_ImageView; }
 
         const VkImageViewCreateInfo& GetImageViewCreateInfo() const { return m_ImageViewInfo; }
@@ -65,7 +72,8 @@ namespace Vega
         VkImageView m_ImageView = nullptr;
 
         VkMemoryRequirements m_MemoryRequirements;
-        VkDeviceMemory m_ImageMemory;
+        VulkanMemoryAllocation m_ImageAllocation;
+        RendererMemoryCategory m_MemoryCategory = RendererMemoryCategory::kTexture;
 
         std::vector<VkImageViewCreateInfo> m_ImageArrayViewsInfos;
         std::vector<VkImageSubresourceRange> m_ImageArrayViewsSubresourceRanges;
@@ -73,6 +81,7 @@ namespace Vega
 
         VkSampler m_Sampler = VK_NULL_HANDLE;
         VkDescriptorSet m_DescriptorSet = VK_NULL_HANDLE;
+        uint32_t m_BindlessIndex = kInvalidBindlessIndex;
 
         VkImageLayout m_CurrentLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     };
@@ -0,0 +1,91 @@
+#include "VulkanUniformRingBuffer.hpp"
+
+#include "Utils/VulkanUtils.hpp"
+#include "Vega/Utils/Log.hpp"
+#include "VulkanRendererBackend.hpp"
+
+#include <limits>
+
+namespace Vega
+{
+
+    void VulkanUniformRingBuffer::Create(std::string_view _Name, VkDeviceSize _FrameSize, uint32_t _FrameCount)
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanContext& context = rendererBackend->GetVkContext();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+        VkDevice logicalDevice = deviceWrapper.GetLogicalDevice();
+
+        m_Name = _Name;
+        m_Alignment = deviceWrapper.GetMinUniformBufferOffsetAligment();
+        m_FrameSize = (_FrameSize + m_Alignment - 1) / m_Alignment * m_Alignment;
+        m_FrameCount = _FrameCount;
+        m_FrameBegin = 0;
+        m_Head = 0;
+
+        VEGA_CORE_ASSERT(m_FrameSize * m_FrameCount <= std::numeric_limits<uint32_t>::max(),
+                         "Uniform ring buffer offsets must fit into dynamic offsets!");
+
+        VkBufferCreateInfo bufferCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = m_FrameSize * m_FrameCount,
+            .usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        };
+
+        VK_CHECK(vkCreateBuffer(logicalDevice, &bufferCreateInfo, context.VkAllocator, &m_Buffer));
+        VK_SET_DEBUG_OBJECT_NAME(context.PfnSetDebugUtilsObjectNameEXT, logicalDevice, VK_OBJECT_TYPE_BUFFER, m_Buffer,
+                                 m_Name.c_str());
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetBufferMemoryRequirements(logicalDevice, m_Buffer, &memoryRequirements);
+        uint32_t memoryTypeIndex = deviceWrapper.GetMemoryTypeIndex(
+            memoryRequirements.memoryTypeBits,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        if (!deviceWrapper.GetMemoryAllocator().Allocate(memoryRequirements, memoryTypeIndex,
+                                                         VulkanMemoryResourceType::kLinear, true, m_Name,
+                                                         RendererMemoryCategory::kInternal, m_Allocation))
+        {
+            VEGA_CORE_ASSERT(false, "Failed to allocate memory for uniform ring buffer");
+            return;
+        }
+
+        VK_CHECK(vkBindBufferMemory(logicalDevice, m_Buffer, m_Allocation.Memory, m_Allocation.Offset));
+    }
+
+    void VulkanUniformRingBuffer::Destroy()
+    {
+        VulkanRendererBackend* rendererBackend = VulkanRendererBackend::GetVkRendererBackend();
+        const VulkanDeviceWrapper& deviceWrapper = rendererBackend->GetVkDeviceWrapper();
+
+        vkDestroyBuffer(deviceWrapper.GetLogicalDevice(), m_Buffer, rendererBackend->GetVkContext().VkAllocator);
+        deviceWrapper.GetMemoryAllocator().Free(m_Allocation);
+        m_Buffer = VK_NULL_HANDLE;
+    }
+
+    void VulkanUniformRingBuffer::BeginFrame(uint32_t _FrameIndex)
+    {
+        m_FrameBegin = (_FrameIndex % m_FrameCount) * m_FrameSize;
+        m_Head = m_FrameBegin;
+    }
+
+    bool VulkanUniformRingBuffer::Allocate(VkDeviceSize _Size, VulkanUniformAllocation& _OutAllocation)
+    {
+        VkDeviceSize offset = (m_Head + m_Alignment - 1) / m_Alignment * m_Alignment;
+        if (offset + _Size > m_FrameBegin + m_FrameSize)
+        {
+            VEGA_CORE_ERROR("Uniform ring buffer {} is out of memory for the frame ({} bytes per frame)", m_Name,
+                            m_FrameSize);
+            return false;
+        }
+
+        m_Head = offset + _Size;
+        _OutAllocation = VulkanUniformAllocation {
+            .Offset = static_cast<uint32_t>(offset),
+            .MappedData = static_cast<uint8_t*>(m_Allocation.MappedData) + offset,
+        };
+        return true;
+    }
+
+}    // namespace Vega
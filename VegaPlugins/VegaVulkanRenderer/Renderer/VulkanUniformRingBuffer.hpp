@@ -0,0 +1,60 @@
+#pragma once
+
+#include "VulkanBase.hpp"
+#include "VulkanMemoryAllocator.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace Vega
+{
+
+    struct VulkanUniformAllocation
+    {
+        // NOTE: Used as the dynamic offset of uniform buffer descriptors
+        uint32_t Offset = 0;
+        void* MappedData = nullptr;
+    };
+
+    /**
+     * @brief VulkanUniformRingBuffer class
+     *
+     * Host visible uniform buffer split into one segment per frame in flight. Uniform blocks are linearly allocated
+     * from the segment of the recorded frame and bound with dynamic offsets, so the buffer (and every descriptor
+     * pointing to it) never changes. A segment is reused once the fence of its frame is signaled.
+     */
+    class VulkanUniformRingBuffer
+    {
+    public:
+        void Create(std::string_view _Name, VkDeviceSize _FrameSize, uint32_t _FrameCount);
+        void Destroy();
+
+        // NOTE: Must be called after the in flight fence of _FrameIndex is waited
+        void BeginFrame(uint32_t _FrameIndex);
+
+        /**
+         * @brief Allocates _Size bytes aligned to minUniformBufferOffsetAlignment from the current frame segment.
+         *
+         * @return bool False if the frame segment is full.
+         */
+        bool Allocate(VkDeviceSize _Size, VulkanUniformAllocation& _OutAllocation);
+
+        inline VkBuffer GetVkBuffer() const { return m_Buffer; }
+        inline VkDeviceSize GetFrameSize() const { return m_FrameSize; }
+
+    protected:
+        std::string m_Name;
+
+        VkBuffer m_Buffer = VK_NULL_HANDLE;
+        VulkanMemoryAllocation m_Allocation;
+
+        VkDeviceSize m_FrameSize = 0;
+        uint32_t m_FrameCount = 0;
+        VkDeviceSize m_Alignment = 0;
+
+        // NOTE: Current frame segment is [m_FrameBegin, m_FrameBegin + m_FrameSize)
+        VkDeviceSize m_FrameBegin = 0;
+        VkDeviceSize m_Head = 0;
+    };
+
+}    // namespace Vega
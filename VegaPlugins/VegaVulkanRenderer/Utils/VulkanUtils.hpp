@@ -11,6 +11,12 @@ namespace Vega
 
     std::string VulkanResultString(VkResult _Result, bool _GetExtended);
 
+    // NOTE: Aspect read by image to buffer copies, depth/stencil formats are read as depth
+    VkImageAspectFlagBits VulkanFormatReadbackAspect(VkFormat _Format);
+
+    // NOTE: Bytes per texel of the aspect in buffer copies, 0 if the format is not supported
+    uint32_t VulkanFormatTexelSize(VkFormat _Format, VkImageAspectFlagBits _Aspect);
+
 #ifdef _DEBUG
 
     void VulkanSetDebugObjectName(PFN_vkSetDebugUtilsObjectNameEXT _PfnSetDebugUtilsObjectNameEXT,